@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cputex/definitions.h>
+#include <cputex/shared_texture.h>
+#include <cputex/unique_texture.h>
+
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace cputex {
+    enum class ArchiveError {
+        None,
+        FileOpenFailed,
+        FileMapFailed,
+        FileWriteFailed,
+        InvalidHeader,
+        UnsupportedVersion,
+        FileTooSmall,
+        NotFound,
+        DuplicateName,
+        EmptyTexture,
+        TextureCreationFailed,
+    };
+
+    // cputexture's own texture file. A file holds a header with the texture's params, the mip extent and surface info
+    // tables laid out like TextureStorage's, and the surface data exactly as it is in memory, rows, slices and surfaces
+    // padded the same way. Loading maps the file and adopts the surface data where it lies, so nothing is parsed or
+    // copied beyond checking the tables. The file stores gpufmt::Format values as they are, so files are only
+    // portable between builds using the same gpuformat version.
+    //
+    // The surface data of a single texture file starts on a page boundary. Archive entries only align it to a cache
+    // line, which is enough for any surface alignment up to 64 and keeps thousands of small textures compact.
+    inline constexpr cputex::SizeType kTextureFilePageSize = 4096;
+    inline constexpr cputex::SizeType kTextureArchiveDataAlignment = 64;
+
+    [[nodiscard]]
+    ArchiveError writeTextureFile(TextureView texture, const std::filesystem::path &path);
+
+    // Copies the surface data of an in memory texture file into a new texture.
+    [[nodiscard]]
+    UniqueTexture readTextureFile(cputex::span<const cputex::byte> fileData, ArchiveError &error);
+
+    // Maps the file copy-on-write, like DdsLoadMode::MemoryMap. The mapping is released with the last texture.
+    [[nodiscard]]
+    UniqueTexture readTextureFile(const std::filesystem::path &path, ArchiveError &error);
+
+    [[nodiscard]]
+    SharedTexture readSharedTextureFile(const std::filesystem::path &path, ArchiveError &error);
+
+    struct TextureArchiveEntry {
+        std::string_view name;
+        TextureView texture;
+    };
+
+    // Writes the textures one after another behind an index sorted by name. Names must be unique.
+    [[nodiscard]]
+    ArchiveError writeTextureArchive(cputex::span<const TextureArchiveEntry> entries, const std::filesystem::path &path);
+
+    // A mapped archive. Opening it maps the whole file once; textures are looked up with a binary search over the
+    // index in the mapping and adopt their surface data from it, so each find is a small allocation for the texture
+    // header and nothing else. The mapping stays alive while the archive or any texture found in it does.
+    class TextureArchive {
+    public:
+        TextureArchive() noexcept = default;
+
+        [[nodiscard]]
+        static TextureArchive open(const std::filesystem::path &path, ArchiveError &error);
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        [[nodiscard]]
+        cputex::SizeType size() const noexcept;
+
+        // Entries are sorted by name.
+        [[nodiscard]]
+        std::string_view name(cputex::SizeType index) const noexcept;
+
+        [[nodiscard]]
+        bool contains(std::string_view name) const noexcept;
+
+        // Returns an empty texture if there's no texture with the name. Textures found for the same entry share its
+        // mapped data until written to, when the writer copies the surfaces it writes.
+        [[nodiscard]]
+        SharedTexture find(std::string_view name) const;
+
+        [[nodiscard]]
+        SharedTexture find(std::string_view name, ArchiveError &error) const;
+
+    private:
+        struct Mapping;
+
+        [[nodiscard]]
+        cputex::SizeType lowerBound(std::string_view name) const noexcept;
+
+        std::shared_ptr<const Mapping> mMapping;
+    };
+}
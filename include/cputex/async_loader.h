@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cputex/definitions.h>
+#include <cputex/execution.h>
+#include <cputex/shared_texture.h>
+
+#include <gpufmt/format.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cputex {
+    enum class LoadError {
+        None,
+        FileOpenFailed,
+        FileReadFailed,
+        UnsupportedContainer,
+        InvalidFile,
+        DecompressionFailed,
+        ConversionFailed,
+        OutOfMemory,
+        Cancelled,
+    };
+
+    struct LoadResult {
+        SharedTexture texture;
+        LoadError error = LoadError::None;
+    };
+
+    // A DDS, KTX2 or cputexture texture file to load, told apart by their magic numbers. The file is either read from
+    // path, or taken from data when data isn't empty. data isn't copied, so it has to stay alive until the request
+    // completes.
+    struct LoadRequest {
+        std::filesystem::path path;
+
+        // The part of the file at path holding the texture, e.g. one entry of a pack file. A negative byteLength reads
+        // to the end of the file.
+        cputex::SizeType byteOffset = 0;
+        cputex::SizeType byteLength = -1;
+
+        cputex::span<const cputex::byte> data;
+
+        // Higher priorities are read and decoded first. Requests of the same priority go in the order they were made.
+        int priority = 0;
+
+        // Decompresses block compressed textures to the format gpuformat decompresses them to.
+        bool decompress = false;
+
+        // Converts the texture after any decompression. UNDEFINED keeps the format.
+        gpufmt::Format convertTo = gpufmt::Format::UNDEFINED;
+    };
+
+    using LoadCallback = std::function<void(LoadResult result)>;
+
+    struct AsyncLoaderOptions {
+        // Threads reading files. Reads are independent positional reads, so a few threads keep a fast drive's queue full.
+        cputex::SizeType ioThreadCount = 4;
+
+        // Threads parsing, decompressing and converting. Zero picks one less than the number of hardware threads.
+        cputex::SizeType decodeThreadCount = 0;
+
+        // The most file data read but not yet decoded at any time. Reads wait for decodes to catch up rather than go
+        // past it, except a file bigger than the whole budget is still read once nothing else is in flight.
+        cputex::SizeType maxInFlightBytes = 256 * 1024 * 1024;
+
+        // When set, each decode spreads its own work, e.g. KTX2 levels or conversion bands, over this executor.
+        // Otherwise every decode runs on its decode thread, which suits batches of many textures.
+        cputex::execution::Executor *executor = nullptr;
+    };
+
+    // Loads textures on background threads. Files are read by a set of I/O threads and handed to a set of decode threads
+    // that parse the container, then decompress and convert the texture when asked to, so reading the next files
+    // overlaps decoding the last ones. Both stages take requests highest priority first, so raising the priority of
+    // what's on screen lets it jump the queue of a large batch.
+    //
+    // Destroying the loader waits for the requests already being read or decoded, and completes every other request
+    // with LoadError::Cancelled.
+    class AsyncLoader {
+    public:
+        AsyncLoader();
+        explicit AsyncLoader(const AsyncLoaderOptions &options);
+        AsyncLoader(const AsyncLoader &) = delete;
+        AsyncLoader(AsyncLoader &&) = delete;
+        ~AsyncLoader();
+
+        AsyncLoader &operator=(const AsyncLoader &) = delete;
+        AsyncLoader &operator=(AsyncLoader &&) = delete;
+
+        [[nodiscard]]
+        std::future<LoadResult> load(LoadRequest request);
+
+        // The callback is called on one of the loader's threads, and must not destroy the loader.
+        void load(LoadRequest request, LoadCallback callback);
+
+        [[nodiscard]]
+        std::vector<std::future<LoadResult>> load(cputex::span<const LoadRequest> requests);
+
+        void load(cputex::span<const LoadRequest> requests, const LoadCallback &callback);
+
+        // Blocks until every request made so far has completed.
+        void waitIdle();
+
+    private:
+        struct Job;
+        struct JobQueue;
+
+        void enqueue(std::unique_ptr<Job> job);
+        void ioThreadMain() noexcept;
+        void decodeThreadMain() noexcept;
+        void complete(std::unique_ptr<Job> job, LoadResult result) noexcept;
+
+        std::unique_ptr<JobQueue> mReadQueue;
+        std::unique_ptr<JobQueue> mDecodeQueue;
+        std::vector<std::thread> mIoThreads;
+        std::vector<std::thread> mDecodeThreads;
+        std::mutex mMutex;
+        std::condition_variable mReadAvailable;
+        std::condition_variable mDecodeAvailable;
+        std::condition_variable mBudgetAvailable;
+        std::condition_variable mIdle;
+        cputex::execution::Executor *mExecutor = nullptr;
+        cputex::SizeType mMaxInFlightBytes = 0;
+        cputex::SizeType mInFlightBytes = 0;
+        cputex::SizeType mPendingCount = 0;
+        uint64_t mNextSequence = 0;
+        bool mStopping = false;
+    };
+}
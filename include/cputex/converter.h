@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cputex/execution.h>
+#include <cputex/internal/row_conversion.h>
+#include <cputex/internal/swizzle.h>
 #include <cputex/texture_view.h>
 #include <cputex/unique_texture.h>
 
@@ -43,9 +46,45 @@ namespace cputex {
         
         cputex::ConvertError convertTo(cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
         cputex::ConvertError convertTo(cputex::TextureView source, cputex::TextureSpan dest) const noexcept;
+        cputex::ConvertError convertTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
+        cputex::ConvertError convertTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView source, cputex::TextureSpan dest) const noexcept;
+
+        cputex::ConvertError convertTo(cputex::execution::SequencedPolicy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+            return convertTo(source, dest);
+        }
+
+        cputex::ConvertError convertTo(cputex::execution::SequencedPolicy, cputex::TextureView source, cputex::TextureSpan dest) const noexcept {
+            return convertTo(source, dest);
+        }
 
     private:
+        [[nodiscard]]
+        bool hasRowPath() const noexcept;
+
+        // A null policy runs the conversion on the calling thread.
+        cputex::ConvertError convertSurfaceTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
+
+        void convertRow(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount, cputex::SizeType sourceTexelByteSize, cputex::SizeType destTexelByteSize) const noexcept;
+        cputex::ConvertError convertRowsTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
+        cputex::ConvertError decompressRowsTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
+        cputex::ConvertError convertBlocksTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept;
+
         gpufmt::BlockSampler mBlockSampler;
         gpufmt::Writer mWriter;
+
+        // Resolved once at construction. Both are non-null only when the source and destination formats can be
+        // converted a row at a time through a glm::vec4 intermediate, bypassing the per-texel SampleVariant path.
+        internal::DecodeRowFunc mDecodeRow = nullptr;
+        internal::EncodeRowFunc mEncodeRow = nullptr;
+
+        // Compile-time specialized kernel for a hot format pair. Takes precedence over mDecodeRow and mEncodeRow.
+        internal::ConvertRowFunc mConvertRow = nullptr;
+
+        // Set when the formats only differ by 8 bit channel order or count. Takes precedence over every other path.
+        internal::ByteSwizzle mByteSwizzle;
+        internal::ByteSwizzleFunc mByteSwizzleRow = nullptr;
+
+        // Set when the source is compressed and the row paths above convert from the format it decompresses to.
+        gpufmt::Format mDecompressedFormat = gpufmt::Format::UNDEFINED;
     };
 }
\ No newline at end of file
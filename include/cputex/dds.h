@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cputex/definitions.h>
+#include <cputex/shared_texture.h>
+#include <cputex/unique_texture.h>
+
+#include <filesystem>
+#include <functional>
+
+namespace cputex {
+    enum class DdsError {
+        None,
+        FileOpenFailed,
+        FileReadFailed,
+        FileMapFailed,
+        FileWriteFailed,
+        InvalidHeader,
+        UnsupportedFormat,
+        UnsupportedDimension,
+        FileTooSmall,
+        TextureCreationFailed,
+        EmptyTexture,
+    };
+
+    enum class DdsLoadMode {
+        // Reads the surface data into memory owned by the texture.
+        Copy,
+
+        // Maps the file copy-on-write and adopts the mapped surface data, so the texture and every view of it point
+        // straight into the page cache. The mapping is released with the last texture referring to it. Writes
+        // through a TextureSpan are private to the process and never reach the file.
+        MemoryMap,
+    };
+
+    struct DdsHeader {
+        // Describes the file's surface data exactly: DDS packs rows, slices and surfaces tightly in array slice, face,
+        // mip order, which is cputex's own surface order with every alignment set to 1.
+        TextureParams params;
+
+        // Where the surface data starts in the file, past the magic, header and DX10 extension.
+        cputex::SizeType dataOffset = 0;
+        cputex::SizeType dataByteSize = 0;
+    };
+
+    // Parses the magic, legacy header and, when present, the DX10 extension at the start of a DDS file. Legacy pixel
+    // formats are mapped to their DXGI equivalent and, like DX10 formats, translated through gpufmt's DXGI table.
+    // fileData only needs to hold the headers, not the surface data.
+    [[nodiscard]]
+    DdsHeader parseDdsHeader(cputex::span<const cputex::byte> fileData, DdsError &error) noexcept;
+
+    // Copies the surface data of an in memory DDS file into a new texture.
+    [[nodiscard]]
+    UniqueTexture readDds(cputex::span<const cputex::byte> fileData, DdsError &error);
+
+    [[nodiscard]]
+    UniqueTexture readDds(const std::filesystem::path &path, DdsLoadMode mode, DdsError &error);
+
+    [[nodiscard]]
+    SharedTexture readSharedDds(const std::filesystem::path &path, DdsLoadMode mode, DdsError &error);
+
+    // Receives a DDS file front to back. Returning false stops the write with DdsError::FileWriteFailed.
+    using DdsWriteCallback = std::function<bool(cputex::span<const cputex::byte> data)>;
+
+    // Streams a texture out as a DDS file without staging it in a buffer: the headers, then the surface data straight
+    // from the texture. A texture without padding goes out in a single write, otherwise each surface is written in
+    // one piece and only rows padded out to a row pitch are written one at a time. Formats with a DXGI equivalent are
+    // written with the DX10 extension.
+    [[nodiscard]]
+    DdsError writeDds(TextureView texture, const DdsWriteCallback &callback);
+
+    // Writes to an open file descriptor, starting at its current offset. The descriptor isn't closed.
+    [[nodiscard]]
+    DdsError writeDds(TextureView texture, int fileDescriptor);
+
+    // Creates or truncates the file at path.
+    [[nodiscard]]
+    DdsError writeDds(TextureView texture, const std::filesystem::path &path);
+}
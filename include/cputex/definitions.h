@@ -5,6 +5,9 @@
 #include <gpufmt/format.h>
 #include <gpufmt/definitions.h>
 
+#include <functional>
+#include <memory_resource>
+
 namespace cputex {
     using Extent = gpufmt::Extent;
     using ExtentComponent = gpufmt::ExtentComponent;
@@ -17,6 +20,32 @@ namespace cputex {
         TextureCube
     };
 
+    // Tag for the constructors that adopt caller owned surface data instead of copying it.
+    struct AdoptMemory {
+        explicit AdoptMemory() = default;
+    };
+
+    inline constexpr AdoptMemory adoptMemory{};
+
+    // Why a texture adopting caller owned surface data was left empty. The caller keeps ownership of the data then.
+    enum class AdoptError {
+        None,
+        InvalidParams,
+        DataTooSmall,
+        DataMisaligned,
+    };
+
+    // Tag for the constructors that leave the surface data uninitialized, for textures that are about to be
+    // overwritten in full.
+    struct Uninitialized {
+        explicit Uninitialized() = default;
+    };
+
+    inline constexpr Uninitialized uninitialized{};
+
+    // Releases adopted surface data once the last texture referring to it is destroyed.
+    using MemoryDeleter = std::function<void(cputex::span<cputex::byte> data)>;
+
     struct TextureParams {
         gpufmt::Format format = gpufmt::Format::UNDEFINED;
         TextureDimension dimension = TextureDimension::Texture2D;
@@ -25,6 +54,15 @@ namespace cputex {
         cputex::CountType faces = 0u;
         cputex::CountType mips = 0u;
         cputex::CountType surfaceByteAlignment = cputex::kDefaultSurfaceByteAlignment;
+
+        // Byte alignment of the start of every block row and of every volume slice of a surface. Rows and slices are
+        // padded out to it, so e.g. a rowPitchAlignment of 64 lets each row be loaded with aligned SIMD loads. The
+        // defaults of 1 pack rows and slices tightly.
+        cputex::CountType rowPitchAlignment = 1;
+        cputex::CountType sliceAlignment = 1;
+
+        // Where the texture's memory comes from. Null uses std::pmr::get_default_resource() at construction.
+        std::pmr::memory_resource *memoryResource = nullptr;
     };
 
     constexpr cputex::ExtentComponent maxExtentComponent = 16384;
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cputex::execution {
+    // Runs batches of independent tasks. Implement this to run cputexture's parallel operations on an existing job
+    // system instead of the built in thread pool.
+    class Executor {
+    public:
+        using TaskFunc = void(*)(void *context, cputex::SizeType taskIndex) noexcept;
+
+        virtual ~Executor() = default;
+
+        // Calls task(context, i) for every i in [0, taskCount), possibly concurrently and in any order, and returns once
+        // every call has returned. Tasks may call parallelFor themselves, so an implementation must not block a worker
+        // waiting on tasks that only other, busy workers could run. Having the calling thread run tasks too is enough.
+        virtual void parallelFor(cputex::SizeType taskCount, TaskFunc task, void *context) noexcept = 0;
+
+        // The number of threads tasks can run on, including the calling thread.
+        [[nodiscard]]
+        virtual cputex::SizeType concurrency() const noexcept = 0;
+    };
+
+    // A fixed set of worker threads. The thread calling parallelFor runs tasks alongside the workers, so a pool with no
+    // workers runs everything on the calling thread.
+    class ThreadPool final : public Executor {
+    public:
+        explicit ThreadPool(cputex::SizeType workerCount);
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool(ThreadPool &&) = delete;
+        ~ThreadPool() override;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        ThreadPool &operator=(ThreadPool &&) = delete;
+
+        void parallelFor(cputex::SizeType taskCount, TaskFunc task, void *context) noexcept override;
+
+        [[nodiscard]]
+        cputex::SizeType concurrency() const noexcept override;
+
+    private:
+        struct Job;
+
+        void workerMain() noexcept;
+
+        std::vector<std::thread> mWorkers;
+        std::deque<Job *> mJobs;
+        std::mutex mMutex;
+        std::condition_variable mJobAvailable;
+        std::condition_variable mJobFinished;
+        bool mStopping = false;
+    };
+
+    // A pool with one worker less than the number of hardware threads, created on first use.
+    [[nodiscard]]
+    Executor &defaultExecutor() noexcept;
+
+    class SequencedPolicy {};
+
+    class ParallelPolicy {
+    public:
+        constexpr ParallelPolicy() noexcept = default;
+        explicit constexpr ParallelPolicy(Executor &executor) noexcept
+            : mExecutor(&executor)
+        {}
+
+        // A policy that runs on executor instead of the default executor, e.g. cputex::execution::par.on(jobSystem).
+        [[nodiscard]]
+        constexpr ParallelPolicy on(Executor &executor) const noexcept {
+            return ParallelPolicy{ executor };
+        }
+
+        [[nodiscard]]
+        Executor &executor() const noexcept {
+            return (mExecutor != nullptr) ? *mExecutor : defaultExecutor();
+        }
+
+    private:
+        Executor *mExecutor = nullptr;
+    };
+
+    inline constexpr SequencedPolicy seq{};
+    inline constexpr ParallelPolicy par{};
+
+    // Calls func(i) for every i in [0, taskCount) on executor.
+    template<class Func>
+    void parallelFor(Executor &executor, cputex::SizeType taskCount, Func &&func) noexcept {
+        using FuncType = std::remove_reference_t<Func>;
+
+        executor.parallelFor(taskCount, [](void *context, cputex::SizeType taskIndex) noexcept {
+            (*static_cast<FuncType *>(context))(taskIndex);
+        }, const_cast<void *>(static_cast<const void *>(&func)));
+    }
+
+    // Calls func(arraySlice, face, mip) for every surface of a texture with the given layout. Surfaces are handed out
+    // largest first, i.e. mip by mip, so the big mips start straight away and the small ones fill in around them.
+    template<class Func>
+    void parallelForEachSurface(const ParallelPolicy &policy, cputex::CountType arraySize, cputex::CountType faces, cputex::CountType mips, Func &&func) noexcept {
+        const cputex::SizeType surfacesPerMip = static_cast<cputex::SizeType>(arraySize) * faces;
+
+        parallelFor(policy.executor(), surfacesPerMip * mips, [&func, surfacesPerMip, faces](cputex::SizeType surfaceIndex) {
+            const auto mip = static_cast<cputex::CountType>(surfaceIndex / surfacesPerMip);
+            const auto arraySlice = static_cast<cputex::CountType>((surfaceIndex % surfacesPerMip) / faces);
+            const auto face = static_cast<cputex::CountType>((surfaceIndex % surfacesPerMip) % faces);
+
+            func(arraySlice, face, mip);
+        });
+    }
+
+    // Bands smaller than this cost more to schedule than they save by running in parallel.
+    inline constexpr cputex::SizeType kMinBandByteSize = 256 * 1024;
+
+    // Splits rowCount rows of rowByteSize bytes each into contiguous bands, and calls func(firstRow, bandRowCount) for
+    // every band. Work that doesn't fill at least two bands runs as a single call on the calling thread. Callers pass
+    // rows of whole blocks so no band ever splits a block.
+    template<class Func>
+    void parallelForEachBand(const ParallelPolicy &policy, cputex::SizeType rowCount, cputex::SizeType rowByteSize, Func &&func) noexcept {
+        if(rowCount <= 0) {
+            return;
+        }
+
+        Executor &executor = policy.executor();
+        const cputex::SizeType concurrency = executor.concurrency();
+
+        // A few bands per thread lets threads that finish early pick up the slack.
+        const cputex::SizeType maxBandCount = (concurrency > 1) ? concurrency * 4 : 1;
+        const cputex::SizeType bandCount = std::min({ rowCount, (rowCount * rowByteSize) / kMinBandByteSize, maxBandCount });
+
+        if(bandCount <= 1) {
+            func(cputex::SizeType(0), rowCount);
+            return;
+        }
+
+        const cputex::SizeType bandRowCount = (rowCount + bandCount - 1) / bandCount;
+
+        parallelFor(executor, (rowCount + bandRowCount - 1) / bandRowCount, [&func, rowCount, bandRowCount](cputex::SizeType band) {
+            const cputex::SizeType firstRow = band * bandRowCount;
+            func(firstRow, std::min(bandRowCount, rowCount - firstRow));
+        });
+    }
+}
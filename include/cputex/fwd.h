@@ -1,9 +1,13 @@
 #pragma once
 
 namespace cputex {
+    class AsyncLoader;
     enum class TextureDimension;
     class Sampler;
     class SharedTexture;
+    class TextureArchive;
+    class TexturePool;
     class TextureView;
     class UniqueTexture;
+    class WeakTexture;
 }
\ No newline at end of file
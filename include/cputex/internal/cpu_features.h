@@ -0,0 +1,30 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CPUTEX_ARCH_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CPUTEX_ARCH_ARM64 1
+#endif
+
+// Lets individual functions use instruction set extensions that the rest of the library isn't compiled for. MSVC
+// allows intrinsics from any instruction set without annotating the function.
+#if defined(__GNUC__) || defined(__clang__)
+#define CPUTEX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CPUTEX_TARGET(isa)
+#endif
+
+namespace cputex::internal {
+    struct CpuFeatures {
+        bool ssse3 = false;
+        bool sse41 = false;
+        bool avx2 = false;
+        bool f16c = false;
+        bool neon = false;
+    };
+
+    // Queried once on first use. Kernels use this to pick the widest implementation the host supports at runtime, so
+    // a single binary doesn't need to be compiled for a particular instruction set.
+    [[nodiscard]]
+    const CpuFeatures &cpuFeatures() noexcept;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <filesystem>
+
+namespace cputex::internal {
+    // Maps a whole file copy-on-write: the pages are shared with the page cache until written to, and writes stay
+    // private to the process and never reach the file. Returns an empty span if the file can't be opened, is empty
+    // or can't be mapped.
+    [[nodiscard]]
+    cputex::span<cputex::byte> mapFile(const std::filesystem::path &path) noexcept;
+
+    // Unmaps a span returned by mapFile. The whole mapping must be passed, not a part of it.
+    void unmapFile(cputex::span<cputex::byte> mapping) noexcept;
+
+    // Opens an existing file for reading and returns its descriptor, or -1 if it can't be opened.
+    [[nodiscard]]
+    int openFile(const std::filesystem::path &path) noexcept;
+
+    // Returns -1 if the size can't be queried.
+    [[nodiscard]]
+    cputex::SizeType fileSize(int fileDescriptor) noexcept;
+
+    // Reads into data starting at byteOffset without moving the file position, so any number of threads can read the
+    // same descriptor at once. Returns the number of bytes read, which is only short at the end of the file, or -1 if
+    // a read failed.
+    [[nodiscard]]
+    cputex::SizeType readFileAt(int fileDescriptor, cputex::SizeType byteOffset, cputex::span<cputex::byte> data) noexcept;
+
+    // Creates or truncates a file for writing and returns its descriptor, or -1 if it can't be opened.
+    [[nodiscard]]
+    int createFile(const std::filesystem::path &path) noexcept;
+
+    // Returns false if the close reported an error, which can be a write error deferred until then.
+    [[nodiscard]]
+    bool closeFile(int fileDescriptor) noexcept;
+
+    // Writes all of data, retrying short and interrupted writes. Returns false on the first failed write.
+    [[nodiscard]]
+    bool writeFile(int fileDescriptor, cputex::span<const cputex::byte> data) noexcept;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <gpufmt/format.h>
+
+#include <cstdint>
+
+namespace cputex::internal {
+    // Number of channels in a 16 bit float format, or 0 if format isn't one.
+    [[nodiscard]]
+    constexpr cputex::SizeType halfFormatChannelCount(gpufmt::Format format) noexcept {
+        switch(format) {
+        case gpufmt::Format::R16_SFLOAT:
+            return 1;
+        case gpufmt::Format::R16G16_SFLOAT:
+            return 2;
+        case gpufmt::Format::R16G16B16_SFLOAT:
+            return 3;
+        case gpufmt::Format::R16G16B16A16_SFLOAT:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    // Scalar reference conversions. halfToFloat is exact. floatToHalf rounds to nearest even, overflows to infinity,
+    // produces subnormals where needed, and keeps NaNs quiet with the upper payload bits preserved, which matches
+    // both F16C and the arm fp16 conversions.
+    void halfToFloatScalar(const uint16_t *source, float *dest, cputex::SizeType count) noexcept;
+    void floatToHalfScalar(const float *source, uint16_t *dest, cputex::SizeType count) noexcept;
+
+    // Bulk conversions that use F16C or the arm fp16 conversion instructions when the host supports them. Results are
+    // identical to the scalar versions.
+    void halfToFloat(const uint16_t *source, float *dest, cputex::SizeType count) noexcept;
+    void floatToHalf(const float *source, uint16_t *dest, cputex::SizeType count) noexcept;
+}
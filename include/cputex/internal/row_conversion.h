@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <glm/vec4.hpp>
+
+namespace cputex::internal {
+    // Decodes samples.size() consecutive texels starting at source into samples.
+    using DecodeRowFunc = void(*)(const cputex::byte *source, cputex::span<glm::vec4> samples) noexcept;
+
+    // Encodes every sample in samples into consecutive texels starting at dest.
+    using EncodeRowFunc = void(*)(cputex::span<const glm::vec4> samples, cputex::byte *dest) noexcept;
+
+    // Converts texelCount consecutive texels starting at source directly into consecutive texels starting at dest.
+    using ConvertRowFunc = void(*)(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <glm/vec4.hpp>
+#include <gpufmt/format.h>
+
+#include <cstdint>
+
+namespace cputex::internal {
+    // True for the 8 bit per channel srgb formats that findByteSwizzle can reorder to and from R8G8B8A8_SRGB.
+    [[nodiscard]]
+    constexpr bool isSrgb8Format(gpufmt::Format format) noexcept {
+        switch(format) {
+        case gpufmt::Format::R8_SRGB:
+        case gpufmt::Format::R8G8_SRGB:
+        case gpufmt::Format::R8G8B8_SRGB:
+        case gpufmt::Format::B8G8R8_SRGB:
+        case gpufmt::Format::R8G8B8A8_SRGB:
+        case gpufmt::Format::B8G8R8A8_SRGB:
+        case gpufmt::Format::A8B8G8R8_SRGB_PACK32:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Decodes samples.size() R8G8B8A8_SRGB texels to linear values through a 256 entry lookup table. Alpha is linear
+    // and is only normalized.
+    void decodeSrgb8(const uint8_t *source, cputex::span<glm::vec4> samples) noexcept;
+
+    // Encodes linear samples to R8G8B8A8_SRGB texels. Values are clamped to [0, 1] and NaN encodes as 0.
+    //
+    // The power curve is approximated by a rational polynomial in sqrt(x), evaluated four texels at a time with SSE2
+    // or NEON. Before quantization the encoded value is within 3.7e-6 of the exact curve, under 0.001 of an 8 bit
+    // step. After rounding to 8 bits, about 0.004% of float inputs, all lying next to a rounding boundary, land one
+    // step away from the correctly rounded result.
+    void encodeSrgb8(cputex::span<const glm::vec4> samples, uint8_t *dest) noexcept;
+}
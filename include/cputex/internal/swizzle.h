@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <gpufmt/format.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace cputex::internal {
+    // A conversion between two uncompressed 8 bit per channel formats that only differ in channel order or channel
+    // count, e.g. R8G8B8A8 <-> B8G8R8A8 or R8G8B8 -> R8G8B8A8. These are pure byte shuffles.
+    struct ByteSwizzle {
+        static constexpr uint8_t kFillByte = 0x80;
+
+        uint8_t sourceTexelByteSize = 0;
+        uint8_t destTexelByteSize = 0;
+
+        // Number of texels handled by one 16 byte shuffle.
+        uint8_t groupTexelCount = 0;
+
+        // For every destination byte of a group, the source byte within the group it's copied from, or kFillByte if
+        // the destination channel doesn't exist in the source.
+        std::array<uint8_t, 16> shuffle{};
+
+        // Value ORed into the destination bytes whose shuffle entry is kFillByte.
+        std::array<uint8_t, 16> fill{};
+    };
+
+    using ByteSwizzleFunc = void(*)(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept;
+
+    // Returns a swizzle if both formats are 8 bit per channel, share the same numeric format (unorm, snorm, uint, sint
+    // or srgb), and differ only by channel order or count. Channels missing from the source are filled with 0, except
+    // alpha which is filled with one.
+    [[nodiscard]]
+    std::optional<ByteSwizzle> findByteSwizzle(gpufmt::Format sourceFormat, gpufmt::Format destFormat) noexcept;
+
+    // Selects the widest swizzle kernel supported by the host cpu. Every kernel produces results identical to
+    // byteSwizzleScalar.
+    [[nodiscard]]
+    ByteSwizzleFunc selectByteSwizzleKernel() noexcept;
+
+    void byteSwizzleScalar(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept;
+}
@@ -2,44 +2,170 @@
 
 #include <cputex/config.h>
 #include <cputex/definitions.h>
+#include <cputex/texture_layout.h>
 
 #include <glm/gtx/component_wise.hpp>
 
 #include <gpufmt/format.h>
 #include <gpufmt/info.h>
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
 
 namespace cputex::internal {
+    // Keeps the reference counts, which every copy of a shared texture writes, off the cache lines readers of the
+    // params and tables touch.
+    inline constexpr size_t kCacheLineByteSize = 64;
+
     class TextureStorage {
     private:
         struct SurfaceInfo {
             cputex::SizeType offset;
             cputex::SizeType sizeInBytes;
+            cputex::SizeType rowPitch;
+            cputex::SizeType slicePitch;
         };
     public:
+        // Surface data allocated apart from the header: the whole surface data of shared storage, or a single surface a
+        // copy-on-write moved out of data a snapshot still reads. The storage and every snapshot reading the data hold a
+        // reference, and whichever drops the last one frees it. The data follows the block at dataOffset.
+        struct DataBlock {
+            DataBlock(std::pmr::memory_resource *memoryResource_, cputex::SizeType allocationByteSize_, cputex::SizeType allocationByteAlignment_, cputex::SizeType dataOffset_) noexcept
+                : refCount(1)
+                , memoryResource(memoryResource_)
+                , allocationByteSize(allocationByteSize_)
+                , allocationByteAlignment(allocationByteAlignment_)
+                , dataOffset(dataOffset_)
+            {}
+
+            [[nodiscard]]
+            static DataBlock *create(std::pmr::memory_resource *memoryResource, cputex::SizeType dataByteSize, cputex::SizeType dataByteAlignment) {
+                const cputex::SizeType allocationByteAlignment = std::max(static_cast<cputex::SizeType>(alignof(DataBlock)), dataByteAlignment);
+                const cputex::SizeType dataOffset = Header::alignUp(sizeof(DataBlock), allocationByteAlignment);
+                const cputex::SizeType allocationByteSize = dataOffset + dataByteSize;
+
+                void *memory = memoryResource->allocate(static_cast<size_t>(allocationByteSize), static_cast<size_t>(allocationByteAlignment));
+                return new(memory) DataBlock(memoryResource, allocationByteSize, allocationByteAlignment, dataOffset);
+            }
+
+            [[nodiscard]]
+            cputex::byte *data() noexcept {
+                return reinterpret_cast<cputex::byte *>(this) + dataOffset;
+            }
+
+            [[nodiscard]]
+            const cputex::byte *data() const noexcept {
+                return reinterpret_cast<const cputex::byte *>(this) + dataOffset;
+            }
+
+            void addRef() noexcept {
+                refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release() noexcept {
+                // Acquire and release order every use of the data before whoever frees it, like std::shared_ptr.
+                if(refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::pmr::memory_resource *resource = memoryResource;
+                    const size_t byteSize = static_cast<size_t>(allocationByteSize);
+                    const size_t byteAlignment = static_cast<size_t>(allocationByteAlignment);
+
+                    this->~DataBlock();
+                    resource->deallocate(this, byteSize, byteAlignment);
+                }
+            }
+
+            std::atomic_int refCount;
+            std::pmr::memory_resource *memoryResource;
+            cputex::SizeType allocationByteSize;
+            cputex::SizeType allocationByteAlignment;
+            cputex::SizeType dataOffset;
+        };
+
         struct Header {
-            Header(int strongCount_, const TextureParams &params_, CountType surfaceCount_, SizeType sizeInBytes_)
+            Header(int strongCount_, const TextureParams &params_, CountType surfaceCount_, SizeType sizeInBytes_, SizeType allocationByteSize_, SizeType allocationByteAlignment_)
                 : strongCount(strongCount_)
+                , weakCount(1)
                 , params(params_)
                 , surfaceCount(surfaceCount_)
                 , sizeInBytes(sizeInBytes_)
+                , allocationByteSize(allocationByteSize_)
+                , allocationByteAlignment(allocationByteAlignment_)
                 , mipExtentsOffset(sizeof(Header))
             {
-                surfaceInfoOffset = mipExtentsOffset + sizeof(Extent) * params.mips;
-                surfaceDataOffset = surfaceInfoOffset + sizeof(SurfaceInfo) * surfaceCount;
+                surfaceInfoOffset = computeSurfaceInfoOffset(params.mips);
+                surfaceBlocksOffset = computeSurfaceBlocksOffset(params.mips, surfaceCount);
+                surfaceDataOffset = computeSurfaceDataOffset(params.mips, surfaceCount, allocationByteAlignment);
+            }
+
+            [[nodiscard]]
+            static constexpr cputex::SizeType alignUp(cputex::SizeType value, cputex::SizeType alignment) noexcept {
+                return ((value + (alignment - 1)) / alignment) * alignment;
+            }
+
+            [[nodiscard]]
+            static constexpr cputex::SizeType computeSurfaceInfoOffset(cputex::CountType mips) noexcept {
+                return alignUp(sizeof(Header) + sizeof(Extent) * mips, alignof(SurfaceInfo));
+            }
+
+            [[nodiscard]]
+            static constexpr cputex::SizeType computeSurfaceBlocksOffset(cputex::CountType mips, cputex::CountType surfaceCount) noexcept {
+                return alignUp(computeSurfaceInfoOffset(mips) + sizeof(SurfaceInfo) * surfaceCount, alignof(DataBlock *));
+            }
+
+            // The surface data follows the header, the mip extents, the surface infos and the surface blocks, rounded up
+            // so it starts on an allocationByteAlignment boundary.
+            [[nodiscard]]
+            static constexpr cputex::SizeType computeSurfaceDataOffset(cputex::CountType mips, cputex::CountType surfaceCount, cputex::SizeType allocationByteAlignment) noexcept {
+                return alignUp(computeSurfaceBlocksOffset(mips, surfaceCount) + sizeof(DataBlock *) * surfaceCount, allocationByteAlignment);
             }
 
-            mutable std::atomic_int strongCount;
+            // The header is freed once weakCount reaches zero. Strong references together hold one weak reference,
+            // which is dropped along with the surface data when the last of them goes.
+            alignas(kCacheLineByteSize) mutable std::atomic_int strongCount;
             mutable std::atomic_int weakCount;
-            TextureParams params;
+            alignas(kCacheLineByteSize) TextureParams params;
             cputex::CountType surfaceCount;
             cputex::SizeType sizeInBytes;
+            cputex::SizeType allocationByteSize;
+            cputex::SizeType allocationByteAlignment;
             cputex::SizeType mipExtentsOffset;
             cputex::SizeType surfaceInfoOffset;
+            cputex::SizeType surfaceBlocksOffset;
             cputex::SizeType surfaceDataOffset;
+
+            // Either points just past the tables in the same allocation, or at adopted memory.
+            cputex::byte *surfaceData = nullptr;
+            cputex::MemoryDeleter deleter;
+
+            // The data the storage was created with or adopted, which deleter is called with. surfaceData moves away
+            // from it once a copy-on-write gives the storage a dataBlock.
+            cputex::byte *initialSurfaceData = nullptr;
+            DataBlock *dataBlock = nullptr;
+
+            // Snapshots still reading initialSurfaceData. Those reading a dataBlock count in its refCount instead.
+            mutable std::atomic_int initialDataSnapshotCount = 0;
+
+            // Set on snapshots, whose initial data belongs to the storage they were taken from.
+            bool borrowsData = false;
+
+            // Surfaces with a block of their own in the surface blocks table, which are read from there rather than
+            // from surfaceData. Only changed while the buffer mutex is held exclusively.
+            cputex::CountType separateSurfaceCount = 0;
+
+            // A contiguous copy of the surface data, made for getData() while some surfaces are separate. It's
+            // dropped by the next write.
+            mutable std::atomic<DataBlock *> contiguousData = nullptr;
+            mutable std::mutex contiguousDataMutex;
+
+            // Guards the surface data of shared storage. Every handle to the storage locks the same mutex, readers
+            // shared and writers exclusive.
+            mutable std::shared_mutex bufferMutex;
         };
 
         TextureStorage() noexcept= default;
@@ -50,131 +176,61 @@ namespace cputex::internal {
 
         TextureStorage(TextureParams params, cputex::span<const cputex::byte> initialData, bool shared)
         {
-            if(params.format == gpufmt::Format::UNDEFINED) {
-                return;
-            }
+            const TextureLayout layout = cputex::computeLayout(params);
 
-            if(params.mips == 0) {
+            if(!layout.isValid()) {
                 return;
             }
 
-            if(params.arraySize == 0) {
-                return;
-            }
-
-            if(params.extent.x <= 0) {
-                return;
-            }
+            Header *header = createHeader(layout, true, shared);
 
-            if(params.dimension != TextureDimension::Texture1D && params.extent.y <= 0) {
-                return;
-            }
+            cputex::span<cputex::byte> surfaceData{ header->surfaceData, static_cast<cputex::span<Extent>::size_type>(header->sizeInBytes) };
+            const cputex::SizeType initialDataByteSize = std::min(static_cast<cputex::SizeType>(initialData.size_bytes()), layout.sizeInBytes);
+            std::copy_n(initialData.begin(), initialDataByteSize, surfaceData.begin());
+            std::fill(surfaceData.begin() + initialDataByteSize, surfaceData.end(), cputex::byte{ 0 });
+        }
 
-            if(params.dimension == TextureDimension::Texture3D && params.extent.z <= 0) {
-                return;
-            }
+        TextureStorage(cputex::Uninitialized, const TextureParams &params, bool shared)
+        {
+            const TextureLayout layout = cputex::computeLayout(params);
 
-            if(params.dimension == TextureDimension::TextureCube && params.faces != 6) {
+            if(!layout.isValid()) {
                 return;
             }
 
-            params.surfaceByteAlignment = std::max(params.surfaceByteAlignment, cputex::CountType(1));
-
-            params.extent.y = std::max(params.extent.y, cputex::ExtentComponent(1));
-            params.extent.z = std::max(params.extent.z, cputex::ExtentComponent(1));
-
-            const gpufmt::FormatInfo &info = gpufmt::formatInfo(params.format);
-
-            std::vector<Extent> tempMipExtents;
-            tempMipExtents.reserve(std::min(params.mips, cputex::CountType(15))); //max number of mips for a 16384 texture
-
-            {
-                Extent mipExtent = params.extent;
-
-                while(tempMipExtents.size() < tempMipExtents.capacity() &&
-                      (mipExtent.x > 1 || mipExtent.y > 1 || mipExtent.z > 1))
-                {
-                    tempMipExtents.emplace_back(mipExtent);
-
-                    switch(params.dimension) {
-                    case TextureDimension::Texture1D:
-                        mipExtent.x >>= 1;
-                        break;
-                    case TextureDimension::Texture2D:
-                        [[fallthrough]];
-                    case TextureDimension::TextureCube:
-                        mipExtent.x >>= 1;
-                        mipExtent.y >>= 1;
-                        break;
-                    case TextureDimension::Texture3D:
-                        mipExtent.x >>= 1;
-                        mipExtent.y >>= 1;
-                        mipExtent.z >>= 1;
-                        break;
-                    }
+            createHeader(layout, true, shared);
+        }
 
-                    mipExtent.x = std::max(mipExtent.x, ExtentComponent(1));
-                    mipExtent.y = std::max(mipExtent.y, ExtentComponent(1));
-                    mipExtent.z = std::max(mipExtent.z, ExtentComponent(1));
-                }
+        // Points the surface data at caller owned memory laid out in cputex's surface order instead of copying it. Only
+        // the header and tables are allocated. deleter, if set, is called with the data when the storage is destroyed.
+        // The data must be at least as large as the texture and aligned to its surface byte alignment, otherwise the
+        // storage is left empty, error says why, and the caller keeps ownership of the data. computeLayout makes the
+        // surface byte alignment a multiple of rowPitchAlignment, so this check covers row alignment as well.
+        TextureStorage(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter, bool shared, cputex::AdoptError &error)
+        {
+            error = cputex::AdoptError::None;
 
-                if(tempMipExtents.size() < params.mips && mipExtent.x == 1 && mipExtent.y == 1 && mipExtent.z == 1) {
-                    tempMipExtents.emplace_back(1, 1, 1);
-                }
+            const TextureLayout layout = cputex::computeLayout(params);
 
-                params.mips = static_cast<cputex::CountType>(tempMipExtents.size());
+            if(!layout.isValid()) {
+                error = cputex::AdoptError::InvalidParams;
+                return;
             }
 
-            params.faces = std::max(params.faces, cputex::CountType(1));
-            std::vector<SurfaceInfo> tempSurfaceInfos;
-            cputex::SizeType sizeInBytes = 0u;
-
-            tempSurfaceInfos.reserve(static_cast<size_t>(params.arraySize) * static_cast<size_t>(params.faces) * static_cast<size_t>(params.mips));
-                
-            for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
-                for(cputex::CountType face = 0; face < params.faces; ++face) {
-                    for(const Extent &mipExtent : tempMipExtents) {
-                        const glm::tvec3<cputex::SizeType> mipExtentSizeT = mipExtent;
-                        const glm::tvec3<cputex::SizeType> blockExtentSizeT = info.blockExtent;
-
-                        const auto rowByteSize = info.blockByteSize * ((mipExtent.x + info.blockExtent.x - 1) / info.blockExtent.x);
-                        const auto blockRows = (mipExtent.y + info.blockExtent.y - 1) / info.blockExtent.y;
-                        const auto sliceSizeInBytes = rowByteSize * blockRows;
-
-                        SurfaceInfo surfaceInfo;
-                        surfaceInfo.offset = sizeInBytes;
-                        surfaceInfo.sizeInBytes = sliceSizeInBytes * mipExtent.z;
-                        surfaceInfo.sizeInBytes = std::max(surfaceInfo.sizeInBytes, static_cast<cputex::SizeType>(info.blockByteSize));
-
-                        //make sure everything is byte aligned
-                        surfaceInfo.sizeInBytes = ((surfaceInfo.sizeInBytes + (params.surfaceByteAlignment - 1u)) / params.surfaceByteAlignment) * params.surfaceByteAlignment;
-                        sizeInBytes += surfaceInfo.sizeInBytes;
-                        tempSurfaceInfos.emplace_back(surfaceInfo);
-                    }
-                }
+            if(static_cast<cputex::SizeType>(data.size_bytes()) < layout.sizeInBytes) {
+                error = cputex::AdoptError::DataTooSmall;
+                return;
             }
 
-            if(sizeInBytes == 0) {
+            if(reinterpret_cast<std::uintptr_t>(data.data()) % static_cast<std::uintptr_t>(layout.params.surfaceByteAlignment) != 0) {
+                error = cputex::AdoptError::DataMisaligned;
                 return;
             }
 
-            std::unique_ptr<cputex::byte[]> storage = std::make_unique<cputex::byte[]>(sizeof(Header) + sizeof(SurfaceInfo) * tempSurfaceInfos.size() + sizeof(Extent) * tempMipExtents.size() + sizeInBytes);
-            
-            Header *header = new(storage.get()) Header(shared ? 1 : 0,
-                                                       params,
-                                                       static_cast<cputex::CountType>(tempSurfaceInfos.size()),
-                                                       sizeInBytes);
-            
-            cputex::span<Extent> mipExtents{ reinterpret_cast<Extent*>(storage.get() + header->mipExtentsOffset), static_cast<cputex::span<Extent>::size_type>(header->params.mips) };
-            std::copy(tempMipExtents.cbegin(), tempMipExtents.cend(), mipExtents.begin());
-
-            cputex::span<SurfaceInfo> surfaceInfos{ reinterpret_cast<SurfaceInfo*>(storage.get() + header->surfaceInfoOffset), static_cast<cputex::span<Extent>::size_type>(header->surfaceCount) };
-            std::copy(tempSurfaceInfos.cbegin(), tempSurfaceInfos.cend(), surfaceInfos.begin());
-
-            cputex::span<cputex::byte> surfaceData{ storage.get() + header->surfaceDataOffset, static_cast<cputex::span<Extent>::size_type>(header->sizeInBytes) };
-            std::copy_n(initialData.begin(), std::min(static_cast<cputex::SizeType>(initialData.size_bytes()), sizeInBytes), surfaceData.begin());
-
-            mStorage = storage.release();
+            Header *header = createHeader(layout, false, shared);
+            header->surfaceData = data.data();
+            header->initialSurfaceData = data.data();
+            header->deleter = std::move(deleter);
         }
 
         TextureStorage(const TextureStorage &) noexcept = default;
@@ -188,11 +244,9 @@ namespace cputex::internal {
         ~TextureStorage() = default;
 
         TextureStorage &operator=(const TextureStorage &) = default;
+        // Doesn't release the storage being replaced. The owning texture decides when that happens, since shared
+        // storage may still be referenced elsewhere.
         TextureStorage &operator=(TextureStorage &&other) noexcept {
-            if(mStorage != nullptr) {
-                delete mStorage;
-            }
-
             mStorage = other.mStorage;
             other.mStorage = nullptr;
             return *this;
@@ -208,22 +262,62 @@ namespace cputex::internal {
             return !operator==(nullptr);
         }
 
+        // Releases the surface data and the strong references' weak reference. Called on the last strong reference.
         void destroy() noexcept {
             if(isValid()) {
-                delete[] mStorage;
-                mStorage = nullptr;
+                Header *header = getHeader();
+
+                releaseSeparateSurfaces();
+                releaseContiguousData();
+
+                if(header->dataBlock != nullptr) {
+                    header->dataBlock->release();
+                    header->dataBlock = nullptr;
+                }
+
+                if(header->deleter) {
+                    header->deleter(cputex::span<cputex::byte>(header->initialSurfaceData, static_cast<size_t>(header->sizeInBytes)));
+
+                    // Whatever the deleter captured goes now rather than with the header.
+                    header->deleter = {};
+                }
+
+                header->surfaceData = nullptr;
+                header->initialSurfaceData = nullptr;
+
+                decWeakRef();
             }
         }
 
         void addRef() const noexcept {
             if(mStorage) {
-                ++getHeader()->strongCount;
+                // A new reference can only be made from an existing one, so there's nothing to order against.
+                getHeader()->strongCount.fetch_add(1, std::memory_order_relaxed);
             }
         }
 
         bool decRef() noexcept {
             if(mStorage) {
-                if((--getHeader()->strongCount) == 0) {
+                // Every earlier use of the texture happens before the last reference destroys it.
+                if(getHeader()->strongCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Adds a strong reference unless the last one is already gone, for promoting a weak reference.
+        [[nodiscard]]
+        bool tryAddRef() const noexcept {
+            if(mStorage == nullptr) {
+                return false;
+            }
+
+            int count = getHeader()->strongCount.load(std::memory_order_relaxed);
+
+            while(count > 0) {
+                if(getHeader()->strongCount.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
                     return true;
                 }
             }
@@ -231,6 +325,151 @@ namespace cputex::internal {
             return false;
         }
 
+        [[nodiscard]]
+        bool expired() const noexcept {
+            return mStorage == nullptr || getHeader()->strongCount.load(std::memory_order_acquire) == 0;
+        }
+
+        void addWeakRef() const noexcept {
+            if(mStorage) {
+                getHeader()->weakCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Frees the header with the last weak reference. Leaves this storage empty either way.
+        void decWeakRef() noexcept {
+            if(mStorage == nullptr) {
+                return;
+            }
+
+            Header *header = getHeader();
+
+            if(header->weakCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::pmr::memory_resource *memoryResource = header->params.memoryResource;
+                const size_t allocationByteSize = static_cast<size_t>(header->allocationByteSize);
+                const size_t allocationByteAlignment = static_cast<size_t>(header->allocationByteAlignment);
+
+                header->~Header();
+                memoryResource->deallocate(mStorage, allocationByteSize, allocationByteAlignment);
+            }
+
+            mStorage = nullptr;
+        }
+
+        // Creates shared storage with the same params that reads this storage's current surface data in place. Each
+        // surface is copied by whichever of the two next writes to it, so neither sees the other's writes. The caller
+        // holds the buffer mutex, at least shared, so the data is consistent.
+        [[nodiscard]]
+        TextureStorage snapshot() const {
+            const Header *header = getHeader();
+            cputex::AdoptError adoptError;
+            TextureStorage snapshot{ cputex::adoptMemory, header->params, cputex::span<cputex::byte>(header->surfaceData, static_cast<size_t>(header->sizeInBytes)), {}, true, adoptError };
+
+            if(!snapshot.isValid()) {
+                return snapshot;
+            }
+
+            Header *snapshotHeader = snapshot.getHeader();
+            snapshotHeader->borrowsData = true;
+
+            if(header->dataBlock != nullptr) {
+                DataBlock *dataBlock = header->dataBlock;
+                dataBlock->addRef();
+
+                snapshotHeader->deleter = [dataBlock](cputex::span<cputex::byte>) {
+                    dataBlock->release();
+                };
+            } else {
+                // The initial data lives in or is owned by this storage, so the snapshot keeps the storage alive.
+                // Snapshots are taken under the buffer mutex, which orders this against writers checking the count.
+                header->initialDataSnapshotCount.fetch_add(1, std::memory_order_relaxed);
+                addRef();
+
+                snapshotHeader->deleter = [source = *this](cputex::span<cputex::byte>) mutable {
+                    // Releases the snapshot's reads to a writer that sees the count drop and writes in place.
+                    source.getHeader()->initialDataSnapshotCount.fetch_sub(1, std::memory_order_release);
+
+                    if(source.decRef()) {
+                        source.destroy();
+                    }
+                };
+            }
+
+            // Surfaces this storage already copied out are shared block by block.
+            const cputex::span<DataBlock *const> surfaceBlocks = getSurfaceBlocks();
+            const cputex::span<DataBlock *> snapshotSurfaceBlocks = snapshot.getSurfaceBlocks();
+
+            for(size_t i = 0; i < surfaceBlocks.size(); ++i) {
+                if(surfaceBlocks[i] != nullptr) {
+                    surfaceBlocks[i]->addRef();
+                    snapshotSurfaceBlocks[i] = surfaceBlocks[i];
+                }
+            }
+
+            snapshotHeader->separateSurfaceCount = header->separateSurfaceCount;
+
+            return snapshot;
+        }
+
+        // Makes shared storage out of unique storage, leaving this storage empty. Surface data in the header's allocation
+        // gets a new header that adopts it, since weak references keep the header alive and would keep the data with
+        // it. The old allocation is freed along with the data. Other data is already apart from the header.
+        [[nodiscard]]
+        TextureStorage shareUnique() {
+            if(!isValid()) {
+                return {};
+            }
+
+            Header *header = getHeader();
+            TextureStorage shared;
+
+            if(header->surfaceData != mStorage + header->surfaceDataOffset) {
+                shared = std::move(*this);
+                shared.addRef();
+                return shared;
+            }
+
+            // Made before anything changes, so a failed allocation leaves this storage as it was.
+            cputex::MemoryDeleter deleter = [unique = *this](cputex::span<cputex::byte>) mutable {
+                unique.destroy();
+            };
+
+            Header *sharedHeader = shared.createHeader(cputex::computeLayout(header->params), false, true);
+            sharedHeader->surfaceData = header->surfaceData;
+            sharedHeader->initialSurfaceData = header->surfaceData;
+            sharedHeader->deleter = std::move(deleter);
+
+            mStorage = nullptr;
+            return shared;
+        }
+
+        // Copies the surfaces written since a snapshot back into the surface data once no snapshot reads it any more,
+        // so getData() is contiguous again. Only the separate surfaces are copied. The caller holds the buffer mutex
+        // exclusively.
+        void mergeSeparateSurfaces() noexcept {
+            if(!isValid()) {
+                return;
+            }
+
+            Header *header = getHeader();
+
+            if(header->separateSurfaceCount == 0 || sharesData()) {
+                return;
+            }
+
+            const cputex::span<DataBlock *> surfaceBlocks = getSurfaceBlocks();
+            const cputex::span<const SurfaceInfo> surfaceInfos = getSurfaceInfos();
+
+            for(size_t i = 0; i < surfaceBlocks.size(); ++i) {
+                if(surfaceBlocks[i] != nullptr) {
+                    std::copy_n(surfaceBlocks[i]->data(), surfaceInfos[i].sizeInBytes, header->surfaceData + surfaceInfos[i].offset);
+                }
+            }
+
+            releaseSeparateSurfaces();
+            releaseContiguousData();
+        }
+
         [[nodiscard]]
         const Extent &extent(cputex::CountType mip) const noexcept {
             static constexpr Extent zero{ 0u, 0u, 0u };
@@ -276,16 +515,41 @@ namespace cputex::internal {
             return (mStorage) ? getHeader()->params.surfaceByteAlignment : 0u;
         }
 
+        [[nodiscard]]
+        cputex::CountType rowPitchAlignment() const noexcept {
+            return (mStorage) ? getHeader()->params.rowPitchAlignment : 0u;
+        }
+
+        [[nodiscard]]
+        cputex::CountType sliceAlignment() const noexcept {
+            return (mStorage) ? getHeader()->params.sliceAlignment : 0u;
+        }
+
         [[nodiscard]]
         cputex::SizeType sizeInBytes() const noexcept {
             return (mStorage) ? getHeader()->sizeInBytes : 0u;
         }
 
+        [[nodiscard]]
+        std::pmr::memory_resource *memoryResource() const noexcept {
+            return (mStorage) ? getHeader()->params.memoryResource : nullptr;
+        }
+
         [[nodiscard]]
         cputex::SizeType sizeInBytes(cputex::CountType mip) const noexcept {
             return (mStorage) ? getSurfaceInfo(getSurfaceIndex(0u, 0u, mip)).sizeInBytes : 0u;
         }
 
+        [[nodiscard]]
+        cputex::SizeType rowPitch(cputex::CountType mip) const noexcept {
+            return (mStorage) ? getSurfaceInfo(getSurfaceIndex(0u, 0u, mip)).rowPitch : 0u;
+        }
+
+        [[nodiscard]]
+        cputex::SizeType slicePitch(cputex::CountType mip) const noexcept {
+            return (mStorage) ? getSurfaceInfo(getSurfaceIndex(0u, 0u, mip)).slicePitch : 0u;
+        }
+
         [[nodiscard]]
         cputex::CountType surfaceCount() const noexcept {
             return (mStorage) ? getHeader()->surfaceCount : 0u;
@@ -338,9 +602,9 @@ namespace cputex::internal {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            cputex::SizeType volumeSliceByteSize = surfaceInfo.sizeInBytes / mipExtent.z;
-            return getData().subspan(surfaceInfo.offset + (volumeSliceByteSize * volumeSlice), volumeSliceByteSize);
+            const cputex::IndexType surfaceIndex = getSurfaceIndexUnsafe(arraySlice, face, mip);
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            return getSurface(surfaceIndex).subspan(surfaceInfo.slicePitch * volumeSlice, surfaceInfo.slicePitch);
         }
 
         template<class T>
@@ -365,13 +629,13 @@ namespace cputex::internal {
             }
 
             const Extent &mipExtent = extent(mip);
-            if(volumeSlice >= extent(mip).z) {
+            if(volumeSlice >= mipExtent.z) {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            cputex::SizeType volumeSliceByteSize = surfaceInfo.sizeInBytes / mipExtent.z;
-            auto byteSpan = getData().subspan(surfaceInfo.offset + (volumeSliceByteSize * volumeSlice), volumeSliceByteSize);
+            const cputex::IndexType surfaceIndex = getSurfaceIndexUnsafe(arraySlice, face, mip);
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            auto byteSpan = getSurface(surfaceIndex).subspan(surfaceInfo.slicePitch * volumeSlice, surfaceInfo.slicePitch);
 
             return cputex::span<const T>{reinterpret_cast<const T*>(byteSpan.data()), byteSpan.size_bytes() / sizeof(T)};
         }
@@ -397,13 +661,19 @@ namespace cputex::internal {
             }
 
             const Extent &mipExtent = extent(mip);
-            if(volumeSlice >= extent(mip).z) {
+            if(volumeSlice >= mipExtent.z) {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            cputex::SizeType volumeSliceByteSize = surfaceInfo.sizeInBytes / mipExtent.z;
-            return accessData().subspan(surfaceInfo.offset + (volumeSliceByteSize * volumeSlice), volumeSliceByteSize);
+            const cputex::IndexType surfaceIndex = getSurfaceIndexUnsafe(arraySlice, face, mip);
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            const cputex::span<cputex::byte> surface = accessSurface(surfaceIndex);
+
+            if(surface.empty()) {
+                return {};
+            }
+
+            return surface.subspan(surfaceInfo.slicePitch * volumeSlice, surfaceInfo.slicePitch);
         }
 
         template<class T>
@@ -428,13 +698,19 @@ namespace cputex::internal {
             }
 
             const Extent &mipExtent = extent(mip);
-            if(volumeSlice >= extent(mip).z) {
+            if(volumeSlice >= mipExtent.z) {
+                return {};
+            }
+
+            const cputex::IndexType surfaceIndex = getSurfaceIndexUnsafe(arraySlice, face, mip);
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            const cputex::span<cputex::byte> surface = accessSurface(surfaceIndex);
+
+            if(surface.empty()) {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            cputex::SizeType volumeSliceByteSize = surfaceInfo.sizeInBytes / mipExtent.z;
-            auto byteSpan = accessData().subspan(surfaceInfo.offset + (volumeSliceByteSize * volumeSlice), volumeSliceByteSize);
+            auto byteSpan = surface.subspan(surfaceInfo.slicePitch * volumeSlice, surfaceInfo.slicePitch);
 
             return cputex::span<T>{reinterpret_cast<T*>(byteSpan.data()), byteSpan.size_bytes() / sizeof(T)};
         }
@@ -459,8 +735,7 @@ namespace cputex::internal {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            return getData().subspan(surfaceInfo.offset, surfaceInfo.sizeInBytes);
+            return getSurface(getSurfaceIndexUnsafe(arraySlice, face, mip));
         }
 
         template<class T>
@@ -484,8 +759,7 @@ namespace cputex::internal {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            auto byteSpan = getData().subspan(surfaceInfo.offset, surfaceInfo.sizeInBytes);
+            auto byteSpan = getSurface(getSurfaceIndexUnsafe(arraySlice, face, mip));
 
             return cputex::span<const T>{reinterpret_cast<const T*>(byteSpan.data()), byteSpan.size_bytes() / sizeof(T)};
         }
@@ -510,8 +784,7 @@ namespace cputex::internal {
                 return {};
             }
 
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            return accessData().subspan(surfaceInfo.offset, surfaceInfo.sizeInBytes);
+            return accessSurface(getSurfaceIndexUnsafe(arraySlice, face, mip));
         }
 
         template<class T>
@@ -534,9 +807,8 @@ namespace cputex::internal {
             if(mip >= header->params.mips) {
                 return {};
             }
-            
-            const SurfaceInfo &surfaceInfo = getSurfaceInfo(getSurfaceIndexUnsafe(arraySlice, face, mip));
-            auto byteSpan = accessData().subspan(surfaceInfo.offset, surfaceInfo.sizeInBytes);
+
+            auto byteSpan = accessSurface(getSurfaceIndexUnsafe(arraySlice, face, mip));
 
             return cputex::span<T>{reinterpret_cast<T *>(byteSpan.data()), byteSpan.size_bytes() / sizeof(T)};
         }
@@ -585,32 +857,296 @@ namespace cputex::internal {
             return cputex::span<const Extent>(reinterpret_cast<const Extent*>(mStorage + header->mipExtentsOffset), header->params.mips);
         }
 
+        // Writing the whole surface data needs it contiguous and not read by any snapshot, so this copies it if a
+        // snapshot still reads it and merges in any separate surfaces. Returns an empty span if that copy can't be
+        // allocated.
         [[nodiscard]]
         cputex::span<cputex::byte> accessData() noexcept {
+            if(!makeDataUnique()) {
+                return {};
+            }
+
             const Header *header = getHeader();
-            return cputex::span<cputex::byte>(mStorage + header->surfaceDataOffset, header->sizeInBytes);
+            return cputex::span<cputex::byte>(header->surfaceData, header->sizeInBytes);
         }
 
         template<class T>
         [[nodiscard]]
         cputex::span<T> accessDataAs() noexcept {
-            const Header *header = getHeader();
-            return cputex::span<T>(reinterpret_cast<T*>(mStorage + header->surfaceDataOffset), header->sizeInBytes / sizeof(T));
+            const cputex::span<cputex::byte> data = accessData();
+            return cputex::span<T>(reinterpret_cast<T*>(data.data()), data.size_bytes() / sizeof(T));
         }
 
+        // While some surfaces are separate, returns a contiguous copy made on first use and kept until the next write.
+        // Returns an empty span if that copy can't be allocated.
         [[nodiscard]]
         cputex::span<const cputex::byte> getData() const noexcept {
             const Header *header = getHeader();
-            return cputex::span<const cputex::byte>(mStorage + header->surfaceDataOffset, header->sizeInBytes);
+
+            if(header->separateSurfaceCount == 0) {
+                return cputex::span<const cputex::byte>(header->surfaceData, header->sizeInBytes);
+            }
+
+            const DataBlock *contiguousData = getContiguousData();
+
+            if(contiguousData == nullptr) {
+                return {};
+            }
+
+            return cputex::span<const cputex::byte>(contiguousData->data(), header->sizeInBytes);
         }
 
         template<class T>
         [[nodiscard]]
         cputex::span<const T> getDataAs() const noexcept {
+            const cputex::span<const cputex::byte> data = getData();
+            return cputex::span<const T>(reinterpret_cast<const T*>(data.data()), data.size_bytes() / sizeof(T));
+        }
+
+    private:
+        [[nodiscard]]
+        cputex::span<DataBlock *> getSurfaceBlocks() noexcept {
+            const Header *header = getHeader();
+            return cputex::span<DataBlock *>(reinterpret_cast<DataBlock **>(mStorage + header->surfaceBlocksOffset), header->surfaceCount);
+        }
+
+        [[nodiscard]]
+        cputex::span<DataBlock *const> getSurfaceBlocks() const noexcept {
+            const Header *header = getHeader();
+            return cputex::span<DataBlock *const>(reinterpret_cast<DataBlock *const *>(mStorage + header->surfaceBlocksOffset), header->surfaceCount);
+        }
+
+        // Whether a snapshot, or the storage a snapshot was taken from, still reads surfaceData.
+        [[nodiscard]]
+        bool sharesData() const noexcept {
             const Header *header = getHeader();
-            return cputex::span<const T>(reinterpret_cast<const T*>(mStorage + header->surfaceDataOffset, header->sizeInBytes / sizeof(T)));
+
+            return (header->dataBlock != nullptr)
+                ? header->dataBlock->refCount.load(std::memory_order_acquire) > 1
+                : (header->borrowsData || header->initialDataSnapshotCount.load(std::memory_order_acquire) > 0);
+        }
+
+        [[nodiscard]]
+        cputex::span<const cputex::byte> getSurface(cputex::IndexType surfaceIndex) const noexcept {
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            const DataBlock *surfaceBlock = getSurfaceBlocks()[surfaceIndex];
+            const cputex::byte *surface = (surfaceBlock != nullptr) ? surfaceBlock->data() : getHeader()->surfaceData + surfaceInfo.offset;
+
+            return cputex::span<const cputex::byte>(surface, static_cast<size_t>(surfaceInfo.sizeInBytes));
         }
 
+        // Returns the surface to write to, copying it into a block of its own first if a snapshot still reads it.
+        // Returns an empty span if the copy can't be allocated.
+        [[nodiscard]]
+        cputex::span<cputex::byte> accessSurface(cputex::IndexType surfaceIndex) noexcept {
+            Header *header = getHeader();
+            const SurfaceInfo &surfaceInfo = getSurfaceInfo(surfaceIndex);
+            DataBlock *&surfaceBlock = getSurfaceBlocks()[surfaceIndex];
+
+            releaseContiguousData();
+
+            if(surfaceBlock != nullptr && surfaceBlock->refCount.load(std::memory_order_acquire) == 1) {
+                return cputex::span<cputex::byte>(surfaceBlock->data(), static_cast<size_t>(surfaceInfo.sizeInBytes));
+            }
+
+            if(surfaceBlock == nullptr && !sharesData()) {
+                return cputex::span<cputex::byte>(header->surfaceData + surfaceInfo.offset, static_cast<size_t>(surfaceInfo.sizeInBytes));
+            }
+
+            DataBlock *copy = nullptr;
+
+            try {
+                copy = DataBlock::create(header->params.memoryResource, surfaceInfo.sizeInBytes, header->allocationByteAlignment);
+            } catch(...) {
+                return {};
+            }
+
+            const cputex::span<const cputex::byte> surface = getSurface(surfaceIndex);
+            std::copy(surface.begin(), surface.end(), copy->data());
+
+            if(surfaceBlock != nullptr) {
+                surfaceBlock->release();
+            } else {
+                ++header->separateSurfaceCount;
+            }
+
+            surfaceBlock = copy;
+            return cputex::span<cputex::byte>(copy->data(), static_cast<size_t>(surfaceInfo.sizeInBytes));
+        }
+
+        // Leaves surfaceData contiguous and read by no snapshot, copying it only if a snapshot still reads it.
+        [[nodiscard]]
+        bool makeDataUnique() noexcept {
+            Header *header = getHeader();
+
+            releaseContiguousData();
+
+            if(!sharesData()) {
+                mergeSeparateSurfaces();
+                return true;
+            }
+
+            DataBlock *dataBlock = nullptr;
+
+            try {
+                dataBlock = DataBlock::create(header->params.memoryResource, header->sizeInBytes, header->allocationByteAlignment);
+            } catch(...) {
+                return false;
+            }
+
+            copyContiguousData(dataBlock->data());
+            releaseSeparateSurfaces();
+
+            if(header->dataBlock != nullptr) {
+                header->dataBlock->release();
+            }
+
+            header->dataBlock = dataBlock;
+            header->surfaceData = dataBlock->data();
+            return true;
+        }
+
+        // Copies surfaceData with the separate surfaces in place of their stale copies in it.
+        void copyContiguousData(cputex::byte *destination) const noexcept {
+            const Header *header = getHeader();
+            std::copy_n(header->surfaceData, header->sizeInBytes, destination);
+
+            if(header->separateSurfaceCount == 0) {
+                return;
+            }
+
+            const cputex::span<DataBlock *const> surfaceBlocks = getSurfaceBlocks();
+            const cputex::span<const SurfaceInfo> surfaceInfos = getSurfaceInfos();
+
+            for(size_t i = 0; i < surfaceBlocks.size(); ++i) {
+                if(surfaceBlocks[i] != nullptr) {
+                    std::copy_n(surfaceBlocks[i]->data(), surfaceInfos[i].sizeInBytes, destination + surfaceInfos[i].offset);
+                }
+            }
+        }
+
+        // Readers may call getData() at the same time, so only the first makes the copy.
+        [[nodiscard]]
+        const DataBlock *getContiguousData() const noexcept {
+            const Header *header = getHeader();
+            DataBlock *contiguousData = header->contiguousData.load(std::memory_order_acquire);
+
+            if(contiguousData != nullptr) {
+                return contiguousData;
+            }
+
+            try {
+                std::lock_guard lock(header->contiguousDataMutex);
+                contiguousData = header->contiguousData.load(std::memory_order_relaxed);
+
+                if(contiguousData == nullptr) {
+                    contiguousData = DataBlock::create(header->params.memoryResource, header->sizeInBytes, header->allocationByteAlignment);
+                    copyContiguousData(contiguousData->data());
+                    header->contiguousData.store(contiguousData, std::memory_order_release);
+                }
+            } catch(...) {
+                return nullptr;
+            }
+
+            return contiguousData;
+        }
+
+        // Called by writers, which hold the buffer mutex exclusively, so no reader still uses the copy.
+        void releaseContiguousData() noexcept {
+            DataBlock *contiguousData = getHeader()->contiguousData.exchange(nullptr, std::memory_order_relaxed);
+
+            if(contiguousData != nullptr) {
+                contiguousData->release();
+            }
+        }
+
+        void releaseSeparateSurfaces() noexcept {
+            Header *header = getHeader();
+
+            if(header->separateSurfaceCount == 0) {
+                return;
+            }
+
+            for(DataBlock *&surfaceBlock : getSurfaceBlocks()) {
+                if(surfaceBlock != nullptr) {
+                    surfaceBlock->release();
+                    surfaceBlock = nullptr;
+                }
+            }
+
+            header->separateSurfaceCount = 0;
+        }
+
+        // Allocates and fills in the header and tables. The surface data is only allocated when ownsData is set, along
+        // with them for unique storage, and as a separate block for shared storage so it can be freed while weak
+        // references keep the header.
+        Header *createHeader(const TextureLayout &layout, bool ownsData, bool shared) {
+            TextureParams params = layout.params;
+            const cputex::CountType surfaceCount = layout.surfaceCount();
+
+            if(params.memoryResource == nullptr) {
+                params.memoryResource = std::pmr::get_default_resource();
+            }
+
+            // The allocation is aligned so surfaceByteAlignment holds for the surface addresses themselves, not just
+            // their offsets. Alignments that aren't a power of two only hold for the offsets.
+            const cputex::SizeType allocationByteAlignment = std::max(static_cast<cputex::SizeType>(alignof(Header)),
+                                                                      static_cast<cputex::SizeType>(std::bit_ceil(static_cast<size_t>(params.surfaceByteAlignment))));
+            const bool dataInHeader = ownsData && !shared;
+            const cputex::SizeType dataByteSize = (dataInHeader) ? layout.sizeInBytes : 0;
+            const cputex::SizeType allocationByteSize = Header::computeSurfaceDataOffset(params.mips, surfaceCount, allocationByteAlignment) + dataByteSize;
+
+            cputex::byte *storage = static_cast<cputex::byte*>(params.memoryResource->allocate(static_cast<size_t>(allocationByteSize), static_cast<size_t>(allocationByteAlignment)));
+
+            Header *header = new(storage) Header(shared ? 1 : 0,
+                                                 params,
+                                                 surfaceCount,
+                                                 layout.sizeInBytes,
+                                                 allocationByteSize,
+                                                 allocationByteAlignment);
+
+            if(dataInHeader) {
+                header->surfaceData = storage + header->surfaceDataOffset;
+            } else if(ownsData) {
+                try {
+                    header->dataBlock = DataBlock::create(params.memoryResource, layout.sizeInBytes, allocationByteAlignment);
+                } catch(...) {
+                    header->~Header();
+                    params.memoryResource->deallocate(storage, static_cast<size_t>(allocationByteSize), static_cast<size_t>(allocationByteAlignment));
+                    throw;
+                }
+
+                header->surfaceData = header->dataBlock->data();
+            }
+
+            header->initialSurfaceData = header->surfaceData;
+
+            cputex::span<Extent> mipExtents{ reinterpret_cast<Extent*>(storage + header->mipExtentsOffset), static_cast<cputex::span<Extent>::size_type>(header->params.mips) };
+            std::copy_n(layout.mipExtents.cbegin(), params.mips, mipExtents.begin());
+
+            cputex::span<SurfaceInfo> surfaceInfos{ reinterpret_cast<SurfaceInfo*>(storage + header->surfaceInfoOffset), static_cast<cputex::span<Extent>::size_type>(header->surfaceCount) };
+
+            auto surfaceInfoItr = surfaceInfos.begin();
+
+            for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
+                for(cputex::CountType face = 0; face < params.faces; ++face) {
+                    for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                        SurfaceInfo &surfaceInfo = *surfaceInfoItr++;
+                        surfaceInfo.offset = layout.surfaceOffset(arraySlice, face, mip);
+                        surfaceInfo.sizeInBytes = layout.mipByteSizes[mip];
+                        surfaceInfo.rowPitch = layout.mipRowPitches[mip];
+                        surfaceInfo.slicePitch = layout.mipSlicePitches[mip];
+                    }
+                }
+            }
+
+            std::uninitialized_fill_n(reinterpret_cast<DataBlock**>(storage + header->surfaceBlocksOffset), header->surfaceCount, nullptr);
+
+            mStorage = storage;
+            return header;
+        }
+
+    public:
         cputex::byte *mStorage = nullptr;
     };
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cputex/definitions.h>
+#include <cputex/execution.h>
+#include <cputex/unique_texture.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+namespace cputex {
+    enum class Ktx2Error {
+        None,
+        FileOpenFailed,
+        FileReadFailed,
+        FileMapFailed,
+        FileWriteFailed,
+        InvalidHeader,
+        UnsupportedFormat,
+        UnsupportedSupercompression,
+        FileTooSmall,
+        InvalidMip,
+        CompressionFailed,
+        DecompressionFailed,
+        TextureCreationFailed,
+        EmptyTexture,
+    };
+
+    enum class Ktx2Supercompression : uint32_t {
+        None = 0,
+        BasisLZ = 1,
+        Zstandard = 2,
+        Zlib = 3,
+    };
+
+    // Where one mip level lives in the file. A level holds every array slice, face and volume slice of the mip, and
+    // is supercompressed as a unit, so any level can be read without touching the others.
+    struct Ktx2Level {
+        cputex::SizeType byteOffset = 0;
+        cputex::SizeType byteLength = 0;
+        cputex::SizeType uncompressedByteLength = 0;
+    };
+
+    struct Ktx2Header {
+        TextureParams params;
+        Ktx2Supercompression supercompression = Ktx2Supercompression::None;
+        std::array<Ktx2Level, maxMipCount> levels{};
+
+        // Bytes from the start of the file needed to parse the header and the level index.
+        cputex::SizeType byteSize = 0;
+    };
+
+    // The header is followed by one 24 byte level index entry per mip.
+    inline constexpr cputex::SizeType kKtx2HeaderByteSize = 80;
+
+    // Parses the header and level index at the start of a KTX2 file, translating the format through gpufmt's Vulkan
+    // table. If fileData is too short for the level index, FileTooSmall is returned along with the byteSize needed.
+    [[nodiscard]]
+    Ktx2Header parseKtx2Header(cputex::span<const cputex::byte> fileData, Ktx2Error &error) noexcept;
+
+    // Reads every mip. Supercompressed levels are decompressed independently, in parallel with a ParallelPolicy.
+    [[nodiscard]]
+    UniqueTexture readKtx2(cputex::span<const cputex::byte> fileData, Ktx2Error &error);
+
+    [[nodiscard]]
+    UniqueTexture readKtx2(const cputex::execution::ParallelPolicy &policy, cputex::span<const cputex::byte> fileData, Ktx2Error &error);
+
+    // Maps the file, so only the pages of the levels are read, and unmaps it once the texture is read.
+    [[nodiscard]]
+    UniqueTexture readKtx2(const std::filesystem::path &path, Ktx2Error &error);
+
+    [[nodiscard]]
+    UniqueTexture readKtx2(const cputex::execution::ParallelPolicy &policy, const std::filesystem::path &path, Ktx2Error &error);
+
+    // Reads a single mip level into a texture with one mip, looking it up in the level index and decoding nothing
+    // else. From a path only the header, level index and that level are read.
+    [[nodiscard]]
+    UniqueTexture readKtx2Mip(cputex::span<const cputex::byte> fileData, cputex::CountType mip, Ktx2Error &error);
+
+    [[nodiscard]]
+    UniqueTexture readKtx2Mip(const std::filesystem::path &path, cputex::CountType mip, Ktx2Error &error);
+
+    struct Ktx2WriteOptions {
+        // None and Zstandard are supported. Zstandard needs cputexture built with CPUTEX_ZSTD.
+        Ktx2Supercompression supercompression = Ktx2Supercompression::None;
+        int zstdCompressionLevel = 3;
+    };
+
+    // Receives a KTX2 file front to back. Returning false stops the write with Ktx2Error::FileWriteFailed.
+    using Ktx2WriteCallback = std::function<bool(cputex::span<const cputex::byte> data)>;
+
+    // Levels are written smallest first, so a reader streaming the file gets a low resolution mip early. Without
+    // supercompression the surface data is streamed straight from the texture; supercompressed levels have to be
+    // compressed up front to fill in the level index, in parallel with a ParallelPolicy.
+    [[nodiscard]]
+    Ktx2Error writeKtx2(TextureView texture, const Ktx2WriteCallback &callback, const Ktx2WriteOptions &options = {});
+
+    [[nodiscard]]
+    Ktx2Error writeKtx2(const cputex::execution::ParallelPolicy &policy, TextureView texture, const Ktx2WriteCallback &callback, const Ktx2WriteOptions &options = {});
+
+    // Creates or truncates the file at path.
+    [[nodiscard]]
+    Ktx2Error writeKtx2(TextureView texture, const std::filesystem::path &path, const Ktx2WriteOptions &options = {});
+
+    [[nodiscard]]
+    Ktx2Error writeKtx2(const cputex::execution::ParallelPolicy &policy, TextureView texture, const std::filesystem::path &path, const Ktx2WriteOptions &options = {});
+}
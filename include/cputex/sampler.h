@@ -4,11 +4,53 @@
 
 #include <gpufmt/sample.h>
 
+#include <limits>
+
 namespace cputex {
+    enum class Filter {
+        Point,
+        Linear,
+    };
+
+    // How texel coordinates outside [0, extent) are resolved, per axis.
+    enum class AddressMode {
+        Wrap,
+        Mirror,
+        Clamp,
+        Border,
+    };
+
+    // Follows the usual GPU sampler state. Texel centers sit at (i + 0.5) / extent, and lod 0 is the sampler's base mip.
+    struct SamplerDesc {
+        Filter magFilter = Filter::Point;
+        Filter minFilter = Filter::Point;
+        Filter mipFilter = Filter::Point;
+
+        AddressMode addressU = AddressMode::Wrap;
+        AddressMode addressV = AddressMode::Wrap;
+        AddressMode addressW = AddressMode::Wrap;
+
+        // Converted to the type the texture's format samples to.
+        glm::vec4 borderColor{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+        float mipLodBias = 0.0f;
+        float minLod = 0.0f;
+        float maxLod = std::numeric_limits<float>::max();
+
+        // Above 1, sampleGrad takes up to this many samples along the longer axis of the footprint.
+        cputex::CountType maxAnisotropy = 1;
+    };
+
+    // Samples a texture on the CPU. Samples are blended as doubles and returned as the type the format samples to.
+    // Formats sampling to integers aren't filtered; they return the tap with the most weight, as with Filter::Point.
+    //
+    // The overloads taking blockSamples decode into the caller's buffer, which must hold blockTexelCount() samples.
+    // Filtered samples decode each block their footprint touches once, however many of its texels they blend.
     class Sampler {
     public:
         Sampler() noexcept = default;
         Sampler(TextureView texture) noexcept;
+        Sampler(TextureView texture, const SamplerDesc &desc) noexcept;
 
         [[nodiscard]]
         const cputex::Extent &blockExtent() const noexcept;
@@ -16,12 +58,33 @@ namespace cputex {
         [[nodiscard]]
         cputex::CountType blockTexelCount() const noexcept;
 
+        [[nodiscard]]
+        const SamplerDesc &desc() const noexcept {
+            return mDesc;
+        }
+
+        // Samples mip with the magnification filter. The mip filter doesn't apply.
         [[nodiscard]]
         gpufmt::SampleVariant sample(glm::vec3 uvCoords, cputex::CountType arraySlice = 0, cputex::CountType face = 0, cputex::CountType mip = 0) const noexcept;
 
         [[nodiscard]]
         gpufmt::SampleVariant sample(glm::vec3 uvCoords, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice = 0, cputex::CountType face = 0, cputex::CountType mip = 0) const noexcept;
 
+        // Samples at an explicit level of detail, blending the two nearest mips when mipFilter is Linear.
+        [[nodiscard]]
+        gpufmt::SampleVariant sampleLevel(glm::vec3 uvCoords, float lod, cputex::CountType arraySlice = 0, cputex::CountType face = 0) const noexcept;
+
+        [[nodiscard]]
+        gpufmt::SampleVariant sampleLevel(glm::vec3 uvCoords, float lod, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice = 0, cputex::CountType face = 0) const noexcept;
+
+        // Samples with the level of detail picked from the screen space derivatives of uvCoords, anisotropically when
+        // maxAnisotropy is above 1.
+        [[nodiscard]]
+        gpufmt::SampleVariant sampleGrad(glm::vec3 uvCoords, glm::vec3 ddx, glm::vec3 ddy, cputex::CountType arraySlice = 0, cputex::CountType face = 0) const noexcept;
+
+        [[nodiscard]]
+        gpufmt::SampleVariant sampleGrad(glm::vec3 uvCoords, glm::vec3 ddx, glm::vec3 ddy, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice = 0, cputex::CountType face = 0) const noexcept;
+
         [[nodiscard]]
         gpufmt::SampleVariant load(cputex::Extent texel, cputex::CountType arraySlice = 0, cputex::CountType face = 0, cputex::CountType mip = 0) const noexcept;
 
@@ -29,7 +92,21 @@ namespace cputex {
         gpufmt::SampleVariant load(cputex::Extent texel, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice = 0, cputex::CountType face = 0, cputex::CountType mip = 0) const noexcept;
 
     private:
+        class Accumulator;
+
+        // Decodes the block holding texel into blockSamples. Returns false if it can't be decoded.
+        [[nodiscard]]
+        bool decodeBlock(cputex::Extent texel, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept;
+
+        // Adds the taps of one filtered lookup, scaled by weight, to accumulator.
+        void accumulateMip(Accumulator &accumulator, glm::vec3 uvCoords, Filter filter, double weight, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept;
+        void accumulateLevel(Accumulator &accumulator, glm::vec3 uvCoords, float lod, double weight, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face) const noexcept;
+
         TextureView mTexture;
         gpufmt::BlockSampler mSampler;
+        SamplerDesc mDesc;
+
+        // borderColor as the type the format samples to.
+        gpufmt::SampleVariant mBorderSample;
     };
-}
\ No newline at end of file
+}
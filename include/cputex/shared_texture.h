@@ -2,25 +2,55 @@
 
 #include <cputex/internal/texture_storage.h>
 #include <cputex/texture_view.h>
+#include <cputex/unique_texture.h>
 
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 
 namespace cputex {
+    // Exclusive access to a SharedTexture's surface data, shared by every handle to the same texture. Writers should
+    // hold one for as long as they write, and readers should hold a SharedTextureReadLock while they read.
     class SharedTextureLock {
     public:
         SharedTextureLock() noexcept = default;
-        SharedTextureLock(cputex::internal::TextureStorage &storage, std::mutex &bufferMutex)
-            : mLock(bufferMutex)
-            , mStorage(storage)
-        {}
+        explicit SharedTextureLock(cputex::internal::TextureStorage &storage)
+            : mStorage(storage)
+        {
+            if(mStorage.isValid()) {
+                mStorage.addRef();
+                mLock = std::unique_lock(mStorage.getHeader()->bufferMutex);
+                mStorage.mergeSeparateSurfaces();
+            }
+        }
+
+        SharedTextureLock(SharedTextureLock &&other) noexcept = default;
+
+        ~SharedTextureLock() noexcept {
+            release();
+        }
+
+        SharedTextureLock &operator=(SharedTextureLock &&other) noexcept {
+            if(this != &other) {
+                release();
+                mLock = std::move(other.mLock);
+                mStorage = std::move(other.mStorage);
+            }
+
+            return *this;
+        }
 
         [[nodiscard]]
         operator cputex::TextureSpan() noexcept {
             return cputex::TextureSpan{ mStorage };
         }
 
+        [[nodiscard]]
+        operator cputex::TextureView() const noexcept {
+            return cputex::TextureView{ mStorage };
+        }
+
         [[nodiscard]]
         const Extent &extent(cputex::CountType mip = 0) const noexcept {
             return mStorage.extent(mip);
@@ -66,6 +96,16 @@ namespace cputex {
             return mStorage.sizeInBytes(mip);
         }
 
+        [[nodiscard]]
+        cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept {
+            return mStorage.rowPitch(mip);
+        }
+
+        [[nodiscard]]
+        cputex::SizeType slicePitch(cputex::CountType mip = 0) const noexcept {
+            return mStorage.slicePitch(mip);
+        }
+
         [[nodiscard]]
         cputex::CountType surfaceCount() const noexcept {
             return mStorage.surfaceCount();
@@ -100,7 +140,144 @@ namespace cputex {
         }
 
     private:
-        std::unique_lock<std::mutex> mLock;
+        // The lock holds a reference, so the storage and its mutex outlive it even if every texture handle is gone.
+        void release() noexcept {
+            if(mLock.owns_lock()) {
+                mLock.unlock();
+            }
+
+            if(mStorage.decRef()) {
+                mStorage.destroy();
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> mLock;
+        cputex::internal::TextureStorage mStorage;
+    };
+
+    // Shared access to a SharedTexture's surface data. Any number of read locks can be held at once, on any handles to
+    // the texture, while no SharedTextureLock is.
+    class SharedTextureReadLock {
+    public:
+        SharedTextureReadLock() noexcept = default;
+        explicit SharedTextureReadLock(const cputex::internal::TextureStorage &storage)
+            : mStorage(storage)
+        {
+            if(mStorage.isValid()) {
+                mStorage.addRef();
+                mLock = std::shared_lock(mStorage.getHeader()->bufferMutex);
+            }
+        }
+
+        SharedTextureReadLock(SharedTextureReadLock &&other) noexcept = default;
+
+        ~SharedTextureReadLock() noexcept {
+            release();
+        }
+
+        SharedTextureReadLock &operator=(SharedTextureReadLock &&other) noexcept {
+            if(this != &other) {
+                release();
+                mLock = std::move(other.mLock);
+                mStorage = std::move(other.mStorage);
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]]
+        operator cputex::TextureView() const noexcept {
+            return cputex::TextureView{ mStorage };
+        }
+
+        [[nodiscard]]
+        const Extent &extent(cputex::CountType mip = 0) const noexcept {
+            return mStorage.extent(mip);
+        }
+
+        [[nodiscard]]
+        cputex::CountType arraySize() const noexcept {
+            return mStorage.arraySize();
+        }
+
+        [[nodiscard]]
+        cputex::CountType faces() const noexcept {
+            return mStorage.faces();
+        }
+
+        [[nodiscard]]
+        cputex::CountType mips() const noexcept {
+            return mStorage.mips();
+        }
+
+        [[nodiscard]]
+        TextureDimension dimension() const noexcept {
+            return mStorage.dimension();
+        }
+
+        [[nodiscard]]
+        gpufmt::Format format() const noexcept {
+            return mStorage.format();
+        }
+
+        [[nodiscard]]
+        cputex::SizeType sizeInBytes() const noexcept {
+            return mStorage.sizeInBytes();
+        }
+
+        [[nodiscard]]
+        cputex::SizeType sizeInBytes(cputex::CountType mip) const noexcept {
+            return mStorage.sizeInBytes(mip);
+        }
+
+        [[nodiscard]]
+        cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept {
+            return mStorage.rowPitch(mip);
+        }
+
+        [[nodiscard]]
+        cputex::SizeType slicePitch(cputex::CountType mip = 0) const noexcept {
+            return mStorage.slicePitch(mip);
+        }
+
+        [[nodiscard]]
+        cputex::CountType surfaceCount() const noexcept {
+            return mStorage.surfaceCount();
+        }
+
+        [[nodiscard]]
+        cputex::span<const cputex::byte> get2DSurfaceData(cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip, cputex::CountType volumeSlice) const noexcept {
+            return mStorage.get2DSurfaceData(arraySlice, face, mip, volumeSlice);
+        }
+
+        [[nodiscard]]
+        cputex::TextureSurfaceView getMipSurface(cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+            return cputex::TextureSurfaceView{ mStorage, arraySlice, face, mip };
+        }
+
+        [[nodiscard]]
+        cputex::span<const cputex::byte> getMipSurfaceData(cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+            return mStorage.getMipSurfaceData(arraySlice, face, mip);
+        }
+
+        template<class T>
+        [[nodiscard]]
+        cputex::span<const T> getMipSurfaceDataAs(cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+            return mStorage.getMipSurfaceDataAs<T>(arraySlice, face, mip);
+        }
+
+    private:
+        void release() noexcept {
+            if(mLock.owns_lock()) {
+                mLock.unlock();
+            }
+
+            if(mStorage.decRef()) {
+                mStorage.destroy();
+            }
+        }
+
+        std::shared_lock<std::shared_mutex> mLock;
         cputex::internal::TextureStorage mStorage;
     };
     
@@ -109,6 +286,17 @@ namespace cputex {
 		SharedTexture() noexcept = default;
 		explicit SharedTexture(const TextureParams &params);
         SharedTexture(const TextureParams &params, cputex::span<const cputex::byte> initialData);
+        SharedTexture(cputex::Uninitialized, const TextureParams &params);
+        SharedTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter = {});
+        // Leaves the texture empty, with error saying why, if params are invalid or the data is too small or
+        // misaligned for them. The data must be aligned to surfaceByteAlignment, which is raised to a multiple of
+        // rowPitchAlignment and sliceAlignment, so the rows of adopted data keep their alignment too.
+        SharedTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter, cputex::AdoptError &error);
+
+        // Takes over the texture's surface data without copying it. Only a new header is allocated when the data shares
+        // the texture's allocation, so the data can still be freed while WeakTextures keep the header. The texture is
+        // left as it was if that allocation fails.
+        explicit SharedTexture(UniqueTexture &&texture);
 		SharedTexture(const SharedTexture &other) noexcept;
 		SharedTexture(SharedTexture &&other) noexcept;
 		~SharedTexture() noexcept;
@@ -152,12 +340,21 @@ namespace cputex {
         [[nodiscard]]
         cputex::CountType surfaceByteAlignment() const noexcept;
 
+        [[nodiscard]]
+        std::pmr::memory_resource *memoryResource() const noexcept;
+
         [[nodiscard]]
         cputex::SizeType sizeInBytes() const noexcept;
 
         [[nodiscard]]
         cputex::SizeType sizeInBytes(cputex::CountType mip) const noexcept;
 
+        [[nodiscard]]
+        cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept;
+
+        [[nodiscard]]
+        cputex::SizeType slicePitch(cputex::CountType mip = 0) const noexcept;
+
         [[nodiscard]]
         cputex::CountType surfaceCount() const noexcept;
 
@@ -182,14 +379,57 @@ namespace cputex {
             return mTextureStorage.get2DSurfaceDataAs<T>(arraySlice, face, mip);
         }
 
+        // The data accessors above don't lock. Threads sharing a texture while it's written to should go through
+        // these locks, which every handle to the texture shares.
         [[nodiscard]]
         SharedTextureLock lock();
 
+        [[nodiscard]]
+        SharedTextureReadLock readLock() const;
+
+        // A texture with the same contents that shares this one's surface data instead of copying it. Whichever of the
+        // two next writes to a surface copies that surface first, so the snapshot never sees later writes, and neither
+        // does this texture see writes to the snapshot. Writing the whole data at once, through TextureSpan::accessData,
+        // copies all of it. Taking a snapshot waits for any writer to finish.
+        [[nodiscard]]
+        SharedTexture snapshot() const;
+
         [[nodiscard]]
 		SharedTexture clone() const noexcept;
 
 	private:
+        friend class TextureArchive;
+        friend class WeakTexture;
+
         internal::TextureStorage mTextureStorage;
-        std::mutex mBufferMutex;
 	};
+
+    // Refers to a SharedTexture's storage without keeping it alive, like std::weak_ptr. The surface data is freed with
+    // the last SharedTexture, and only the small header stays until the last WeakTexture goes, so a cache can hold
+    // textures without holding their memory.
+    class WeakTexture {
+    public:
+        WeakTexture() noexcept = default;
+        WeakTexture(const SharedTexture &texture) noexcept;
+        WeakTexture(const WeakTexture &other) noexcept;
+        WeakTexture(WeakTexture &&other) noexcept;
+        ~WeakTexture() noexcept;
+
+        WeakTexture &operator=(const WeakTexture &other) noexcept;
+        WeakTexture &operator=(WeakTexture &&other) noexcept;
+        WeakTexture &operator=(const SharedTexture &texture) noexcept;
+
+        // True once every SharedTexture of the storage is gone, or if there never was one.
+        [[nodiscard]]
+        bool expired() const noexcept;
+
+        // Returns a texture sharing the storage, or an empty texture if it has expired.
+        [[nodiscard]]
+        SharedTexture lock() const noexcept;
+
+        void reset() noexcept;
+
+    private:
+        internal::TextureStorage mTextureStorage;
+    };
 }
\ No newline at end of file
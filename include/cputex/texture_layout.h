@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cputex/config.h>
+#include <cputex/definitions.h>
+
+#include <gpufmt/info.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace cputex {
+    // Where every surface of a texture lives in its surface data. Every array slice and face has the same mip chain, so
+    // the mips are only described once and the surfaces of each array slice and face follow one another.
+    struct TextureLayout {
+        // The params the layout was computed from, with mips clamped to the mips the extent has and with the faces,
+        // extent and alignments raised to at least 1. surfaceByteAlignment is also raised to a multiple of
+        // rowPitchAlignment and sliceAlignment, so aligned rows and slices stay aligned in memory.
+        TextureParams params;
+
+        std::array<Extent, maxMipCount> mipExtents{};
+
+        // Byte distance between the starts of consecutive block rows, and of consecutive volume slices, of each mip.
+        std::array<cputex::SizeType, maxMipCount> mipRowPitches{};
+        std::array<cputex::SizeType, maxMipCount> mipSlicePitches{};
+
+        // Offset of each mip from the start of its array slice and face.
+        std::array<cputex::SizeType, maxMipCount> mipOffsets{};
+
+        // Size of each mip, padded out to surfaceByteAlignment.
+        std::array<cputex::SizeType, maxMipCount> mipByteSizes{};
+
+        // Size of one array slice and face, all of its mips included.
+        cputex::SizeType faceByteSize = 0;
+
+        cputex::SizeType sizeInBytes = 0;
+
+        [[nodiscard]]
+        constexpr bool isValid() const noexcept {
+            return sizeInBytes > 0;
+        }
+
+        [[nodiscard]]
+        constexpr cputex::CountType surfaceCount() const noexcept {
+            return params.arraySize * params.faces * params.mips;
+        }
+
+        [[nodiscard]]
+        constexpr cputex::SizeType surfaceOffset(cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+            return (static_cast<cputex::SizeType>(arraySlice) * params.faces + face) * faceByteSize + mipOffsets[mip];
+        }
+    };
+
+    // Computes the layout of a texture without creating it, e.g. to size a staging buffer or a file read. Returns an
+    // invalid layout for params no texture can be created from, including extents past maxExtent.
+    [[nodiscard]]
+    constexpr TextureLayout computeLayout(TextureParams params, const gpufmt::FormatInfo &info) noexcept {
+        TextureLayout layout;
+
+        if(params.format == gpufmt::Format::UNDEFINED) {
+            return layout;
+        }
+
+        if(params.mips <= 0) {
+            return layout;
+        }
+
+        if(params.arraySize <= 0) {
+            return layout;
+        }
+
+        if(params.extent.x > maxExtentComponent || params.extent.y > maxExtentComponent || params.extent.z > maxExtentComponent) {
+            return layout;
+        }
+
+        if(params.extent.x <= 0) {
+            return layout;
+        }
+
+        if(params.dimension != TextureDimension::Texture1D && params.extent.y <= 0) {
+            return layout;
+        }
+
+        if(params.dimension == TextureDimension::Texture3D && params.extent.z <= 0) {
+            return layout;
+        }
+
+        if(params.dimension == TextureDimension::TextureCube && params.faces != 6) {
+            return layout;
+        }
+
+        params.rowPitchAlignment = std::max(params.rowPitchAlignment, cputex::CountType(1));
+        params.sliceAlignment = std::lcm(std::max(params.sliceAlignment, cputex::CountType(1)), params.rowPitchAlignment);
+        params.surfaceByteAlignment = std::lcm(std::max(params.surfaceByteAlignment, cputex::CountType(1)), params.sliceAlignment);
+
+        params.extent.y = std::max(params.extent.y, cputex::ExtentComponent(1));
+        params.extent.z = std::max(params.extent.z, cputex::ExtentComponent(1));
+
+        const cputex::CountType maxMips = std::min(params.mips, maxMipCount);
+        cputex::CountType mips = 0;
+
+        {
+            Extent mipExtent = params.extent;
+
+            while(mips < maxMips &&
+                  (mipExtent.x > 1 || mipExtent.y > 1 || mipExtent.z > 1))
+            {
+                layout.mipExtents[mips++] = mipExtent;
+
+                switch(params.dimension) {
+                case TextureDimension::Texture1D:
+                    mipExtent.x >>= 1;
+                    break;
+                case TextureDimension::Texture2D:
+                    [[fallthrough]];
+                case TextureDimension::TextureCube:
+                    mipExtent.x >>= 1;
+                    mipExtent.y >>= 1;
+                    break;
+                case TextureDimension::Texture3D:
+                    mipExtent.x >>= 1;
+                    mipExtent.y >>= 1;
+                    mipExtent.z >>= 1;
+                    break;
+                }
+
+                mipExtent.x = std::max(mipExtent.x, ExtentComponent(1));
+                mipExtent.y = std::max(mipExtent.y, ExtentComponent(1));
+                mipExtent.z = std::max(mipExtent.z, ExtentComponent(1));
+            }
+
+            if(mips < maxMips && mipExtent.x == 1 && mipExtent.y == 1 && mipExtent.z == 1) {
+                layout.mipExtents[mips++] = Extent{ 1, 1, 1 };
+            }
+
+            params.mips = mips;
+        }
+
+        params.faces = std::max(params.faces, cputex::CountType(1));
+
+        for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+            const Extent &mipExtent = layout.mipExtents[mip];
+
+            const cputex::SizeType rowByteSize = info.blockByteSize * ((mipExtent.x + info.blockExtent.x - 1) / info.blockExtent.x);
+            const cputex::SizeType blockRows = (mipExtent.y + info.blockExtent.y - 1) / info.blockExtent.y;
+            const cputex::SizeType rowPitch = ((rowByteSize + (params.rowPitchAlignment - 1)) / params.rowPitchAlignment) * params.rowPitchAlignment;
+            const cputex::SizeType slicePitch = ((rowPitch * blockRows + (params.sliceAlignment - 1)) / params.sliceAlignment) * params.sliceAlignment;
+
+            cputex::SizeType mipByteSize = slicePitch * mipExtent.z;
+            mipByteSize = std::max(mipByteSize, static_cast<cputex::SizeType>(info.blockByteSize));
+
+            //make sure everything is byte aligned
+            mipByteSize = ((mipByteSize + (params.surfaceByteAlignment - 1)) / params.surfaceByteAlignment) * params.surfaceByteAlignment;
+
+            layout.mipRowPitches[mip] = rowPitch;
+            layout.mipSlicePitches[mip] = slicePitch;
+            layout.mipOffsets[mip] = layout.faceByteSize;
+            layout.mipByteSizes[mip] = mipByteSize;
+            layout.faceByteSize += mipByteSize;
+        }
+
+        layout.sizeInBytes = layout.faceByteSize * params.arraySize * params.faces;
+        layout.params = params;
+
+        return layout;
+    }
+
+    [[nodiscard]]
+    inline TextureLayout computeLayout(const TextureParams &params) noexcept {
+        return computeLayout(params, gpufmt::formatInfo(params.format));
+    }
+}
@@ -1,25 +1,99 @@
 #pragma once
 
+#include <cputex/execution.h>
 #include <cputex/texture_view.h>
 
+#include <atomic>
+
 namespace cputex {
+    void clear(cputex::SurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
     void clear(cputex::TextureSurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::TextureSurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
     void clear(cputex::TextureSpan texture, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept;
+
+    inline void clear(cputex::execution::SequencedPolicy, cputex::SurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept {
+        clear(surface, clearColor);
+    }
+
+    inline void clear(cputex::execution::SequencedPolicy, cputex::TextureSurfaceSpan surface, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept {
+        clear(surface, clearColor);
+    }
+
+    inline void clear(cputex::execution::SequencedPolicy, cputex::TextureSpan texture, const glm::dvec4 &clearColor = { 0.0, 0.0, 0.0, 1.0 }) noexcept {
+        clear(texture, clearColor);
+    }
 
     bool flipHorizontal(cputex::SurfaceSpan surface) noexcept;
+    bool flipHorizontal(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface) noexcept;
     bool flipHorizontal(cputex::TextureSpan texture) noexcept;
+    bool flipHorizontal(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture) noexcept;
     bool flipHorizontalTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
+    bool flipHorizontalTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
     bool flipHorizontalTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+    bool flipHorizontalTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+
+    inline bool flipHorizontal(cputex::execution::SequencedPolicy, cputex::SurfaceSpan surface) noexcept {
+        return flipHorizontal(surface);
+    }
+
+    inline bool flipHorizontal(cputex::execution::SequencedPolicy, cputex::TextureSpan texture) noexcept {
+        return flipHorizontal(texture);
+    }
+
+    inline bool flipHorizontalTo(cputex::execution::SequencedPolicy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        return flipHorizontalTo(sourceSurface, destSurface);
+    }
+
+    inline bool flipHorizontalTo(cputex::execution::SequencedPolicy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        return flipHorizontalTo(sourceTexture, destTexture);
+    }
 
     bool flipVertical(cputex::SurfaceSpan surface) noexcept;
+    bool flipVertical(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface) noexcept;
     bool flipVertical(cputex::TextureSpan texture) noexcept;
+    bool flipVertical(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture) noexcept;
     bool flipVerticalTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
+    bool flipVerticalTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
     bool flipVerticalTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+    bool flipVerticalTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+
+    inline bool flipVertical(cputex::execution::SequencedPolicy, cputex::SurfaceSpan surface) noexcept {
+        return flipVertical(surface);
+    }
+
+    inline bool flipVertical(cputex::execution::SequencedPolicy, cputex::TextureSpan texture) noexcept {
+        return flipVertical(texture);
+    }
+
+    inline bool flipVerticalTo(cputex::execution::SequencedPolicy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        return flipVerticalTo(sourceSurface, destSurface);
+    }
+
+    inline bool flipVerticalTo(cputex::execution::SequencedPolicy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        return flipVerticalTo(sourceTexture, destTexture);
+    }
 
     bool copySurfaceRegionTo(cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept;
+    bool copySurfaceRegionTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept;
+
+    inline bool copySurfaceRegionTo(cputex::execution::SequencedPolicy, cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept {
+        return copySurfaceRegionTo(sourceSurface, sourceOffset, destSurface, destOffset, copyExtent);
+    }
 
     bool decompressSurfaceTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
+    bool decompressSurfaceTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept;
     bool decompressTextureTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+    bool decompressTextureTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept;
+
+    inline bool decompressSurfaceTo(cputex::execution::SequencedPolicy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        return decompressSurfaceTo(sourceSurface, destSurface);
+    }
+
+    inline bool decompressTextureTo(cputex::execution::SequencedPolicy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        return decompressTextureTo(sourceTexture, destTexture);
+    }
 
     template<class Pred>
     void transform(cputex::SurfaceSpan surface, Pred pred)
@@ -29,16 +103,16 @@ namespace cputex {
         const cputex::Extent surfaceExtent = surface.extent();
         const cputex::Extent surfaceBlockExtent = surfaceExtent / formatInfo.blockExtent;
 
-        std::span surfaceData = surface.accessData();
-
         for(ExtentComponent zBlock = 0; zBlock < surfaceBlockExtent.z; ++zBlock)
         {
             for(ExtentComponent yBlock = 0; yBlock < surfaceBlockExtent.y; ++yBlock)
             {
+                std::span rowData = surface.accessRowData(yBlock, zBlock);
+
                 for(ExtentComponent xBlock = 0; xBlock < surfaceBlockExtent.x; ++xBlock)
                 {
-                    const auto offset = (zBlock * surfaceBlockExtent.y * surfaceBlockExtent.x + yBlock * surfaceBlockExtent.x + xBlock) * formatInfo.blockByteSize;
-                    pred(surface.format(), surfaceData.subspan(offset, formatInfo.blockByteSize));
+                    const auto offset = xBlock * formatInfo.blockByteSize;
+                    pred(surface.format(), rowData.subspan(offset, formatInfo.blockByteSize));
                 }
             }
         }
@@ -59,7 +133,7 @@ namespace cputex {
             {
                 for(CountType mip = 0; mip < texture.mips(); ++mip)
                 {
-                    transform(texture.accessMipSurface(arraySlice, face, mip, &pred), [arraySlice, face, mip](gpufmt::Format format, std::span<std::byte> block)
+                    transform(texture.accessMipSurface(arraySlice, face, mip), [&pred, arraySlice, face, mip](gpufmt::Format format, std::span<std::byte> block)
                     {
                         pred(format, arraySlice, face, mip, block);
                     });
@@ -67,4 +141,23 @@ namespace cputex {
             }
         }
     }
+
+    // pred is called concurrently from multiple threads.
+    template<class Pred>
+    void transform(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture, Pred pred)
+    {
+        cputex::execution::parallelForEachSurface(policy, texture.arraySize(), texture.faces(), texture.mips(), [&](CountType arraySlice, CountType face, CountType mip)
+        {
+            transform(texture.accessMipSurface(arraySlice, face, mip), [&pred, arraySlice, face, mip](gpufmt::Format format, std::span<std::byte> block)
+            {
+                pred(format, arraySlice, face, mip, block);
+            });
+        });
+    }
+
+    template<class Pred>
+    void transform(cputex::execution::SequencedPolicy, cputex::TextureSpan texture, Pred pred)
+    {
+        transform(texture, std::move(pred));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cputex/config.h>
+
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cputex {
+    struct TexturePoolStats {
+        // Allocations served from a cached block.
+        cputex::SizeType hits = 0;
+
+        // Allocations that went to the upstream resource.
+        cputex::SizeType misses = 0;
+
+        // Blocks handed back to the upstream resource because keeping them would exceed the budget, or by trim().
+        cputex::SizeType releases = 0;
+
+        cputex::SizeType cachedBlockCount = 0;
+        cputex::SizeType cachedByteSize = 0;
+    };
+
+    // A memory resource that keeps released texture storage and hands it back out to textures of the same byte size
+    // and alignment, so textures created and destroyed with the same TextureParams stop round tripping through the
+    // upstream allocator. Set it as TextureParams::memoryResource. Safe to use from multiple threads, and it must
+    // outlive every texture allocated from it.
+    class TexturePool final : public std::pmr::memory_resource {
+    public:
+        // byteBudget caps the bytes kept cached. Memory held by live textures doesn't count against it.
+        explicit TexturePool(cputex::SizeType byteBudget, std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept;
+        TexturePool(const TexturePool &) = delete;
+        TexturePool(TexturePool &&) = delete;
+        ~TexturePool() override;
+
+        TexturePool &operator=(const TexturePool &) = delete;
+        TexturePool &operator=(TexturePool &&) = delete;
+
+        // Releases cached blocks, largest first, until at most targetByteSize bytes are cached.
+        void trim(cputex::SizeType targetByteSize = 0) noexcept;
+
+        void setByteBudget(cputex::SizeType byteBudget) noexcept;
+
+        [[nodiscard]]
+        cputex::SizeType byteBudget() const noexcept;
+
+        [[nodiscard]]
+        TexturePoolStats stats() const noexcept;
+
+        [[nodiscard]]
+        std::pmr::memory_resource *upstream() const noexcept {
+            return mUpstream;
+        }
+
+    private:
+        // byte size, alignment
+        using BlockKey = std::pair<size_t, size_t>;
+
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *block, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+        void trimLocked(cputex::SizeType targetByteSize) noexcept;
+
+        std::pmr::memory_resource *mUpstream;
+        std::map<BlockKey, std::vector<void *>> mFreeBlocks;
+        cputex::SizeType mByteBudget;
+        TexturePoolStats mStats;
+        mutable std::mutex mMutex;
+    };
+}
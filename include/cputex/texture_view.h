@@ -89,6 +89,16 @@ namespace cputex {
                 return (mStorage.isValid()) ? mStorage.sizeInBytes(mMip) : cputex::SizeType(0);
             }
 
+            [[nodiscard]]
+            cputex::SizeType rowPitch() const noexcept {
+                return (mStorage.isValid()) ? mStorage.rowPitch(mMip) : cputex::SizeType(0);
+            }
+
+            [[nodiscard]]
+            cputex::SizeType slicePitch() const noexcept {
+                return (mStorage.isValid()) ? mStorage.slicePitch(mMip) : cputex::SizeType(0);
+            }
+
             [[nodiscard]]
             cputex::span<const cputex::byte> getData() const noexcept {
                 return (mStorage.isValid()) ? mStorage.getMipSurfaceData(mArraySlice, mFace, mMip) : cputex::span<const cputex::byte>{};
@@ -211,6 +221,26 @@ namespace cputex {
                 return (mStorage.isValid()) ? mStorage.sizeInBytes(mip) : cputex::SizeType(0);
             }
 
+            [[nodiscard]]
+            cputex::CountType rowPitchAlignment() const noexcept {
+                return (mStorage.isValid()) ? mStorage.rowPitchAlignment() : 0u;
+            }
+
+            [[nodiscard]]
+            cputex::CountType sliceAlignment() const noexcept {
+                return (mStorage.isValid()) ? mStorage.sliceAlignment() : 0u;
+            }
+
+            [[nodiscard]]
+            cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept {
+                return (mStorage.isValid()) ? mStorage.rowPitch(mip) : cputex::SizeType(0);
+            }
+
+            [[nodiscard]]
+            cputex::SizeType slicePitch(cputex::CountType mip = 0) const noexcept {
+                return (mStorage.isValid()) ? mStorage.slicePitch(mip) : cputex::SizeType(0);
+            }
+
             [[nodiscard]]
             cputex::CountType surfaceCount() const noexcept {
                 return (mStorage.isValid()) ? mStorage.surfaceCount() : 0u;
@@ -412,8 +442,27 @@ namespace cputex {
             }
         }
 
+        // rowPitch and slicePitch are the byte distances between the starts of consecutive block rows and volume
+        // slices, e.g. the pitches a video decoder or capture API hands out with its frames, so their memory can be
+        // used without repacking it. A pitch of 0 means the rows or slices are tightly packed. A row pitch has to be at
+        // least rowByteSize() and a slice pitch has to fit all of the slice's rows. The view is left empty if either
+        // pitch is too short or data is too small for them.
+        SurfaceView(gpufmt::Format format, cputex::TextureDimension dimension, const cputex::Extent& extent, cputex::SizeType rowPitch, cputex::SizeType slicePitch, cputex::span<const cputex::byte> data) noexcept
+            : SurfaceView(format, dimension, extent, data)
+        {
+            mRowPitch = rowPitch;
+            mSlicePitch = slicePitch;
+
+            if((rowPitch != 0 && rowPitch < rowByteSize()) ||
+               (slicePitch != 0 && slicePitch < volumeSliceByteSize()) ||
+               static_cast<cputex::SizeType>(data.size()) < sizeInBytes())
+            {
+                *this = SurfaceView();
+            }
+        }
+
         SurfaceView(TextureSurfaceView surfaceView) noexcept
-            : SurfaceView(surfaceView.format(), surfaceView.dimension(), surfaceView.extent(), surfaceView.getData())
+            : SurfaceView(surfaceView.format(), surfaceView.dimension(), surfaceView.extent(), surfaceView.rowPitch(), surfaceView.slicePitch(), surfaceView.getData())
         {}
 
         constexpr SurfaceView(const SurfaceView&) noexcept = default;
@@ -422,10 +471,14 @@ namespace cputex {
             : mFormat(other.mFormat)
             , mExtent(other.mExtent)
             , mData(other.mData)
+            , mRowPitch(other.mRowPitch)
+            , mSlicePitch(other.mSlicePitch)
         {
             other.mFormat = gpufmt::Format::UNDEFINED;
             other.mExtent = { 0, 0, 0 };
             other.mData = nullptr;
+            other.mRowPitch = 0;
+            other.mSlicePitch = 0;
         }
 
         ~SurfaceView() = default;
@@ -436,10 +489,14 @@ namespace cputex {
             mFormat = other.mFormat;
             mExtent = other.mExtent;
             mData = other.mData;
+            mRowPitch = other.mRowPitch;
+            mSlicePitch = other.mSlicePitch;
 
             other.mFormat = gpufmt::Format::UNDEFINED;
             other.mExtent = { 0, 0, 0 };
             other.mData = nullptr;
+            other.mRowPitch = 0;
+            other.mSlicePitch = 0;
 
             return *this;
         }
@@ -474,18 +531,35 @@ namespace cputex {
             return mFormat;
         }
 
-        [[nodiscard]] cputex::SizeType sizeInBytes() const noexcept {
-            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
-            const auto blockExtent = extent() / formatInfo.blockExtent;
+        // Byte size of one block row, without any padding after it.
+        [[nodiscard]] cputex::SizeType rowByteSize() const noexcept {
+            return blockCount().x * gpufmt::formatInfo(mFormat).blockByteSize;
+        }
+
+        [[nodiscard]] cputex::SizeType rowPitch() const noexcept {
+            return (mRowPitch != 0) ? mRowPitch : rowByteSize();
+        }
+
+        [[nodiscard]] cputex::SizeType slicePitch() const noexcept {
+            return (mSlicePitch != 0) ? mSlicePitch : rowPitch() * blockCount().y;
+        }
 
-            return blockExtent.x * blockExtent.y * blockExtent.z * formatInfo.blockByteSize;
+        // True when the rows and volume slices follow one another without padding.
+        [[nodiscard]] bool isPacked() const noexcept {
+            const cputex::Extent blocks = blockCount();
+            return (blocks.y == 1 || rowPitch() == rowByteSize()) &&
+                (blocks.z == 1 || slicePitch() == rowByteSize() * blocks.y);
+        }
+
+        // Spans from the first byte of the surface to the last byte of its last row, so padding between rows and
+        // slices is included but padding after the last row isn't.
+        [[nodiscard]] cputex::SizeType sizeInBytes() const noexcept {
+            const cputex::Extent blocks = blockCount();
+            return slicePitch() * (blocks.z - 1) + rowPitch() * (blocks.y - 1) + rowByteSize();
         }
 
         [[nodiscard]] cputex::SizeType volumeSliceByteSize() const noexcept {
-            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
-            const auto blockExtent = extent() / formatInfo.blockExtent;
-            
-            return blockExtent.x * blockExtent.y * formatInfo.blockByteSize;
+            return rowPitch() * (blockCount().y - 1) + rowByteSize();
         }
 
         [[nodiscard]] cputex::span<const cputex::byte> getData() const noexcept {
@@ -497,6 +571,10 @@ namespace cputex {
             return cputex::span<const T>(reinterpret_cast<const T*>(mData), ((size_t)sizeInBytes()) / sizeof(T));
         }
 
+        [[nodiscard]] cputex::span<const cputex::byte> getRowData(cputex::SizeType blockRow, cputex::CountType volumeSlice = 0) const noexcept {
+            return cputex::span<const cputex::byte>(mData + slicePitch() * volumeSlice + rowPitch() * blockRow, (size_t)rowByteSize());
+        }
+
         // For 1d and 2d textures, calling with an index of 0 will be the same as calling getData().
         [[nodiscard]] cputex::SurfaceView getVolumeSlice(cputex::CountType volumeSlice) {
             const cputex::Extent surfaceExtent = extent();
@@ -505,8 +583,17 @@ namespace cputex {
             const TextureDimension viewDimension = dimension();
             cputex::Extent newExtent = surfaceExtent;
             newExtent.z = 1;
-            const cputex::SizeType sliceByteSize = volumeSliceByteSize();
-            return SurfaceView(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, getData().subspan(sliceByteSize * volumeSlice, sliceByteSize));
+            return SurfaceView(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, mRowPitch, 0, getData().subspan(slicePitch() * volumeSlice, volumeSliceByteSize()));
+        }
+
+        // A window onto part of the surface that shares its memory, e.g. one tile of an atlas, so it can be handed to
+        // any operation without copying it out first. The offset has to be block aligned, and so does the extent unless
+        // it reaches the edge of the surface. Returns an empty view if the region breaks those rules or doesn't fit.
+        [[nodiscard]] cputex::SurfaceView subregion(const cputex::Extent &offset, const cputex::Extent &regionExtent) const noexcept {
+            const cputex::SizeType byteOffset = subregionByteOffset(offset, regionExtent);
+            if(byteOffset < 0) { return {}; }
+
+            return SurfaceView(mFormat, dimension(), regionExtent, rowPitch(), slicePitch(), getData().subspan(byteOffset));
         }
 
         [[nodiscard]] constexpr bool equivalentLayout(const SurfaceView &other) const noexcept {
@@ -521,13 +608,51 @@ namespace cputex {
         using SmallExtentComponent = std::conditional_t<std::is_signed_v<cputex::ExtentComponent>, int16_t, uint16_t>;
         using SmallExtent = glm::tvec3<typename SmallExtentComponent>;
 
+        [[nodiscard]] cputex::Extent blockCount() const noexcept {
+            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
+            return (extent() + (formatInfo.blockExtent - Extent{ 1, 1, 1 })) / formatInfo.blockExtent;
+        }
+
+        // Byte offset of the region's first block from the start of the surface, or -1 when it isn't a valid
+        // subregion.
+        [[nodiscard]] cputex::SizeType subregionByteOffset(const cputex::Extent &offset, cputex::Extent regionExtent) const noexcept {
+            if(mData == nullptr) { return -1; }
+
+            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
+            const cputex::Extent surfaceExtent = extent();
+
+            regionExtent.y = std::max<cputex::ExtentComponent>(regionExtent.y, 1);
+            regionExtent.z = std::max<cputex::ExtentComponent>(regionExtent.z, 1);
+
+            for(int component = 0; component < 3; ++component) {
+                if(offset[component] < 0 || regionExtent[component] < 1 || offset[component] + regionExtent[component] > surfaceExtent[component]) {
+                    return -1;
+                }
+
+                // Blocks can't be split, except by the edge of the surface.
+                if(offset[component] % formatInfo.blockExtent[component] != 0) {
+                    return -1;
+                }
+
+                if(regionExtent[component] % formatInfo.blockExtent[component] != 0 && offset[component] + regionExtent[component] != surfaceExtent[component]) {
+                    return -1;
+                }
+            }
+
+            const cputex::Extent blockOffset = offset / formatInfo.blockExtent;
+            return slicePitch() * blockOffset.z + rowPitch() * blockOffset.y + static_cast<cputex::SizeType>(blockOffset.x) * formatInfo.blockByteSize;
+        }
+
         gpufmt::Format mFormat = gpufmt::Format::UNDEFINED;
         // In other parts of the library, extent is generally initialized to be (1, 1, 1) and each component is always
         // assumed to be at least 1. Here, extent components can have a value of 0, to help encode the intended
         // dimension of the surface. For example, it is impossible to tell if an extent of (1, 1, 1) is a 1d, 2d, or 3d
-        // surface. This deviation is to help reduce the size of the class to stay within two pointres width.
+        // surface. This deviation is to help reduce the size of the class.
         SmallExtent mExtent{ 0, 0, 0 };
         const cputex::byte* mData = nullptr;
+        // 0 when tightly packed.
+        cputex::SizeType mRowPitch = 0;
+        cputex::SizeType mSlicePitch = 0;
     };
 
     class SurfaceSpan
@@ -558,8 +683,27 @@ namespace cputex {
             }
         }
 
+        // rowPitch and slicePitch are the byte distances between the starts of consecutive block rows and volume
+        // slices, e.g. the pitches a video decoder or capture API hands out with its frames, so their memory can be
+        // used without repacking it. A pitch of 0 means the rows or slices are tightly packed. A row pitch has to be at
+        // least rowByteSize() and a slice pitch has to fit all of the slice's rows. The view is left empty if either
+        // pitch is too short or data is too small for them.
+        SurfaceSpan(gpufmt::Format format, cputex::TextureDimension dimension, const cputex::Extent& extent, cputex::SizeType rowPitch, cputex::SizeType slicePitch, cputex::span<cputex::byte> data) noexcept
+            : SurfaceSpan(format, dimension, extent, data)
+        {
+            mRowPitch = rowPitch;
+            mSlicePitch = slicePitch;
+
+            if((rowPitch != 0 && rowPitch < rowByteSize()) ||
+               (slicePitch != 0 && slicePitch < volumeSliceByteSize()) ||
+               static_cast<cputex::SizeType>(data.size()) < sizeInBytes())
+            {
+                *this = SurfaceSpan();
+            }
+        }
+
         SurfaceSpan(TextureSurfaceSpan surfaceSpan) noexcept
-            : SurfaceSpan(surfaceSpan.format(), surfaceSpan.dimension(), surfaceSpan.extent(), surfaceSpan.accessData())
+            : SurfaceSpan(surfaceSpan.format(), surfaceSpan.dimension(), surfaceSpan.extent(), surfaceSpan.rowPitch(), surfaceSpan.slicePitch(), surfaceSpan.accessData())
         {}
 
         constexpr SurfaceSpan(const SurfaceSpan&) noexcept = default;
@@ -568,10 +712,14 @@ namespace cputex {
             : mFormat(other.mFormat)
             , mExtent(other.mExtent)
             , mData(other.mData)
+            , mRowPitch(other.mRowPitch)
+            , mSlicePitch(other.mSlicePitch)
         {
             other.mFormat = gpufmt::Format::UNDEFINED;
             other.mExtent = { 0, 0, 0 };
             other.mData = nullptr;
+            other.mRowPitch = 0;
+            other.mSlicePitch = 0;
         }
 
         ~SurfaceSpan() = default;
@@ -582,10 +730,14 @@ namespace cputex {
             mFormat = other.mFormat;
             mExtent = other.mExtent;
             mData = other.mData;
+            mRowPitch = other.mRowPitch;
+            mSlicePitch = other.mSlicePitch;
 
             other.mFormat = gpufmt::Format::UNDEFINED;
             other.mExtent = { 0, 0, 0 };
             other.mData = nullptr;
+            other.mRowPitch = 0;
+            other.mSlicePitch = 0;
 
             return *this;
         }
@@ -599,7 +751,7 @@ namespace cputex {
         }
 
         [[nodiscard]] constexpr operator SurfaceView() const noexcept {
-            return SurfaceView(mFormat, dimension(), extent(), getData());
+            return SurfaceView(mFormat, dimension(), extent(), mRowPitch, mSlicePitch, getData());
         }
 
         [[nodiscard]] constexpr operator bool() const noexcept {
@@ -624,18 +776,35 @@ namespace cputex {
             return mFormat;
         }
 
-        [[nodiscard]] cputex::SizeType sizeInBytes() const noexcept {
-            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
-            const auto blockExtent = extent() / formatInfo.blockExtent;
+        // Byte size of one block row, without any padding after it.
+        [[nodiscard]] cputex::SizeType rowByteSize() const noexcept {
+            return blockCount().x * gpufmt::formatInfo(mFormat).blockByteSize;
+        }
 
-            return blockExtent.x * blockExtent.y * blockExtent.z * formatInfo.blockByteSize;
+        [[nodiscard]] cputex::SizeType rowPitch() const noexcept {
+            return (mRowPitch != 0) ? mRowPitch : rowByteSize();
         }
 
-        [[nodiscard]] cputex::SizeType volumeSliceByteSize() const noexcept {
-            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
-            const auto blockExtent = extent() / formatInfo.blockExtent;
+        [[nodiscard]] cputex::SizeType slicePitch() const noexcept {
+            return (mSlicePitch != 0) ? mSlicePitch : rowPitch() * blockCount().y;
+        }
+
+        // True when the rows and volume slices follow one another without padding.
+        [[nodiscard]] bool isPacked() const noexcept {
+            const cputex::Extent blocks = blockCount();
+            return (blocks.y == 1 || rowPitch() == rowByteSize()) &&
+                (blocks.z == 1 || slicePitch() == rowByteSize() * blocks.y);
+        }
+
+        // Spans from the first byte of the surface to the last byte of its last row, so padding between rows and
+        // slices is included but padding after the last row isn't.
+        [[nodiscard]] cputex::SizeType sizeInBytes() const noexcept {
+            const cputex::Extent blocks = blockCount();
+            return slicePitch() * (blocks.z - 1) + rowPitch() * (blocks.y - 1) + rowByteSize();
+        }
 
-            return blockExtent.x * blockExtent.y * formatInfo.blockByteSize;
+        [[nodiscard]] cputex::SizeType volumeSliceByteSize() const noexcept {
+            return rowPitch() * (blockCount().y - 1) + rowByteSize();
         }
 
         [[nodiscard]] cputex::span<const cputex::byte> getData() const noexcept {
@@ -644,7 +813,11 @@ namespace cputex {
 
         template<class T>
         [[nodiscard]] cputex::span<const T> getDataAs() const noexcept {
-            return cputex::span<const T>(reinterpret_cast<const T*>(mData), ((size_t)sizeInBytes) / sizeof(T));
+            return cputex::span<const T>(reinterpret_cast<const T*>(mData), ((size_t)sizeInBytes()) / sizeof(T));
+        }
+
+        [[nodiscard]] cputex::span<const cputex::byte> getRowData(cputex::SizeType blockRow, cputex::CountType volumeSlice = 0) const noexcept {
+            return cputex::span<const cputex::byte>(mData + slicePitch() * volumeSlice + rowPitch() * blockRow, (size_t)rowByteSize());
         }
 
         // For 1d and 2d textures, calling with an index of 0 will be the same as calling getData().
@@ -655,8 +828,7 @@ namespace cputex {
             const TextureDimension viewDimension = dimension();
             cputex::Extent newExtent = surfaceExtent;
             newExtent.z = 1;
-            const cputex::SizeType sliceByteSize = volumeSliceByteSize();
-            return SurfaceView(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, getData().subspan(sliceByteSize * volumeSlice, sliceByteSize));
+            return SurfaceView(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, mRowPitch, 0, getData().subspan(slicePitch() * volumeSlice, volumeSliceByteSize()));
         }
 
         [[nodiscard]] cputex::span<cputex::byte> accessData() noexcept {
@@ -668,6 +840,10 @@ namespace cputex {
             return cputex::span<T>(reinterpret_cast<T*>(mData), ((size_t)sizeInBytes()) / sizeof(T));
         }
 
+        [[nodiscard]] cputex::span<cputex::byte> accessRowData(cputex::SizeType blockRow, cputex::CountType volumeSlice = 0) noexcept {
+            return cputex::span<cputex::byte>(mData + slicePitch() * volumeSlice + rowPitch() * blockRow, (size_t)rowByteSize());
+        }
+
         // For 1d and 2d textures, calling with an index of 0 will be the same as calling getData().
         [[nodiscard]] SurfaceSpan accessVolumeSlice(cputex::CountType volumeSlice) noexcept {
             const cputex::Extent surfaceExtent = extent();
@@ -676,8 +852,24 @@ namespace cputex {
             const TextureDimension viewDimension = dimension();
             cputex::Extent newExtent = surfaceExtent;
             newExtent.z = 1;
-            const cputex::SizeType sliceByteSize = volumeSliceByteSize();
-            return SurfaceSpan(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, accessData().subspan(sliceByteSize * volumeSlice, sliceByteSize));
+            return SurfaceSpan(mFormat, (viewDimension == TextureDimension::Texture3D) ? TextureDimension::Texture2D : viewDimension, newExtent, mRowPitch, 0, accessData().subspan(slicePitch() * volumeSlice, volumeSliceByteSize()));
+        }
+
+        // A window onto part of the surface that shares its memory, e.g. one tile of an atlas, so it can be handed to
+        // any operation without copying it out first. The offset has to be block aligned, and so does the extent unless
+        // it reaches the edge of the surface. Returns an empty view if the region breaks those rules or doesn't fit.
+        [[nodiscard]] SurfaceView subregion(const cputex::Extent &offset, const cputex::Extent &regionExtent) const noexcept {
+            const cputex::SizeType byteOffset = subregionByteOffset(offset, regionExtent);
+            if(byteOffset < 0) { return {}; }
+
+            return SurfaceView(mFormat, dimension(), regionExtent, rowPitch(), slicePitch(), getData().subspan(byteOffset));
+        }
+
+        [[nodiscard]] SurfaceSpan subregion(const cputex::Extent &offset, const cputex::Extent &regionExtent) noexcept {
+            const cputex::SizeType byteOffset = subregionByteOffset(offset, regionExtent);
+            if(byteOffset < 0) { return {}; }
+
+            return SurfaceSpan(mFormat, dimension(), regionExtent, rowPitch(), slicePitch(), accessData().subspan(byteOffset));
         }
 
         [[nodiscard]] constexpr bool equivalentLayout(const SurfaceSpan &other) const noexcept {
@@ -692,26 +884,64 @@ namespace cputex {
         using SmallExtentComponent = std::conditional_t<std::is_signed_v<cputex::ExtentComponent>, int16_t, uint16_t>;
         using SmallExtent = glm::tvec3<typename SmallExtentComponent>;
 
+        [[nodiscard]] cputex::Extent blockCount() const noexcept {
+            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
+            return (extent() + (formatInfo.blockExtent - Extent{ 1, 1, 1 })) / formatInfo.blockExtent;
+        }
+
+        // Byte offset of the region's first block from the start of the surface, or -1 when it isn't a valid
+        // subregion.
+        [[nodiscard]] cputex::SizeType subregionByteOffset(const cputex::Extent &offset, cputex::Extent regionExtent) const noexcept {
+            if(mData == nullptr) { return -1; }
+
+            const gpufmt::FormatInfo& formatInfo = gpufmt::formatInfo(mFormat);
+            const cputex::Extent surfaceExtent = extent();
+
+            regionExtent.y = std::max<cputex::ExtentComponent>(regionExtent.y, 1);
+            regionExtent.z = std::max<cputex::ExtentComponent>(regionExtent.z, 1);
+
+            for(int component = 0; component < 3; ++component) {
+                if(offset[component] < 0 || regionExtent[component] < 1 || offset[component] + regionExtent[component] > surfaceExtent[component]) {
+                    return -1;
+                }
+
+                // Blocks can't be split, except by the edge of the surface.
+                if(offset[component] % formatInfo.blockExtent[component] != 0) {
+                    return -1;
+                }
+
+                if(regionExtent[component] % formatInfo.blockExtent[component] != 0 && offset[component] + regionExtent[component] != surfaceExtent[component]) {
+                    return -1;
+                }
+            }
+
+            const cputex::Extent blockOffset = offset / formatInfo.blockExtent;
+            return slicePitch() * blockOffset.z + rowPitch() * blockOffset.y + static_cast<cputex::SizeType>(blockOffset.x) * formatInfo.blockByteSize;
+        }
+
         gpufmt::Format mFormat = gpufmt::Format::UNDEFINED;
         // In other parts of the library, extent is generally initialized to be (1, 1, 1) and each component is always
         // assumed to be at least 1. Here, extent components can have a value of 0, to help encode the intended
         // dimension of the surface. For example, it is impossible to tell if an extent of (1, 1, 1) is a 1d, 2d, or 3d
-        // surface. This deviation is to help reduce the size of the class to stay within two pointres width.
+        // surface. This deviation is to help reduce the size of the class.
         SmallExtent mExtent{ 0, 0, 0 };
         cputex::byte* mData = nullptr;
+        // 0 when tightly packed.
+        cputex::SizeType mRowPitch = 0;
+        cputex::SizeType mSlicePitch = 0;
     };
 
-    static_assert(sizeof(SurfaceView) <= 16);
-    static_assert(sizeof(SurfaceSpan) <= 16);
+    static_assert(sizeof(SurfaceView) <= 32);
+    static_assert(sizeof(SurfaceSpan) <= 32);
 
 
     namespace internal {
         constexpr BaseTextureSurfaceSpan::operator SurfaceView() const noexcept {
-            return SurfaceView(format(), dimension(), extent(), getData());
+            return SurfaceView(format(), dimension(), extent(), rowPitch(), slicePitch(), getData());
         }
     }
 
     constexpr TextureSurfaceSpan::operator SurfaceSpan() noexcept {
-        return SurfaceSpan(format(), dimension(), extent(), accessData());
+        return SurfaceSpan(format(), dimension(), extent(), rowPitch(), slicePitch(), accessData());
     }
 }
\ No newline at end of file
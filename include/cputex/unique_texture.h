@@ -13,12 +13,18 @@ namespace cputex {
 		UniqueTexture() noexcept = default;
 		explicit UniqueTexture(const TextureParams &params);
         UniqueTexture(const TextureParams &params, gpufmt::span<const cputex::byte> initialData);
+        UniqueTexture(cputex::Uninitialized, const TextureParams &params);
+        UniqueTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter = {});
+        // Leaves the texture empty, with error saying why, if params are invalid or the data is too small or
+        // misaligned for them. The data must be aligned to surfaceByteAlignment, which is raised to a multiple of
+        // rowPitchAlignment and sliceAlignment, so the rows of adopted data keep their alignment too.
+        UniqueTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter, cputex::AdoptError &error);
 		UniqueTexture(const UniqueTexture&) = delete;
 		UniqueTexture(UniqueTexture &&other) noexcept = default;
 		~UniqueTexture() noexcept;
 
 		UniqueTexture& operator=(const UniqueTexture&) = delete;
-		UniqueTexture& operator=(UniqueTexture &&other) noexcept = default;
+		UniqueTexture& operator=(UniqueTexture &&other) noexcept;
 
         [[nodiscard]]
         bool operator==(std::nullptr_t) const noexcept;
@@ -59,12 +65,21 @@ namespace cputex {
         [[nodiscard]]
         cputex::CountType surfaceByteAlignment() const noexcept;
 
+        [[nodiscard]]
+        std::pmr::memory_resource *memoryResource() const noexcept;
+
         [[nodiscard]]
         cputex::SizeType sizeInBytes() const noexcept;
 
         [[nodiscard]]
         cputex::SizeType sizeInBytes(cputex::CountType mip) const noexcept;
 
+        [[nodiscard]]
+        cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept;
+
+        [[nodiscard]]
+        cputex::SizeType slicePitch(cputex::CountType mip = 0) const noexcept;
+
         [[nodiscard]]
         cputex::CountType surfaceCount() const noexcept;
 
@@ -114,6 +129,8 @@ namespace cputex {
 		UniqueTexture clone() const noexcept;
 
 	private:
+        friend class SharedTexture;
+
         internal::TextureStorage mTextureStorage;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,604 @@
+#include <cputex/archive.h>
+
+#include <cputex/internal/file_io.h>
+#include <cputex/texture_layout.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace cputex {
+    namespace {
+        constexpr uint32_t kTextureFileMagic = 0x58545043; // "CPTX"
+        constexpr uint32_t kTextureArchiveMagic = 0x41545043; // "CPTA"
+        constexpr uint32_t kTextureFileVersion = 1;
+
+        // Offsets are relative to the start of the texture's record, so the same record works as a file of its own and
+        // as an archive entry.
+        struct TextureFileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t format;
+            uint32_t dimension;
+            int32_t extent[3];
+            int32_t arraySize;
+            int32_t faces;
+            int32_t mips;
+            int32_t surfaceByteAlignment;
+            int32_t rowPitchAlignment;
+            int32_t sliceAlignment;
+            int32_t surfaceCount;
+            int64_t sizeInBytes;
+            int64_t mipExtentsOffset;
+            int64_t surfaceInfoOffset;
+            int64_t surfaceDataOffset;
+        };
+
+        // The same fields, in the same order, as TextureStorage's surface info table.
+        struct TextureFileSurfaceInfo {
+            int64_t offset;
+            int64_t sizeInBytes;
+            int64_t rowPitch;
+            int64_t slicePitch;
+        };
+
+        struct TextureArchiveHeader {
+            uint32_t magic;
+            uint32_t version;
+            int64_t entryCount;
+            int64_t indexOffset;
+            int64_t namesOffset;
+        };
+
+        struct TextureArchiveIndexEntry {
+            // Relative to namesOffset.
+            int64_t nameOffset;
+            int64_t nameLength;
+            int64_t recordOffset;
+        };
+
+        static_assert(sizeof(TextureFileHeader) == 88);
+        static_assert(sizeof(TextureFileSurfaceInfo) == 32);
+        static_assert(sizeof(TextureArchiveHeader) == 32);
+        static_assert(sizeof(TextureArchiveIndexEntry) == 24);
+
+        // Where everything of one texture record goes, relative to the start of the record.
+        struct TextureRecordLayout {
+            TextureLayout layout;
+            cputex::SizeType mipExtentsOffset = 0;
+            cputex::SizeType surfaceInfoOffset = 0;
+            cputex::SizeType surfaceDataOffset = 0;
+            cputex::SizeType byteSize = 0;
+        };
+    }
+
+    [[nodiscard]]
+    static constexpr cputex::SizeType alignUp(cputex::SizeType value, cputex::SizeType alignment) noexcept {
+        return ((value + (alignment - 1)) / alignment) * alignment;
+    }
+
+    [[nodiscard]]
+    static TextureParams textureParams(const TextureView &texture) noexcept {
+        TextureParams params;
+        params.format = texture.format();
+        params.dimension = texture.dimension();
+        params.extent = texture.extent();
+        params.arraySize = texture.arraySize();
+        params.faces = texture.faces();
+        params.mips = texture.mips();
+        params.surfaceByteAlignment = texture.surfaceByteAlignment();
+        params.rowPitchAlignment = texture.rowPitchAlignment();
+        params.sliceAlignment = texture.sliceAlignment();
+        return params;
+    }
+
+    [[nodiscard]]
+    static TextureRecordLayout recordLayout(const TextureLayout &layout, cputex::SizeType dataAlignment) noexcept {
+        TextureRecordLayout recordLayout;
+        recordLayout.layout = layout;
+        recordLayout.mipExtentsOffset = sizeof(TextureFileHeader);
+        recordLayout.surfaceInfoOffset = alignUp(recordLayout.mipExtentsOffset + static_cast<cputex::SizeType>(sizeof(int32_t) * 3) * layout.params.mips,
+                                                 alignof(TextureFileSurfaceInfo));
+        recordLayout.surfaceDataOffset = alignUp(recordLayout.surfaceInfoOffset + static_cast<cputex::SizeType>(sizeof(TextureFileSurfaceInfo)) * layout.surfaceCount(),
+                                                 std::lcm(dataAlignment, static_cast<cputex::SizeType>(layout.params.surfaceByteAlignment)));
+        recordLayout.byteSize = recordLayout.surfaceDataOffset + layout.sizeInBytes;
+        return recordLayout;
+    }
+
+    [[nodiscard]]
+    static TextureFileSurfaceInfo surfaceInfo(const TextureLayout &layout, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) noexcept {
+        return TextureFileSurfaceInfo{ layout.surfaceOffset(arraySlice, face, mip), layout.mipByteSizes[mip], layout.mipRowPitches[mip], layout.mipSlicePitches[mip] };
+    }
+
+    // The header and tables of a record, everything up to the surface data.
+    [[nodiscard]]
+    static std::vector<cputex::byte> recordTables(const TextureRecordLayout &recordLayout) {
+        const TextureLayout &layout = recordLayout.layout;
+        const TextureParams &params = layout.params;
+
+        TextureFileHeader header{};
+        header.magic = kTextureFileMagic;
+        header.version = kTextureFileVersion;
+        header.format = static_cast<uint32_t>(params.format);
+        header.dimension = static_cast<uint32_t>(params.dimension);
+        header.extent[0] = params.extent.x;
+        header.extent[1] = params.extent.y;
+        header.extent[2] = params.extent.z;
+        header.arraySize = params.arraySize;
+        header.faces = params.faces;
+        header.mips = params.mips;
+        header.surfaceByteAlignment = params.surfaceByteAlignment;
+        header.rowPitchAlignment = params.rowPitchAlignment;
+        header.sliceAlignment = params.sliceAlignment;
+        header.surfaceCount = layout.surfaceCount();
+        header.sizeInBytes = layout.sizeInBytes;
+        header.mipExtentsOffset = recordLayout.mipExtentsOffset;
+        header.surfaceInfoOffset = recordLayout.surfaceInfoOffset;
+        header.surfaceDataOffset = recordLayout.surfaceDataOffset;
+
+        std::vector<cputex::byte> tables(static_cast<size_t>(recordLayout.surfaceDataOffset), cputex::byte{ 0 });
+        std::memcpy(tables.data(), &header, sizeof(header));
+
+        for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+            const int32_t mipExtent[3] = { layout.mipExtents[mip].x, layout.mipExtents[mip].y, layout.mipExtents[mip].z };
+            std::memcpy(tables.data() + recordLayout.mipExtentsOffset + mip * sizeof(mipExtent), mipExtent, sizeof(mipExtent));
+        }
+
+        cputex::byte *surfaceInfos = tables.data() + recordLayout.surfaceInfoOffset;
+
+        for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
+            for(cputex::CountType face = 0; face < params.faces; ++face) {
+                for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                    const TextureFileSurfaceInfo info = surfaceInfo(layout, arraySlice, face, mip);
+                    std::memcpy(surfaceInfos, &info, sizeof(info));
+                    surfaceInfos += sizeof(info);
+                }
+            }
+        }
+
+        return tables;
+    }
+
+    [[nodiscard]]
+    static bool writePadding(int fileDescriptor, cputex::SizeType byteSize) noexcept {
+        static constexpr std::array<cputex::byte, kTextureFilePageSize> zeros{};
+
+        while(byteSize > 0) {
+            const cputex::SizeType chunkByteSize = std::min(byteSize, kTextureFilePageSize);
+
+            if(!internal::writeFile(fileDescriptor, cputex::span<const cputex::byte>(zeros.data(), static_cast<size_t>(chunkByteSize)))) {
+                return false;
+            }
+
+            byteSize -= chunkByteSize;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    static bool writeRecord(int fileDescriptor, const TextureRecordLayout &recordLayout, const TextureView &texture) {
+        return internal::writeFile(fileDescriptor, recordTables(recordLayout)) &&
+               internal::writeFile(fileDescriptor, texture.getData().first(static_cast<size_t>(recordLayout.layout.sizeInBytes)));
+    }
+
+    // Checks a record against the layout its params produce, and finds where in the file its surface data starts. Any mismatch means the file
+    // was written by a different version or is damaged, since the tables are never anything but the computed layout.
+    [[nodiscard]]
+    static ArchiveError readRecord(cputex::span<const cputex::byte> file, cputex::SizeType recordOffset, TextureParams &params, cputex::SizeType &surfaceDataOffset) noexcept {
+        const auto fileByteSize = static_cast<cputex::SizeType>(file.size_bytes());
+
+        if(recordOffset < 0 || recordOffset > fileByteSize || fileByteSize - recordOffset < static_cast<cputex::SizeType>(sizeof(TextureFileHeader))) {
+            return ArchiveError::FileTooSmall;
+        }
+
+        const cputex::span<const cputex::byte> record = file.subspan(static_cast<size_t>(recordOffset));
+
+        TextureFileHeader header;
+        std::memcpy(&header, record.data(), sizeof(header));
+
+        if(header.magic != kTextureFileMagic) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        if(header.version != kTextureFileVersion) {
+            return ArchiveError::UnsupportedVersion;
+        }
+
+        params = TextureParams{};
+        params.format = static_cast<gpufmt::Format>(header.format);
+        params.dimension = static_cast<TextureDimension>(header.dimension);
+        params.extent = Extent{ header.extent[0], header.extent[1], header.extent[2] };
+        params.arraySize = header.arraySize;
+        params.faces = header.faces;
+        params.mips = header.mips;
+        params.surfaceByteAlignment = header.surfaceByteAlignment;
+        params.rowPitchAlignment = header.rowPitchAlignment;
+        params.sliceAlignment = header.sliceAlignment;
+
+        if(header.format >= static_cast<uint32_t>(gpufmt::Format::COUNT) || header.dimension > static_cast<uint32_t>(TextureDimension::TextureCube)) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        if(header.extent[0] <= 0 || header.extent[0] > maxExtentComponent ||
+           header.extent[1] < 0 || header.extent[1] > maxExtentComponent ||
+           header.extent[2] < 0 || header.extent[2] > maxExtentComponent ||
+           header.mips <= 0 || header.mips > maxMipCount ||
+           header.arraySize <= 0 || header.faces <= 0 || header.faces > 6) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        // computeLayout raises the surface alignment to a multiple of the others, which has to fit in a CountType.
+        if(header.surfaceByteAlignment <= 0 || header.rowPitchAlignment <= 0 || header.sliceAlignment <= 0) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        const int64_t pitchAlignment = std::lcm<int64_t>(header.rowPitchAlignment, header.sliceAlignment);
+
+        if(pitchAlignment > std::numeric_limits<cputex::CountType>::max() ||
+           std::lcm<int64_t>(pitchAlignment, header.surfaceByteAlignment) > std::numeric_limits<cputex::CountType>::max()) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        // Every surface has an entry in the record's tables, so the file bounds the surface count before it's used.
+        const int64_t surfaceCount = int64_t(header.arraySize) * header.faces * header.mips;
+
+        if(surfaceCount > (fileByteSize - recordOffset) / static_cast<int64_t>(sizeof(TextureFileSurfaceInfo))) {
+            return ArchiveError::FileTooSmall;
+        }
+
+        const TextureLayout layout = cputex::computeLayout(params);
+
+        if(!layout.isValid() ||
+           layout.params.mips != params.mips ||
+           layout.params.surfaceByteAlignment != params.surfaceByteAlignment ||
+           layout.params.rowPitchAlignment != params.rowPitchAlignment ||
+           layout.params.sliceAlignment != params.sliceAlignment ||
+           header.surfaceCount != layout.surfaceCount() ||
+           header.sizeInBytes != layout.sizeInBytes) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        const TextureRecordLayout expectedLayout = recordLayout(layout, 1);
+
+        if(header.mipExtentsOffset != expectedLayout.mipExtentsOffset ||
+           header.surfaceInfoOffset != expectedLayout.surfaceInfoOffset ||
+           header.surfaceDataOffset < expectedLayout.surfaceDataOffset) {
+            return ArchiveError::InvalidHeader;
+        }
+
+        if(static_cast<cputex::SizeType>(record.size_bytes()) - header.surfaceDataOffset < header.sizeInBytes) {
+            return ArchiveError::FileTooSmall;
+        }
+
+        for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+            int32_t mipExtent[3];
+            std::memcpy(mipExtent, record.data() + header.mipExtentsOffset + mip * sizeof(mipExtent), sizeof(mipExtent));
+
+            if(Extent{ mipExtent[0], mipExtent[1], mipExtent[2] } != layout.mipExtents[mip]) {
+                return ArchiveError::InvalidHeader;
+            }
+        }
+
+        const cputex::byte *surfaceInfos = record.data() + header.surfaceInfoOffset;
+
+        for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
+            for(cputex::CountType face = 0; face < params.faces; ++face) {
+                for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                    const TextureFileSurfaceInfo expectedInfo = surfaceInfo(layout, arraySlice, face, mip);
+
+                    if(std::memcmp(surfaceInfos, &expectedInfo, sizeof(expectedInfo)) != 0) {
+                        return ArchiveError::InvalidHeader;
+                    }
+
+                    surfaceInfos += sizeof(expectedInfo);
+                }
+            }
+        }
+
+        surfaceDataOffset = recordOffset + header.surfaceDataOffset;
+        return ArchiveError::None;
+    }
+
+    ArchiveError writeTextureFile(TextureView texture, const std::filesystem::path &path) {
+        if(texture.empty()) {
+            return ArchiveError::EmptyTexture;
+        }
+
+        const TextureRecordLayout layout = recordLayout(cputex::computeLayout(textureParams(texture)), kTextureFilePageSize);
+        const int fileDescriptor = internal::createFile(path);
+
+        if(fileDescriptor < 0) {
+            return ArchiveError::FileOpenFailed;
+        }
+
+        const bool written = writeRecord(fileDescriptor, layout, texture);
+
+        // Write errors can be deferred until the file is closed.
+        return (internal::closeFile(fileDescriptor) && written) ? ArchiveError::None : ArchiveError::FileWriteFailed;
+    }
+
+    template<class TextureT>
+    [[nodiscard]]
+    static TextureT mapTextureFile(const std::filesystem::path &path, ArchiveError &error) {
+        const cputex::span<cputex::byte> mapping = internal::mapFile(path);
+
+        if(mapping.empty()) {
+            error = (std::filesystem::exists(path)) ? ArchiveError::FileMapFailed : ArchiveError::FileOpenFailed;
+            return {};
+        }
+
+        TextureParams params;
+        cputex::SizeType surfaceDataOffset = 0;
+        error = readRecord(mapping, 0, params, surfaceDataOffset);
+
+        if(error != ArchiveError::None) {
+            internal::unmapFile(mapping);
+            return {};
+        }
+
+        TextureT texture{ cputex::adoptMemory, params, mapping.subspan(static_cast<size_t>(surfaceDataOffset)), [mapping](cputex::span<cputex::byte>) { internal::unmapFile(mapping); } };
+
+        if(texture.empty()) {
+            internal::unmapFile(mapping);
+            error = ArchiveError::TextureCreationFailed;
+        }
+
+        return texture;
+    }
+
+    UniqueTexture readTextureFile(cputex::span<const cputex::byte> fileData, ArchiveError &error) {
+        TextureParams params;
+        cputex::SizeType surfaceDataOffset = 0;
+        error = readRecord(fileData, 0, params, surfaceDataOffset);
+
+        if(error != ArchiveError::None) {
+            return {};
+        }
+
+        UniqueTexture texture{ params, fileData.subspan(static_cast<size_t>(surfaceDataOffset)) };
+
+        if(texture.empty()) {
+            error = ArchiveError::TextureCreationFailed;
+        }
+
+        return texture;
+    }
+
+    UniqueTexture readTextureFile(const std::filesystem::path &path, ArchiveError &error) {
+        return mapTextureFile<UniqueTexture>(path, error);
+    }
+
+    SharedTexture readSharedTextureFile(const std::filesystem::path &path, ArchiveError &error) {
+        return mapTextureFile<SharedTexture>(path, error);
+    }
+
+    ArchiveError writeTextureArchive(cputex::span<const TextureArchiveEntry> entries, const std::filesystem::path &path) {
+        std::vector<const TextureArchiveEntry *> sortedEntries;
+        sortedEntries.reserve(entries.size());
+
+        for(const TextureArchiveEntry &entry : entries) {
+            if(entry.texture.empty()) {
+                return ArchiveError::EmptyTexture;
+            }
+
+            sortedEntries.push_back(&entry);
+        }
+
+        std::sort(sortedEntries.begin(), sortedEntries.end(), [](const TextureArchiveEntry *left, const TextureArchiveEntry *right) { return left->name < right->name; });
+
+        if(std::adjacent_find(sortedEntries.begin(), sortedEntries.end(), [](const TextureArchiveEntry *left, const TextureArchiveEntry *right) { return left->name == right->name; }) != sortedEntries.end()) {
+            return ArchiveError::DuplicateName;
+        }
+
+        TextureArchiveHeader header{};
+        header.magic = kTextureArchiveMagic;
+        header.version = kTextureFileVersion;
+        header.entryCount = static_cast<int64_t>(sortedEntries.size());
+        header.indexOffset = sizeof(TextureArchiveHeader);
+        header.namesOffset = header.indexOffset + header.entryCount * static_cast<int64_t>(sizeof(TextureArchiveIndexEntry));
+
+        std::vector<TextureArchiveIndexEntry> index(sortedEntries.size());
+        std::vector<TextureRecordLayout> recordLayouts(sortedEntries.size());
+        cputex::SizeType namesByteSize = 0;
+
+        for(size_t i = 0; i < sortedEntries.size(); ++i) {
+            index[i].nameOffset = namesByteSize;
+            index[i].nameLength = static_cast<int64_t>(sortedEntries[i]->name.size());
+            namesByteSize += index[i].nameLength;
+        }
+
+        cputex::SizeType recordOffset = header.namesOffset + namesByteSize;
+
+        for(size_t i = 0; i < sortedEntries.size(); ++i) {
+            recordLayouts[i] = recordLayout(cputex::computeLayout(textureParams(sortedEntries[i]->texture)), kTextureArchiveDataAlignment);
+
+            // Surface data offsets are aligned relative to the record, so the record itself starts aligned too.
+            recordOffset = alignUp(recordOffset, std::lcm(kTextureArchiveDataAlignment, static_cast<cputex::SizeType>(recordLayouts[i].layout.params.surfaceByteAlignment)));
+            index[i].recordOffset = recordOffset;
+            recordOffset += recordLayouts[i].byteSize;
+        }
+
+        const int fileDescriptor = internal::createFile(path);
+
+        if(fileDescriptor < 0) {
+            return ArchiveError::FileOpenFailed;
+        }
+
+        bool written = internal::writeFile(fileDescriptor, cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte *>(&header), sizeof(header))) &&
+                       internal::writeFile(fileDescriptor, cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte *>(index.data()), index.size() * sizeof(TextureArchiveIndexEntry)));
+
+        for(size_t i = 0; written && i < sortedEntries.size(); ++i) {
+            written = internal::writeFile(fileDescriptor, cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte *>(sortedEntries[i]->name.data()), sortedEntries[i]->name.size()));
+        }
+
+        cputex::SizeType writtenByteSize = header.namesOffset + namesByteSize;
+
+        for(size_t i = 0; written && i < sortedEntries.size(); ++i) {
+            written = writePadding(fileDescriptor, index[i].recordOffset - writtenByteSize) &&
+                      writeRecord(fileDescriptor, recordLayouts[i], sortedEntries[i]->texture);
+            writtenByteSize = index[i].recordOffset + recordLayouts[i].byteSize;
+        }
+
+        // Write errors can be deferred until the file is closed.
+        return (internal::closeFile(fileDescriptor) && written) ? ArchiveError::None : ArchiveError::FileWriteFailed;
+    }
+
+    struct TextureArchive::Mapping {
+        explicit Mapping(cputex::span<cputex::byte> data_) noexcept
+            : data(data_)
+        {}
+
+        Mapping(const Mapping &) = delete;
+
+        ~Mapping() {
+            internal::unmapFile(data);
+        }
+
+        Mapping &operator=(const Mapping &) = delete;
+
+        [[nodiscard]]
+        TextureArchiveIndexEntry indexEntry(cputex::SizeType index) const noexcept {
+            TextureArchiveIndexEntry entry;
+            std::memcpy(&entry, data.data() + header.indexOffset + index * static_cast<cputex::SizeType>(sizeof(TextureArchiveIndexEntry)), sizeof(entry));
+            return entry;
+        }
+
+        [[nodiscard]]
+        std::string_view name(const TextureArchiveIndexEntry &entry) const noexcept {
+            return std::string_view(reinterpret_cast<const char *>(data.data() + header.namesOffset + entry.nameOffset), static_cast<size_t>(entry.nameLength));
+        }
+
+        cputex::span<cputex::byte> data;
+        TextureArchiveHeader header{};
+    };
+
+    TextureArchive TextureArchive::open(const std::filesystem::path &path, ArchiveError &error) {
+        const cputex::span<cputex::byte> data = internal::mapFile(path);
+
+        if(data.empty()) {
+            error = (std::filesystem::exists(path)) ? ArchiveError::FileMapFailed : ArchiveError::FileOpenFailed;
+            return {};
+        }
+
+        auto mapping = std::make_shared<Mapping>(data);
+        const auto fileByteSize = static_cast<cputex::SizeType>(data.size_bytes());
+
+        if(fileByteSize < static_cast<cputex::SizeType>(sizeof(TextureArchiveHeader))) {
+            error = ArchiveError::FileTooSmall;
+            return {};
+        }
+
+        TextureArchiveHeader &header = mapping->header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if(header.magic != kTextureArchiveMagic) {
+            error = ArchiveError::InvalidHeader;
+            return {};
+        }
+
+        if(header.version != kTextureFileVersion) {
+            error = ArchiveError::UnsupportedVersion;
+            return {};
+        }
+
+        if(header.entryCount < 0 || header.indexOffset != static_cast<int64_t>(sizeof(TextureArchiveHeader)) ||
+           header.entryCount > (fileByteSize - header.indexOffset) / static_cast<int64_t>(sizeof(TextureArchiveIndexEntry)) ||
+           header.namesOffset != header.indexOffset + header.entryCount * static_cast<int64_t>(sizeof(TextureArchiveIndexEntry))) {
+            error = ArchiveError::InvalidHeader;
+            return {};
+        }
+
+        // Checked once here, so lookups can trust the names. Records are only checked when they are found.
+        for(cputex::SizeType i = 0; i < header.entryCount; ++i) {
+            const TextureArchiveIndexEntry entry = mapping->indexEntry(i);
+
+            if(entry.nameOffset < 0 || entry.nameLength < 0 ||
+               entry.nameOffset > fileByteSize - header.namesOffset ||
+               entry.nameLength > fileByteSize - header.namesOffset - entry.nameOffset) {
+                error = ArchiveError::InvalidHeader;
+                return {};
+            }
+        }
+
+        TextureArchive archive;
+        archive.mMapping = std::move(mapping);
+        error = ArchiveError::None;
+        return archive;
+    }
+
+    cputex::SizeType TextureArchive::size() const noexcept {
+        return (mMapping != nullptr) ? mMapping->header.entryCount : 0;
+    }
+
+    std::string_view TextureArchive::name(cputex::SizeType index) const noexcept {
+        if(index < 0 || index >= size()) {
+            return {};
+        }
+
+        return mMapping->name(mMapping->indexEntry(index));
+    }
+
+    cputex::SizeType TextureArchive::lowerBound(std::string_view name) const noexcept {
+        cputex::SizeType first = 0;
+        cputex::SizeType count = size();
+
+        while(count > 0) {
+            const cputex::SizeType step = count / 2;
+
+            if(this->name(first + step) < name) {
+                first += step + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+    bool TextureArchive::contains(std::string_view name) const noexcept {
+        const cputex::SizeType index = lowerBound(name);
+        return index < size() && this->name(index) == name;
+    }
+
+    SharedTexture TextureArchive::find(std::string_view name) const {
+        ArchiveError error;
+        return find(name, error);
+    }
+
+    SharedTexture TextureArchive::find(std::string_view name, ArchiveError &error) const {
+        const cputex::SizeType index = lowerBound(name);
+
+        if(index >= size() || this->name(index) != name) {
+            error = ArchiveError::NotFound;
+            return {};
+        }
+
+        TextureParams params;
+        cputex::SizeType surfaceDataOffset = 0;
+        error = readRecord(mMapping->data, mMapping->indexEntry(index).recordOffset, params, surfaceDataOffset);
+
+        if(error != ArchiveError::None) {
+            return {};
+        }
+
+        // The texture keeps the whole mapping alive rather than unmapping its own part.
+        SharedTexture texture{ cputex::adoptMemory, params, mMapping->data.subspan(static_cast<size_t>(surfaceDataOffset)), [mapping = mMapping](cputex::span<cputex::byte>) {} };
+
+        if(texture.empty()) {
+            error = ArchiveError::TextureCreationFailed;
+            return texture;
+        }
+
+        // Every texture found for the entry adopts the same mapped bytes, so each copies the surfaces it writes, like a
+        // snapshot, rather than write where the others read.
+        texture.mTextureStorage.getHeader()->borrowsData = true;
+
+        return texture;
+    }
+}
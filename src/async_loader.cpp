@@ -0,0 +1,482 @@
+#include <cputex/async_loader.h>
+
+#include <cputex/archive.h>
+#include <cputex/converter.h>
+#include <cputex/dds.h>
+#include <cputex/internal/file_io.h>
+#include <cputex/ktx2.h>
+#include <cputex/texture_operations.h>
+
+#include <gpufmt/info.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <queue>
+
+namespace cputex {
+    struct AsyncLoader::Job {
+        LoadRequest request;
+        std::promise<LoadResult> promise;
+        LoadCallback callback;
+        uint64_t sequence = 0;
+
+        // The file read by the I/O stage, and the bytes of it counted against the in flight budget.
+        std::vector<cputex::byte> fileData;
+        cputex::SizeType reservedBytes = 0;
+    };
+
+    struct AsyncLoader::JobQueue {
+        // std::priority_queue puts the greatest element on top, so a job is "less" when it should run later: lower
+        // priority, or the same priority but made later.
+        struct JobOrder {
+            [[nodiscard]]
+            bool operator()(const std::unique_ptr<Job> &left, const std::unique_ptr<Job> &right) const noexcept {
+                if(left->request.priority != right->request.priority) {
+                    return left->request.priority < right->request.priority;
+                }
+
+                return left->sequence > right->sequence;
+            }
+        };
+
+        std::priority_queue<std::unique_ptr<Job>, std::vector<std::unique_ptr<Job>>, JobOrder> jobs;
+
+        [[nodiscard]]
+        std::unique_ptr<Job> pop() {
+            // top() is const, but the job is popped straight away, so moving it out doesn't break the heap.
+            std::unique_ptr<Job> job = std::move(const_cast<std::unique_ptr<Job> &>(jobs.top()));
+            jobs.pop();
+            return job;
+        }
+    };
+
+    namespace {
+        enum class ContainerType {
+            Unknown,
+            Dds,
+            Ktx2,
+            TextureFile,
+        };
+    }
+
+    [[nodiscard]]
+    static ContainerType containerType(cputex::span<const cputex::byte> fileData) noexcept {
+        static constexpr std::array<uint8_t, 4> kDdsMagic = { 'D', 'D', 'S', ' ' };
+        static constexpr std::array<uint8_t, 12> kKtx2Identifier = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+        static constexpr std::array<uint8_t, 4> kTextureFileMagic = { 'C', 'P', 'T', 'X' };
+
+        const auto startsWith = [fileData](const auto &magic) {
+            return fileData.size_bytes() >= magic.size() && std::memcmp(fileData.data(), magic.data(), magic.size()) == 0;
+        };
+
+        if(startsWith(kDdsMagic)) {
+            return ContainerType::Dds;
+        }
+
+        if(startsWith(kKtx2Identifier)) {
+            return ContainerType::Ktx2;
+        }
+
+        if(startsWith(kTextureFileMagic)) {
+            return ContainerType::TextureFile;
+        }
+
+        return ContainerType::Unknown;
+    }
+
+    [[nodiscard]]
+    static TextureParams textureParams(const TextureView &texture, gpufmt::Format format) noexcept {
+        TextureParams params;
+        params.format = format;
+        params.dimension = texture.dimension();
+        params.extent = texture.extent();
+        params.arraySize = texture.arraySize();
+        params.faces = texture.faces();
+        params.mips = texture.mips();
+        params.surfaceByteAlignment = texture.surfaceByteAlignment();
+        params.rowPitchAlignment = texture.rowPitchAlignment();
+        params.sliceAlignment = texture.sliceAlignment();
+        return params;
+    }
+
+    // A null policy parses on the calling thread.
+    [[nodiscard]]
+    static UniqueTexture parseTexture(const cputex::execution::ParallelPolicy *policy, cputex::span<const cputex::byte> fileData, LoadError &error) {
+        UniqueTexture texture;
+
+        switch(containerType(fileData)) {
+        case ContainerType::Dds:
+        {
+            DdsError ddsError;
+            texture = readDds(fileData, ddsError);
+            error = (ddsError == DdsError::None) ? LoadError::None : LoadError::InvalidFile;
+            break;
+        }
+        case ContainerType::Ktx2:
+        {
+            Ktx2Error ktx2Error;
+            texture = (policy != nullptr) ? readKtx2(*policy, fileData, ktx2Error) : readKtx2(fileData, ktx2Error);
+            error = (ktx2Error == Ktx2Error::None) ? LoadError::None : LoadError::InvalidFile;
+            break;
+        }
+        case ContainerType::TextureFile:
+        {
+            ArchiveError archiveError;
+            texture = readTextureFile(fileData, archiveError);
+            error = (archiveError == ArchiveError::None) ? LoadError::None : LoadError::InvalidFile;
+            break;
+        }
+        default:
+            error = LoadError::UnsupportedContainer;
+            break;
+        }
+
+        return texture;
+    }
+
+    [[nodiscard]]
+    static LoadResult decodeTexture(const cputex::execution::ParallelPolicy *policy, const LoadRequest &request, cputex::span<const cputex::byte> fileData) {
+        LoadResult result;
+        UniqueTexture texture = parseTexture(policy, fileData, result.error);
+
+        if(result.error != LoadError::None) {
+            return result;
+        }
+
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(texture.format());
+
+        if(request.decompress && info.decompressible) {
+            UniqueTexture decompressed{ cputex::uninitialized, textureParams(texture, info.decompressedFormat) };
+
+            const bool decompressedTexture = (policy != nullptr) ? decompressTextureTo(*policy, texture, cputex::TextureSpan(decompressed))
+                                                                 : decompressTextureTo(texture, cputex::TextureSpan(decompressed));
+
+            if(decompressed.empty() || !decompressedTexture) {
+                result.error = LoadError::DecompressionFailed;
+                return result;
+            }
+
+            texture = std::move(decompressed);
+        }
+
+        if(request.convertTo != gpufmt::Format::UNDEFINED && request.convertTo != texture.format()) {
+            UniqueTexture converted{ cputex::uninitialized, textureParams(texture, request.convertTo) };
+            const Converter converter{ texture.format(), request.convertTo };
+
+            const ConvertError convertError = (policy != nullptr) ? converter.convertTo(*policy, texture, cputex::TextureSpan(converted))
+                                                                  : converter.convertTo(texture, cputex::TextureSpan(converted));
+
+            if(converted.empty() || convertError != ConvertError::None) {
+                result.error = LoadError::ConversionFailed;
+                return result;
+            }
+
+            texture = std::move(converted);
+        }
+
+        result.texture = SharedTexture{ std::move(texture) };
+        return result;
+    }
+
+    // Returns the bytes read, or an empty vector with error set.
+    [[nodiscard]]
+    static std::vector<cputex::byte> readRequestFile(int fileDescriptor, const LoadRequest &request, cputex::SizeType byteLength, LoadError &error) {
+        std::vector<cputex::byte> fileData(static_cast<size_t>(byteLength));
+        const cputex::SizeType bytesRead = internal::readFileAt(fileDescriptor, request.byteOffset, fileData);
+
+        if(bytesRead < 0) {
+            error = LoadError::FileReadFailed;
+            return {};
+        }
+
+        // A short read leaves a truncated file for the parser to reject.
+        fileData.resize(static_cast<size_t>(bytesRead));
+        error = LoadError::None;
+        return fileData;
+    }
+
+    AsyncLoader::AsyncLoader()
+        : AsyncLoader(AsyncLoaderOptions{})
+    {}
+
+    AsyncLoader::AsyncLoader(const AsyncLoaderOptions &options)
+        : mReadQueue(std::make_unique<JobQueue>())
+        , mDecodeQueue(std::make_unique<JobQueue>())
+        , mExecutor(options.executor)
+        , mMaxInFlightBytes(std::max<cputex::SizeType>(options.maxInFlightBytes, 1))
+    {
+        const cputex::SizeType ioThreadCount = std::max<cputex::SizeType>(options.ioThreadCount, 1);
+        const cputex::SizeType decodeThreadCount = (options.decodeThreadCount > 0)
+            ? options.decodeThreadCount
+            : std::max<cputex::SizeType>(static_cast<cputex::SizeType>(std::thread::hardware_concurrency()) - 1, 1);
+
+        mIoThreads.reserve(static_cast<size_t>(ioThreadCount));
+        mDecodeThreads.reserve(static_cast<size_t>(decodeThreadCount));
+
+        for(cputex::SizeType i = 0; i < ioThreadCount; ++i) {
+            mIoThreads.emplace_back([this]() { ioThreadMain(); });
+        }
+
+        for(cputex::SizeType i = 0; i < decodeThreadCount; ++i) {
+            mDecodeThreads.emplace_back([this]() { decodeThreadMain(); });
+        }
+    }
+
+    AsyncLoader::~AsyncLoader() {
+        std::vector<std::unique_ptr<Job>> cancelledJobs;
+
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+
+            while(!mReadQueue->jobs.empty()) {
+                cancelledJobs.push_back(mReadQueue->pop());
+            }
+
+            while(!mDecodeQueue->jobs.empty()) {
+                std::unique_ptr<Job> job = mDecodeQueue->pop();
+                mInFlightBytes -= job->reservedBytes;
+                cancelledJobs.push_back(std::move(job));
+            }
+        }
+
+        mReadAvailable.notify_all();
+        mDecodeAvailable.notify_all();
+        mBudgetAvailable.notify_all();
+
+        for(std::unique_ptr<Job> &job : cancelledJobs) {
+            complete(std::move(job), LoadResult{ {}, LoadError::Cancelled });
+        }
+
+        // The I/O threads cancel whatever they read from here on, so the decode threads can't be handed more work once
+        // they are gone.
+        for(std::thread &thread : mIoThreads) {
+            thread.join();
+        }
+
+        for(std::thread &thread : mDecodeThreads) {
+            thread.join();
+        }
+    }
+
+    std::future<LoadResult> AsyncLoader::load(LoadRequest request) {
+        auto job = std::make_unique<Job>();
+        job->request = std::move(request);
+        std::future<LoadResult> future = job->promise.get_future();
+
+        enqueue(std::move(job));
+        return future;
+    }
+
+    void AsyncLoader::load(LoadRequest request, LoadCallback callback) {
+        auto job = std::make_unique<Job>();
+        job->request = std::move(request);
+        job->callback = std::move(callback);
+
+        enqueue(std::move(job));
+    }
+
+    std::vector<std::future<LoadResult>> AsyncLoader::load(cputex::span<const LoadRequest> requests) {
+        std::vector<std::future<LoadResult>> futures;
+        futures.reserve(requests.size());
+
+        for(const LoadRequest &request : requests) {
+            futures.push_back(load(request));
+        }
+
+        return futures;
+    }
+
+    void AsyncLoader::load(cputex::span<const LoadRequest> requests, const LoadCallback &callback) {
+        for(const LoadRequest &request : requests) {
+            load(request, callback);
+        }
+    }
+
+    void AsyncLoader::waitIdle() {
+        std::unique_lock lock(mMutex);
+        mIdle.wait(lock, [this]() { return mPendingCount == 0; });
+    }
+
+    void AsyncLoader::enqueue(std::unique_ptr<Job> job) {
+        // Requests with their data already in memory skip the I/O stage.
+        const bool needsRead = job->request.data.empty();
+
+        {
+            std::lock_guard lock(mMutex);
+            job->sequence = mNextSequence++;
+            ++mPendingCount;
+
+            if(needsRead) {
+                mReadQueue->jobs.push(std::move(job));
+            } else {
+                mDecodeQueue->jobs.push(std::move(job));
+            }
+        }
+
+        if(needsRead) {
+            mReadAvailable.notify_one();
+        } else {
+            mDecodeAvailable.notify_one();
+        }
+    }
+
+    void AsyncLoader::ioThreadMain() noexcept {
+        while(true) {
+            std::unique_ptr<Job> job;
+
+            {
+                std::unique_lock lock(mMutex);
+                mReadAvailable.wait(lock, [this]() { return mStopping || !mReadQueue->jobs.empty(); });
+
+                if(mStopping) {
+                    return;
+                }
+
+                job = mReadQueue->pop();
+            }
+
+            const LoadRequest &request = job->request;
+            const int fileDescriptor = internal::openFile(request.path);
+
+            if(fileDescriptor < 0) {
+                complete(std::move(job), LoadResult{ {}, LoadError::FileOpenFailed });
+                continue;
+            }
+
+            cputex::SizeType byteLength = request.byteLength;
+
+            if(byteLength < 0) {
+                const cputex::SizeType fileSize = internal::fileSize(fileDescriptor);
+                byteLength = (fileSize >= 0) ? std::max<cputex::SizeType>(fileSize - request.byteOffset, 0) : -1;
+            }
+
+            if(byteLength < 0 || request.byteOffset < 0) {
+                (void)internal::closeFile(fileDescriptor);
+                complete(std::move(job), LoadResult{ {}, LoadError::FileReadFailed });
+                continue;
+            }
+
+            bool cancelled = false;
+
+            {
+                std::unique_lock lock(mMutex);
+
+                // Waiting on the decode threads, which release their bytes and notify mBudgetAvailable as they finish.
+                // A separate condition variable, so enqueue's notify_one on mReadAvailable can't be spent on a thread
+                // waiting here instead of an idle one.
+                mBudgetAvailable.wait(lock, [this, byteLength]() {
+                    return mStopping || mInFlightBytes == 0 || mInFlightBytes + byteLength <= mMaxInFlightBytes;
+                });
+
+                cancelled = mStopping;
+
+                if(!cancelled) {
+                    mInFlightBytes += byteLength;
+                    job->reservedBytes = byteLength;
+                }
+            }
+
+            if(cancelled) {
+                (void)internal::closeFile(fileDescriptor);
+                complete(std::move(job), LoadResult{ {}, LoadError::Cancelled });
+                continue;
+            }
+
+            LoadError error = LoadError::None;
+
+            try {
+                job->fileData = readRequestFile(fileDescriptor, request, byteLength, error);
+            } catch(const std::bad_alloc &) {
+                error = LoadError::OutOfMemory;
+            }
+
+            (void)internal::closeFile(fileDescriptor);
+
+            {
+                std::lock_guard lock(mMutex);
+
+                if(error != LoadError::None || mStopping) {
+                    mInFlightBytes -= job->reservedBytes;
+                    job->reservedBytes = 0;
+
+                    if(mStopping) {
+                        error = LoadError::Cancelled;
+                    }
+                } else {
+                    mDecodeQueue->jobs.push(std::move(job));
+                }
+            }
+
+            if(job != nullptr) {
+                mBudgetAvailable.notify_all();
+                complete(std::move(job), LoadResult{ {}, error });
+            } else {
+                mDecodeAvailable.notify_one();
+            }
+        }
+    }
+
+    void AsyncLoader::decodeThreadMain() noexcept {
+        // Without an executor every decode runs on its own thread, the decode threads already being the parallelism.
+        const cputex::execution::ParallelPolicy policy = (mExecutor != nullptr) ? cputex::execution::par.on(*mExecutor) : cputex::execution::par;
+        const cputex::execution::ParallelPolicy *decodePolicy = (mExecutor != nullptr) ? &policy : nullptr;
+
+        while(true) {
+            std::unique_ptr<Job> job;
+
+            {
+                std::unique_lock lock(mMutex);
+                mDecodeAvailable.wait(lock, [this]() { return mStopping || !mDecodeQueue->jobs.empty(); });
+
+                if(mDecodeQueue->jobs.empty()) {
+                    return;
+                }
+
+                job = mDecodeQueue->pop();
+            }
+
+            const cputex::span<const cputex::byte> fileData = (job->request.data.empty())
+                ? cputex::span<const cputex::byte>(job->fileData.data(), job->fileData.size())
+                : job->request.data;
+
+            LoadResult result;
+
+            try {
+                result = decodeTexture(decodePolicy, job->request, fileData);
+            } catch(const std::bad_alloc &) {
+                result = LoadResult{ {}, LoadError::OutOfMemory };
+            }
+
+            job->fileData = {};
+
+            {
+                std::lock_guard lock(mMutex);
+                mInFlightBytes -= job->reservedBytes;
+                job->reservedBytes = 0;
+            }
+
+            mBudgetAvailable.notify_all();
+            complete(std::move(job), std::move(result));
+        }
+    }
+
+    void AsyncLoader::complete(std::unique_ptr<Job> job, LoadResult result) noexcept {
+        if(job->callback) {
+            job->callback(std::move(result));
+        } else {
+            job->promise.set_value(std::move(result));
+        }
+
+        // The job is released before waking waitIdle, so nothing of it outlives the wait.
+        job.reset();
+
+        {
+            std::lock_guard lock(mMutex);
+            --mPendingCount;
+        }
+
+        mIdle.notify_all();
+    }
+}
@@ -1,19 +1,392 @@
 #include <cputex/converter.h>
+#include <cputex/internal/half.h>
+#include <cputex/internal/srgb.h>
 #include <cputex/texture_operations.h>
 
+#include <gpufmt/storage.h>
+#include <gpufmt/traits.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
 namespace cputex {
+    // Number of texels decoded into the intermediate buffer at a time. 256 glm::vec4 samples is 4KB, which keeps
+    // the intermediate buffer resident in L1 between the decode and encode passes.
+    constexpr cputex::SizeType kRowBatchTexelCount = 256;
+
+    template<class SampleT, class = void>
+    struct SampleComponent {
+        using type = SampleT;
+    };
+
+    template<class SampleT>
+    struct SampleComponent<SampleT, std::void_t<typename SampleT::value_type>> {
+        using type = typename SampleT::value_type;
+    };
+
+    template<gpufmt::Format FormatV>
+    [[nodiscard]]
+    constexpr bool isRowConvertible() noexcept {
+        using Traits = gpufmt::FormatTraits<FormatV>;
+
+        if constexpr(FormatV == gpufmt::Format::UNDEFINED ||
+                     std::is_void_v<typename Traits::BlockType> ||
+                     Traits::info.compression != gpufmt::CompressionType::None ||
+                     Traits::info.depth ||
+                     Traits::info.stencil ||
+                     Traits::BlockExtent.x > 1 || Traits::BlockExtent.y > 1 || Traits::BlockExtent.z > 1)
+        {
+            return false;
+        }
+        else {
+            // Integer and 64 bit formats can't be represented exactly by a glm::vec4, so they stay on the generic path.
+            return std::is_same_v<typename SampleComponent<typename Traits::NarrowSampleType>::type, float>;
+        }
+    }
+
+    template<class SampleT>
+    [[nodiscard]]
+    glm::vec4 toRowSample(const SampleT &sample) noexcept {
+        if constexpr(std::is_arithmetic_v<SampleT>) {
+            return glm::vec4(static_cast<float>(sample), 0.0f, 0.0f, 1.0f);
+        }
+        else {
+            glm::vec4 rowSample(0.0f, 0.0f, 0.0f, 1.0f);
+
+            for(int channel = 0; channel < SampleT::length(); ++channel) {
+                rowSample[channel] = static_cast<float>(sample[channel]);
+            }
+
+            return rowSample;
+        }
+    }
+
+    template<class SampleT>
+    [[nodiscard]]
+    SampleT fromRowSample(const glm::vec4 &rowSample) noexcept {
+        if constexpr(std::is_arithmetic_v<SampleT>) {
+            return static_cast<SampleT>(rowSample.x);
+        }
+        else {
+            SampleT sample;
+
+            for(int channel = 0; channel < SampleT::length(); ++channel) {
+                sample[channel] = static_cast<typename SampleT::value_type>(rowSample[channel]);
+            }
+
+            return sample;
+        }
+    }
+
+    template<gpufmt::Format FormatV>
+    class RowDecoder {
+    public:
+        using Traits = gpufmt::FormatTraits<FormatV>;
+        using Storage = gpufmt::FormatStorage<FormatV>;
+
+        [[nodiscard]]
+        internal::DecodeRowFunc operator()() const noexcept {
+            if constexpr(internal::isSrgb8Format(FormatV)) {
+                return &decodeSrgb;
+            }
+            else if constexpr(internal::halfFormatChannelCount(FormatV) != 0) {
+                return &decodeHalf;
+            }
+            else if constexpr(isRowConvertible<FormatV>()) {
+                return &decode;
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+    private:
+        static void decode(const cputex::byte *source, cputex::span<glm::vec4> samples) noexcept {
+            if constexpr(isRowConvertible<FormatV>()) {
+                using BlockType = typename Traits::BlockType;
+                using SampleType = typename Traits::NarrowSampleType;
+
+                const BlockType *sourceBlocks = reinterpret_cast<const BlockType *>(source);
+
+                for(size_t texel = 0; texel < samples.size(); ++texel) {
+                    SampleType sample;
+                    Storage::loadBlock(sourceBlocks[texel], cputex::span<SampleType, Traits::BlockTexelCount>(&sample, 1u));
+                    samples[texel] = toRowSample(sample);
+                }
+            }
+        }
+
+        // Reorders the texels to R8G8B8A8_SRGB so a single table driven decoder handles every channel layout.
+        static void decodeSrgb(const cputex::byte *source, cputex::span<glm::vec4> samples) noexcept {
+            if constexpr(FormatV == gpufmt::Format::R8G8B8A8_SRGB || FormatV == gpufmt::Format::A8B8G8R8_SRGB_PACK32) {
+                internal::decodeSrgb8(reinterpret_cast<const uint8_t *>(source), samples);
+            }
+            else {
+                static const internal::ByteSwizzle swizzle = *internal::findByteSwizzle(FormatV, gpufmt::Format::R8G8B8A8_SRGB);
+                static const internal::ByteSwizzleFunc swizzleRow = internal::selectByteSwizzleKernel();
+
+                std::array<cputex::byte, kRowBatchTexelCount * 4> rgba;
+
+                for(size_t texel = 0; texel < samples.size(); texel += kRowBatchTexelCount) {
+                    const size_t batchTexelCount = std::min<size_t>(kRowBatchTexelCount, samples.size() - texel);
+                    swizzleRow(swizzle, source + texel * swizzle.sourceTexelByteSize, rgba.data(), batchTexelCount);
+                    internal::decodeSrgb8(reinterpret_cast<const uint8_t *>(rgba.data()), samples.subspan(texel, batchTexelCount));
+                }
+            }
+        }
+
+        static void decodeHalf(const cputex::byte *source, cputex::span<glm::vec4> samples) noexcept {
+            constexpr cputex::SizeType kChannelCount = internal::halfFormatChannelCount(FormatV);
+
+            float *floats = reinterpret_cast<float *>(samples.data());
+            internal::halfToFloat(reinterpret_cast<const uint16_t *>(source), floats, samples.size() * kChannelCount);
+
+            if constexpr(kChannelCount < 4) {
+                // The converted channels are tightly packed at the front of samples. Spreading them out starting with
+                // the last texel never overwrites a channel before it's been read.
+                for(size_t texel = samples.size(); texel-- > 0;) {
+                    glm::vec4 sample(0.0f, 0.0f, 0.0f, 1.0f);
+
+                    for(cputex::SizeType channel = 0; channel < kChannelCount; ++channel) {
+                        sample[static_cast<int>(channel)] = floats[texel * kChannelCount + channel];
+                    }
+
+                    samples[texel] = sample;
+                }
+            }
+        }
+    };
+
+    template<gpufmt::Format FormatV>
+    class RowEncoder {
+    public:
+        using Traits = gpufmt::FormatTraits<FormatV>;
+        using Storage = gpufmt::FormatStorage<FormatV>;
+
+        [[nodiscard]]
+        internal::EncodeRowFunc operator()() const noexcept {
+            if constexpr(internal::isSrgb8Format(FormatV) && Traits::info.writeable) {
+                return &encodeSrgb;
+            }
+            else if constexpr(internal::halfFormatChannelCount(FormatV) != 0 && Traits::info.writeable) {
+                return &encodeHalf;
+            }
+            else if constexpr(isRowConvertible<FormatV>() && Traits::info.writeable) {
+                return &encode;
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+    private:
+        static void encode(cputex::span<const glm::vec4> samples, cputex::byte *dest) noexcept {
+            if constexpr(isRowConvertible<FormatV>() && Traits::info.writeable) {
+                using BlockType = typename Traits::BlockType;
+                using SampleType = typename Traits::NarrowSampleType;
+
+                BlockType *destBlocks = reinterpret_cast<BlockType *>(dest);
+
+                for(size_t texel = 0; texel < samples.size(); ++texel) {
+                    SampleType sample = fromRowSample<SampleType>(samples[texel]);
+                    destBlocks[texel] = Storage::storeBlock(cputex::span<SampleType, Traits::BlockTexelCount>(&sample, 1u));
+                }
+            }
+        }
+
+        static void encodeSrgb(cputex::span<const glm::vec4> samples, cputex::byte *dest) noexcept {
+            if constexpr(FormatV == gpufmt::Format::R8G8B8A8_SRGB || FormatV == gpufmt::Format::A8B8G8R8_SRGB_PACK32) {
+                internal::encodeSrgb8(samples, reinterpret_cast<uint8_t *>(dest));
+            }
+            else {
+                static const internal::ByteSwizzle swizzle = *internal::findByteSwizzle(gpufmt::Format::R8G8B8A8_SRGB, FormatV);
+                static const internal::ByteSwizzleFunc swizzleRow = internal::selectByteSwizzleKernel();
+
+                std::array<cputex::byte, kRowBatchTexelCount * 4> rgba;
+
+                for(size_t texel = 0; texel < samples.size(); texel += kRowBatchTexelCount) {
+                    const size_t batchTexelCount = std::min<size_t>(kRowBatchTexelCount, samples.size() - texel);
+                    internal::encodeSrgb8(samples.subspan(texel, batchTexelCount), reinterpret_cast<uint8_t *>(rgba.data()));
+                    swizzleRow(swizzle, rgba.data(), dest + texel * swizzle.destTexelByteSize, batchTexelCount);
+                }
+            }
+        }
+
+        static void encodeHalf(cputex::span<const glm::vec4> samples, cputex::byte *dest) noexcept {
+            constexpr cputex::SizeType kChannelCount = internal::halfFormatChannelCount(FormatV);
+
+            uint16_t *halves = reinterpret_cast<uint16_t *>(dest);
+
+            if constexpr(kChannelCount == 4) {
+                internal::floatToHalf(reinterpret_cast<const float *>(samples.data()), halves, samples.size() * kChannelCount);
+            }
+            else {
+                std::array<float, kRowBatchTexelCount * kChannelCount> floats;
+
+                for(size_t texel = 0; texel < samples.size(); texel += kRowBatchTexelCount) {
+                    const size_t batchTexelCount = std::min<size_t>(kRowBatchTexelCount, samples.size() - texel);
+
+                    for(size_t batchTexel = 0; batchTexel < batchTexelCount; ++batchTexel) {
+                        for(cputex::SizeType channel = 0; channel < kChannelCount; ++channel) {
+                            floats[batchTexel * kChannelCount + channel] = samples[texel + batchTexel][static_cast<int>(channel)];
+                        }
+                    }
+
+                    internal::floatToHalf(floats.data(), halves + texel * kChannelCount, batchTexelCount * kChannelCount);
+                }
+            }
+        }
+    };
+
+    template<gpufmt::Format SourceFormatV, gpufmt::Format DestFormatV>
+    class TypedConverter {
+    public:
+        using SourceTraits = gpufmt::FormatTraits<SourceFormatV>;
+        using SourceStorage = gpufmt::FormatStorage<SourceFormatV>;
+        using DestTraits = gpufmt::FormatTraits<DestFormatV>;
+        using DestStorage = gpufmt::FormatStorage<DestFormatV>;
+
+        static_assert(isRowConvertible<SourceFormatV>(), "TypedConverter source format must be row convertible");
+        static_assert(isRowConvertible<DestFormatV>() && DestTraits::info.writeable, "TypedConverter destination format must be row convertible and writeable");
+
+        static void convertRow(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+            using SourceBlockType = typename SourceTraits::BlockType;
+            using SourceSampleType = typename SourceTraits::NarrowSampleType;
+            using DestBlockType = typename DestTraits::BlockType;
+            using DestSampleType = typename DestTraits::NarrowSampleType;
+
+            const SourceBlockType *sourceBlocks = reinterpret_cast<const SourceBlockType *>(source);
+            DestBlockType *destBlocks = reinterpret_cast<DestBlockType *>(dest);
+
+            for(cputex::SizeType texel = 0; texel < texelCount; ++texel) {
+                SourceSampleType sourceSample;
+                SourceStorage::loadBlock(sourceBlocks[texel], cputex::span<SourceSampleType, SourceTraits::BlockTexelCount>(&sourceSample, 1u));
+
+                DestSampleType destSample;
+
+                if constexpr(std::is_same_v<SourceSampleType, DestSampleType>) {
+                    destSample = sourceSample;
+                }
+                else {
+                    destSample = fromRowSample<DestSampleType>(toRowSample(sourceSample));
+                }
+
+                destBlocks[texel] = DestStorage::storeBlock(cputex::span<DestSampleType, DestTraits::BlockTexelCount>(&destSample, 1u));
+            }
+        }
+    };
+
+    struct TypedConverterEntry {
+        gpufmt::Format sourceFormat;
+        gpufmt::Format destFormat;
+        internal::ConvertRowFunc convertRow;
+    };
+
+    template<gpufmt::Format SourceFormatV, gpufmt::Format DestFormatV>
+    [[nodiscard]]
+    constexpr TypedConverterEntry makeTypedConverterEntry() noexcept {
+        return { SourceFormatV, DestFormatV, &TypedConverter<SourceFormatV, DestFormatV>::convertRow };
+    }
+
+    // 16 bit float <-> 32 bit float with matching channels is a straight bulk conversion of every channel.
+    template<cputex::SizeType ChannelCountV>
+    void convertHalfRowToFloat(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        internal::halfToFloat(reinterpret_cast<const uint16_t *>(source), reinterpret_cast<float *>(dest), texelCount * ChannelCountV);
+    }
+
+    template<cputex::SizeType ChannelCountV>
+    void convertFloatRowToHalf(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        internal::floatToHalf(reinterpret_cast<const float *>(source), reinterpret_cast<uint16_t *>(dest), texelCount * ChannelCountV);
+    }
+
+    // The format pairs that make up the bulk of conversion traffic. Every other pair goes through the row decoder and
+    // encoder, or the generic block sampler path.
+    constexpr std::array kTypedConverters{
+        makeTypedConverterEntry<gpufmt::Format::R8G8B8A8_UNORM, gpufmt::Format::B8G8R8A8_UNORM>(),
+        makeTypedConverterEntry<gpufmt::Format::B8G8R8A8_UNORM, gpufmt::Format::R8G8B8A8_UNORM>(),
+        makeTypedConverterEntry<gpufmt::Format::R8G8B8A8_UNORM, gpufmt::Format::R32G32B32A32_SFLOAT>(),
+        makeTypedConverterEntry<gpufmt::Format::R32G32B32A32_SFLOAT, gpufmt::Format::R8G8B8A8_UNORM>(),
+        TypedConverterEntry{ gpufmt::Format::R16_SFLOAT, gpufmt::Format::R32_SFLOAT, &convertHalfRowToFloat<1> },
+        TypedConverterEntry{ gpufmt::Format::R32_SFLOAT, gpufmt::Format::R16_SFLOAT, &convertFloatRowToHalf<1> },
+        TypedConverterEntry{ gpufmt::Format::R16G16_SFLOAT, gpufmt::Format::R32G32_SFLOAT, &convertHalfRowToFloat<2> },
+        TypedConverterEntry{ gpufmt::Format::R32G32_SFLOAT, gpufmt::Format::R16G16_SFLOAT, &convertFloatRowToHalf<2> },
+        TypedConverterEntry{ gpufmt::Format::R16G16B16_SFLOAT, gpufmt::Format::R32G32B32_SFLOAT, &convertHalfRowToFloat<3> },
+        TypedConverterEntry{ gpufmt::Format::R32G32B32_SFLOAT, gpufmt::Format::R16G16B16_SFLOAT, &convertFloatRowToHalf<3> },
+        TypedConverterEntry{ gpufmt::Format::R16G16B16A16_SFLOAT, gpufmt::Format::R32G32B32A32_SFLOAT, &convertHalfRowToFloat<4> },
+        TypedConverterEntry{ gpufmt::Format::R32G32B32A32_SFLOAT, gpufmt::Format::R16G16B16A16_SFLOAT, &convertFloatRowToHalf<4> },
+        makeTypedConverterEntry<gpufmt::Format::R8_UNORM, gpufmt::Format::R32_SFLOAT>(),
+        makeTypedConverterEntry<gpufmt::Format::R32_SFLOAT, gpufmt::Format::R8_UNORM>(),
+    };
+
+    [[nodiscard]]
+    internal::ConvertRowFunc findTypedConverter(gpufmt::Format sourceFormat, gpufmt::Format destFormat) noexcept {
+        for(const TypedConverterEntry &entry : kTypedConverters) {
+            if(entry.sourceFormat == sourceFormat && entry.destFormat == destFormat) {
+                return entry.convertRow;
+            }
+        }
+
+        return nullptr;
+    }
+
     Converter::Converter() {}
 
     Converter::Converter(Converter &&other) noexcept
         : mBlockSampler(std::move(other.mBlockSampler))
         , mWriter(std::move(other.mWriter))
+        , mDecodeRow(other.mDecodeRow)
+        , mEncodeRow(other.mEncodeRow)
+        , mConvertRow(other.mConvertRow)
+        , mByteSwizzle(other.mByteSwizzle)
+        , mByteSwizzleRow(other.mByteSwizzleRow)
+        , mDecompressedFormat(other.mDecompressedFormat)
     {
+        other.mDecodeRow = nullptr;
+        other.mEncodeRow = nullptr;
+        other.mConvertRow = nullptr;
+        other.mByteSwizzleRow = nullptr;
+        other.mDecompressedFormat = gpufmt::Format::UNDEFINED;
     }
 
     Converter::Converter(gpufmt::Format sourceFormat, gpufmt::Format destFormat) noexcept
         : mBlockSampler(sourceFormat)
         , mWriter(destFormat)
     {
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(sourceFormat);
+        gpufmt::Format rowSourceFormat = sourceFormat;
+
+        // A compressed source that doesn't decompress straight to the destination format is decompressed a block row
+        // at a time, and the row kernels convert from the decompressed format instead.
+        if(sourceInfo.decompressible &&
+           sourceInfo.blockExtent.z == 1 &&
+           sourceInfo.decompressedFormat != destFormat &&
+           sourceInfo.decompressedFormatAlt != destFormat)
+        {
+            rowSourceFormat = sourceInfo.decompressedFormat;
+        }
+
+        mDecodeRow = gpufmt::visitFormat<RowDecoder>(rowSourceFormat);
+        mEncodeRow = gpufmt::visitFormat<RowEncoder>(destFormat);
+
+        if(mDecodeRow == nullptr || mEncodeRow == nullptr) {
+            mDecodeRow = nullptr;
+            mEncodeRow = nullptr;
+        }
+
+        mConvertRow = findTypedConverter(rowSourceFormat, destFormat);
+
+        if(std::optional<internal::ByteSwizzle> byteSwizzle = internal::findByteSwizzle(rowSourceFormat, destFormat)) {
+            mByteSwizzle = byteSwizzle.value();
+            mByteSwizzleRow = internal::selectByteSwizzleKernel();
+        }
+
+        if(rowSourceFormat != sourceFormat && hasRowPath()) {
+            mDecompressedFormat = rowSourceFormat;
+        }
     }
 
     Converter::~Converter() {}
@@ -21,6 +394,18 @@ namespace cputex {
     Converter &Converter::operator=(Converter &&other) noexcept {
         mBlockSampler = std::move(other.mBlockSampler);
         mWriter = std::move(other.mWriter);
+        mDecodeRow = other.mDecodeRow;
+        mEncodeRow = other.mEncodeRow;
+        mConvertRow = other.mConvertRow;
+        mByteSwizzle = other.mByteSwizzle;
+        mByteSwizzleRow = other.mByteSwizzleRow;
+        mDecompressedFormat = other.mDecompressedFormat;
+
+        other.mDecodeRow = nullptr;
+        other.mEncodeRow = nullptr;
+        other.mConvertRow = nullptr;
+        other.mByteSwizzleRow = nullptr;
+        other.mDecompressedFormat = gpufmt::Format::UNDEFINED;
 
         return *this;
     }
@@ -89,7 +474,38 @@ namespace cputex {
         }
     }
 
+    // Runs func(firstRow, rowCount) over rowCount rows, split into bands when a policy is given, and returns the first
+    // error any band reported.
+    template<class Func>
+    [[nodiscard]]
+    cputex::ConvertError convertBands(const cputex::execution::ParallelPolicy *policy, cputex::SizeType rowCount, cputex::SizeType rowByteSize, Func &&func) noexcept {
+        if(policy == nullptr) {
+            return func(cputex::SizeType(0), rowCount);
+        }
+
+        std::atomic<ConvertError> firstError = ConvertError::None;
+
+        cputex::execution::parallelForEachBand(*policy, rowCount, rowByteSize, [&](cputex::SizeType firstRow, cputex::SizeType bandRowCount) {
+            ConvertError error = func(firstRow, bandRowCount);
+
+            if(error != ConvertError::None) {
+                ConvertError expected = ConvertError::None;
+                firstError.compare_exchange_strong(expected, error, std::memory_order_relaxed);
+            }
+        });
+
+        return firstError.load(std::memory_order_relaxed);
+    }
+
     cputex::ConvertError Converter::convertTo(cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+        return convertSurfaceTo(nullptr, source, dest);
+    }
+
+    cputex::ConvertError Converter::convertTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+        return convertSurfaceTo(&policy, source, dest);
+    }
+
+    cputex::ConvertError Converter::convertSurfaceTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
         if(mBlockSampler.format() != source.format()) {
             return ConvertError::SourceFormatsMismatch;
         }
@@ -104,7 +520,9 @@ namespace cputex {
         if(sourceInfo.decompressible &&
            (sourceInfo.decompressedFormat == dest.format() || sourceInfo.decompressedFormatAlt == dest.format()))
         {
-            if(decompressSurfaceTo(source, dest)) {
+            const bool decompressed = (policy != nullptr) ? decompressSurfaceTo(*policy, source, dest) : decompressSurfaceTo(source, dest);
+
+            if(decompressed) {
                 return cputex::ConvertError::None;
             }
         }
@@ -117,24 +535,127 @@ namespace cputex {
             return ConvertError::SourceAndDestinationNotEquivalent;
         }
 
+        if(mDecompressedFormat != gpufmt::Format::UNDEFINED) {
+            return decompressRowsTo(policy, source, dest);
+        }
+
+        if(hasRowPath()) {
+            return convertRowsTo(policy, source, dest);
+        }
+
+        return convertBlocksTo(policy, source, dest);
+    }
+
+    bool Converter::hasRowPath() const noexcept {
+        return mByteSwizzleRow != nullptr || mConvertRow != nullptr || (mDecodeRow != nullptr && mEncodeRow != nullptr);
+    }
+
+    void Converter::convertRow(const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount, cputex::SizeType sourceTexelByteSize, cputex::SizeType destTexelByteSize) const noexcept {
+        if(mByteSwizzleRow != nullptr) {
+            mByteSwizzleRow(mByteSwizzle, source, dest, texelCount);
+            return;
+        }
+
+        if(mConvertRow != nullptr) {
+            mConvertRow(source, dest, texelCount);
+            return;
+        }
+
+        std::array<glm::vec4, kRowBatchTexelCount> rowSamples;
+
+        for(cputex::SizeType texel = 0; texel < texelCount; texel += kRowBatchTexelCount) {
+            const cputex::SizeType batchTexelCount = std::min<cputex::SizeType>(kRowBatchTexelCount, texelCount - texel);
+            cputex::span<glm::vec4> batch{ rowSamples.data(), static_cast<size_t>(batchTexelCount) };
+
+            mDecodeRow(source + texel * sourceTexelByteSize, batch);
+            mEncodeRow(batch, dest + texel * destTexelByteSize);
+        }
+    }
+
+    cputex::ConvertError Converter::convertRowsTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(source.format());
+        const gpufmt::FormatInfo &destInfo = gpufmt::formatInfo(dest.format());
+
+        const cputex::Extent extent = source.extent();
+        const cputex::SizeType rowCount = static_cast<cputex::SizeType>(extent.y) * extent.z;
+
+        // Rows are numbered across every volume slice, slice * extent.y + row.
+        return convertBands(policy, rowCount, source.rowByteSize() + dest.rowByteSize(), [&](cputex::SizeType firstRow, cputex::SizeType bandRowCount) {
+            for(cputex::SizeType row = firstRow; row < firstRow + bandRowCount; ++row) {
+                const cputex::CountType slice = static_cast<cputex::CountType>(row / extent.y);
+                const cputex::SizeType sliceRow = row % extent.y;
+
+                convertRow(source.getRowData(sliceRow, slice).data(), dest.accessRowData(sliceRow, slice).data(), extent.x, sourceInfo.blockByteSize, destInfo.blockByteSize);
+            }
+
+            return ConvertError::None;
+        });
+    }
+
+    cputex::ConvertError Converter::decompressRowsTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(source.format());
+        const gpufmt::FormatInfo &decompressedInfo = gpufmt::formatInfo(mDecompressedFormat);
+        const gpufmt::FormatInfo &destInfo = gpufmt::formatInfo(dest.format());
+
+        const cputex::Extent extent = source.extent();
+        const cputex::SizeType blockColumnCount = (static_cast<cputex::SizeType>(extent.x) + sourceInfo.blockExtent.x - 1) / sourceInfo.blockExtent.x;
+        const cputex::SizeType blockRowCount = (static_cast<cputex::SizeType>(extent.y) + sourceInfo.blockExtent.y - 1) / sourceInfo.blockExtent.y;
+
+        // One block row, decompressed. Its width is padded out to whole blocks so the decompressor never has to clip.
+        const cputex::Extent bandExtent{ static_cast<cputex::ExtentComponent>(blockColumnCount * sourceInfo.blockExtent.x), sourceInfo.blockExtent.y, 1 };
+        const cputex::SizeType sourceBandByteSize = blockColumnCount * sourceInfo.blockByteSize;
+        const cputex::SizeType bandRowByteSize = static_cast<cputex::SizeType>(bandExtent.x) * decompressedInfo.blockByteSize;
+        const cputex::SizeType blockRowByteSize = sourceBandByteSize + dest.rowByteSize() * sourceInfo.blockExtent.y;
+
+        // Block rows are numbered across every volume slice, so a band can start in one slice and end in the next.
+        return convertBands(policy, blockRowCount * extent.z, blockRowByteSize, [&](cputex::SizeType firstBlockRow, cputex::SizeType bandBlockRowCount) {
+            std::vector<cputex::byte> band(static_cast<size_t>(bandRowByteSize * bandExtent.y));
+            cputex::SurfaceSpan bandSurface{ mDecompressedFormat, cputex::TextureDimension::Texture2D, bandExtent, band };
+
+            for(cputex::SizeType sourceBandIndex = firstBlockRow; sourceBandIndex < firstBlockRow + bandBlockRowCount; ++sourceBandIndex) {
+                const cputex::CountType slice = static_cast<cputex::CountType>(sourceBandIndex / blockRowCount);
+                const cputex::SizeType blockRow = sourceBandIndex % blockRowCount;
+                cputex::SurfaceView sourceBand{ source.format(), cputex::TextureDimension::Texture2D, bandExtent, source.getRowData(blockRow, slice) };
+
+                if(!decompressSurfaceTo(sourceBand, bandSurface)) {
+                    return ConvertError::InvalidFormat;
+                }
+
+                const cputex::SizeType firstRow = blockRow * sourceInfo.blockExtent.y;
+                const cputex::SizeType bandRowCount = std::min<cputex::SizeType>(sourceInfo.blockExtent.y, extent.y - firstRow);
+
+                for(cputex::SizeType bandRow = 0; bandRow < bandRowCount; ++bandRow) {
+                    convertRow(band.data() + bandRow * bandRowByteSize, dest.accessRowData(firstRow + bandRow, slice).data(), extent.x, decompressedInfo.blockByteSize, destInfo.blockByteSize);
+                }
+            }
+
+            return ConvertError::None;
+        });
+    }
+
+    cputex::ConvertError Converter::convertBlocksTo(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView source, cputex::SurfaceSpan dest) const noexcept {
+        const gpufmt::FormatInfo &destInfo = gpufmt::formatInfo(dest.format());
+
         cputex::Extent sourceBlockExtent = mBlockSampler.blockExtent();
         cputex::Extent surfaceBlockExtent = (source.extent() + (sourceBlockExtent - ExtentComponent(1))) / sourceBlockExtent;
+        const cputex::Extent destExtent = dest.extent();
+
+        // Block rows are numbered across every block slice, zBlock * surfaceBlockExtent.y + yBlock.
+        return convertBands(policy, static_cast<cputex::SizeType>(surfaceBlockExtent.y) * surfaceBlockExtent.z, source.rowByteSize(), [&](cputex::SizeType firstBlockRow, cputex::SizeType blockRowCount) {
+            std::vector<gpufmt::SampleVariant> samples;
+            samples.resize(mBlockSampler.blockTexelCount());
 
-        std::vector<gpufmt::SampleVariant> samples;
-        samples.resize(mBlockSampler.blockTexelCount());
-    
-        gpufmt::span<const cputex::byte> sourceSpan = source.getData();
+            for(cputex::SizeType blockRow = firstBlockRow; blockRow < firstBlockRow + blockRowCount; ++blockRow) {
+                const ExtentComponent zBlock = static_cast<ExtentComponent>(blockRow / surfaceBlockExtent.y);
+                const ExtentComponent yBlock = static_cast<ExtentComponent>(blockRow % surfaceBlockExtent.y);
 
-        gpufmt::Surface<const cputex::byte> blockSurface;
-        blockSurface.blockData = sourceSpan;
-        blockSurface.extentInBlocks = surfaceBlockExtent;
+                // The sampler sees each block row as a surface of its own, so the source's pitch never matters to it.
+                gpufmt::Surface<const cputex::byte> blockSurface;
+                blockSurface.blockData = source.getRowData(yBlock, zBlock);
+                blockSurface.extentInBlocks = cputex::Extent{ surfaceBlockExtent.x, 1, 1 };
 
-        cputex::SizeType sourceByteOffset = 0;
-        for(ExtentComponent zBlock = 0; zBlock < surfaceBlockExtent.z; ++zBlock) {
-            for(ExtentComponent yBlock = 0; yBlock < surfaceBlockExtent.y; ++yBlock) {
                 for(ExtentComponent xBlock = 0; xBlock < surfaceBlockExtent.x; ++xBlock) {
-                    gpufmt::BlockSampleError error = mBlockSampler.variantSampleTo(blockSurface, { xBlock, yBlock, zBlock }, samples);
-                    sourceByteOffset += sourceInfo.blockByteSize;
+                    gpufmt::BlockSampleError error = mBlockSampler.variantSampleTo(blockSurface, { xBlock, 0, 0 }, samples);
 
                     switch(error)
                     {
@@ -153,14 +674,16 @@ namespace cputex {
                     }
 
                     gpufmt::Extent destTexel{ xBlock * sourceBlockExtent.x, yBlock * sourceBlockExtent.y, zBlock * sourceBlockExtent.z };
-                    SizeType destTexelOffset = destTexel.z * (dest.extent().y * dest.extent().x) + destTexel.y * dest.extent().x + destTexel.x;
-                    gpufmt::span<gpufmt::byte> destSpan = dest.accessDataAs<gpufmt::byte>();
-                    destSpan = destSpan.subspan(destTexelOffset * destInfo.blockByteSize);
 
-                    cputex::SizeType byteOffset = 0;
-                    for(ExtentComponent y = 0; y < sourceBlockExtent.y; ++y) {
-                        for(ExtentComponent x = 0; x < sourceBlockExtent.x; ++x) {
-                            gpufmt::WriteError writeError = mWriter.writeTo(samples[y * sourceBlockExtent.x + x], destSpan.subspan(byteOffset, destInfo.blockByteSize));
+                    // Blocks on the right and bottom edges can hang off the surface.
+                    const ExtentComponent texelColumnCount = std::min<ExtentComponent>(sourceBlockExtent.x, destExtent.x - destTexel.x);
+                    const ExtentComponent texelRowCount = std::min<ExtentComponent>(sourceBlockExtent.y, destExtent.y - destTexel.y);
+
+                    for(ExtentComponent y = 0; y < texelRowCount; ++y) {
+                        gpufmt::span<gpufmt::byte> destSpan = dest.accessRowData(destTexel.y + y, destTexel.z).subspan(destTexel.x * destInfo.blockByteSize);
+
+                        for(ExtentComponent x = 0; x < texelColumnCount; ++x) {
+                            gpufmt::WriteError writeError = mWriter.writeTo(samples[y * sourceBlockExtent.x + x], destSpan.subspan(x * destInfo.blockByteSize, destInfo.blockByteSize));
 
                             switch(writeError)
                             {
@@ -173,17 +696,13 @@ namespace cputex {
                             default:
                                 break;
                             }
-
-                            byteOffset += destInfo.blockByteSize;
                         }
-
-                        byteOffset += destInfo.blockByteSize * (dest.extent().x - sourceBlockExtent.x);
                     }
                 }
             }
-        }
 
-        return ConvertError::None;
+            return ConvertError::None;
+        });
     }
 
     cputex::ConvertError Converter::convertTo(cputex::TextureView source, cputex::TextureSpan dest) const noexcept {
@@ -220,4 +739,40 @@ namespace cputex {
 
         return ConvertError::None;
     }
-}
\ No newline at end of file
+
+    cputex::ConvertError Converter::convertTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView source, cputex::TextureSpan dest) const noexcept {
+        if(mBlockSampler.format() != source.format()) {
+            return ConvertError::SourceFormatsMismatch;
+        }
+
+        if(mWriter.format() != dest.format()) {
+            return ConvertError::DestinationFormatsMismatch;
+        }
+
+        const gpufmt::FormatInfo &destInfo = gpufmt::formatInfo(mWriter.format());
+
+        if(!destInfo.writeable) {
+            return ConvertError::FormatNotWriteable;
+        }
+
+        if(!source.equivalentDimensions(dest)) {
+            return ConvertError::SourceAndDestinationNotEquivalent;
+        }
+
+        // Keeps the first error reported by any surface.
+        std::atomic<ConvertError> firstError = ConvertError::None;
+
+        cputex::execution::parallelForEachSurface(policy, dest.arraySize(), dest.faces(), dest.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            ConvertError error = convertTo(policy,
+                                           (SurfaceView)source.getMipSurface(arraySlice, face, mip),
+                                           (SurfaceSpan)dest.accessMipSurface(arraySlice, face, mip));
+
+            if(error != ConvertError::None) {
+                ConvertError expected = ConvertError::None;
+                firstError.compare_exchange_strong(expected, error, std::memory_order_relaxed);
+            }
+        });
+
+        return firstError.load(std::memory_order_relaxed);
+    }
+}
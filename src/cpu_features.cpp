@@ -0,0 +1,76 @@
+#include <cputex/internal/cpu_features.h>
+
+#if defined(CPUTEX_ARCH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include <cstdint>
+
+namespace cputex::internal {
+#if defined(CPUTEX_ARCH_X86)
+    static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int (&registers)[4]) noexcept {
+#if defined(_MSC_VER)
+        int signedRegisters[4];
+        __cpuidex(signedRegisters, static_cast<int>(leaf), static_cast<int>(subleaf));
+
+        for(int i = 0; i < 4; ++i) {
+            registers[i] = static_cast<unsigned int>(signedRegisters[i]);
+        }
+#else
+        __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    }
+
+    [[nodiscard]]
+    static uint64_t xgetbv0() noexcept {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+#endif
+
+    [[nodiscard]]
+    static CpuFeatures queryCpuFeatures() noexcept {
+        CpuFeatures features;
+
+#if defined(CPUTEX_ARCH_X86)
+        unsigned int registers[4];
+        cpuid(0, 0, registers);
+        const unsigned int maxLeaf = registers[0];
+
+        if(maxLeaf >= 1) {
+            cpuid(1, 0, registers);
+
+            const bool osxsave = (registers[2] & (1u << 27)) != 0;
+            // The os has to save the ymm registers on context switches for any of the avx instructions to be usable.
+            const bool avx = osxsave && (registers[2] & (1u << 28)) != 0 && (xgetbv0() & 0x6) == 0x6;
+
+            features.ssse3 = (registers[2] & (1u << 9)) != 0;
+            features.sse41 = (registers[2] & (1u << 19)) != 0;
+            features.f16c = avx && (registers[2] & (1u << 29)) != 0;
+
+            if(maxLeaf >= 7) {
+                cpuid(7, 0, registers);
+                features.avx2 = avx && (registers[1] & (1u << 5)) != 0;
+            }
+        }
+#elif defined(CPUTEX_ARCH_ARM64)
+        features.neon = true;
+#endif
+
+        return features;
+    }
+
+    const CpuFeatures &cpuFeatures() noexcept {
+        static const CpuFeatures features = queryCpuFeatures();
+        return features;
+    }
+}
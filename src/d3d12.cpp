@@ -188,8 +188,6 @@ HRESULT uploadTexture(ID3D12GraphicsCommandList* commandList, ID3D12Resource* de
     std::array<D3D12_SUBRESOURCE_DATA, 16> subresources;
     UINT subresourceArrayCount = 0;
     UINT firstSubresource = 0;
-    
-    const gpufmt::FormatInfo& surfaceFormatInfo = gpufmt::formatInfo(sourceTexture.format());
 
     const UINT totalSubresourceCount = sourceTexture.arraySize() * sourceTexture.faces() * sourceTexture.mips();
     UINT64 uploadBufferOffset = 0;
@@ -211,9 +209,8 @@ HRESULT uploadTexture(ID3D12GraphicsCommandList* commandList, ID3D12Resource* de
 
         TextureSurfaceView surface = sourceTexture.getMipSurface(arraySlice, face, mip);
 
-        const auto rowPitch = surfaceFormatInfo.blockByteSize * ((surface.extent().x + surfaceFormatInfo.blockExtent.x - 1) / surfaceFormatInfo.blockExtent.x);
-        const auto blockRows = (surface.extent().y + surfaceFormatInfo.blockExtent.y - 1) / surfaceFormatInfo.blockExtent.y;
-        const auto slicePitch = blockRows * rowPitch;
+        const auto rowPitch = surface.rowPitch();
+        const auto slicePitch = surface.slicePitch();
 
         D3D12_SUBRESOURCE_DATA& subresourceData = subresources[subresourceArrayCount++];
         subresourceData.pData = surface.getData().data();
@@ -0,0 +1,705 @@
+#include <cputex/dds.h>
+
+#include <cputex/internal/file_io.h>
+#include <cputex/texture_layout.h>
+
+#include <gpufmt/dxgi.h>
+#include <gpufmt/info.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace cputex {
+    namespace {
+        constexpr uint32_t makeFourCC(char c0, char c1, char c2, char c3) noexcept {
+            return static_cast<uint32_t>(static_cast<uint8_t>(c0)) |
+                (static_cast<uint32_t>(static_cast<uint8_t>(c1)) << 8) |
+                (static_cast<uint32_t>(static_cast<uint8_t>(c2)) << 16) |
+                (static_cast<uint32_t>(static_cast<uint8_t>(c3)) << 24);
+        }
+
+        constexpr uint32_t kDdsMagic = makeFourCC('D', 'D', 'S', ' ');
+        constexpr uint32_t kDx10FourCC = makeFourCC('D', 'X', '1', '0');
+
+        // The file layout from the DDS documentation, spelled out here so reading a DDS file doesn't need the Windows
+        // headers. All fields are little endian.
+        struct DdsPixelFormat {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t fourCC;
+            uint32_t rgbBitCount;
+            uint32_t rBitMask;
+            uint32_t gBitMask;
+            uint32_t bBitMask;
+            uint32_t aBitMask;
+        };
+
+        struct DdsFileHeader {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t height;
+            uint32_t width;
+            uint32_t pitchOrLinearSize;
+            uint32_t depth;
+            uint32_t mipMapCount;
+            uint32_t reserved1[11];
+            DdsPixelFormat pixelFormat;
+            uint32_t caps;
+            uint32_t caps2;
+            uint32_t caps3;
+            uint32_t caps4;
+            uint32_t reserved2;
+        };
+
+        struct DdsFileHeaderDx10 {
+            uint32_t dxgiFormat;
+            uint32_t resourceDimension;
+            uint32_t miscFlag;
+            uint32_t arraySize;
+            uint32_t miscFlags2;
+        };
+
+        static_assert(sizeof(DdsPixelFormat) == 32);
+        static_assert(sizeof(DdsFileHeader) == 124);
+        static_assert(sizeof(DdsFileHeaderDx10) == 20);
+
+        // Enough to parse any header, with or without the DX10 extension.
+        constexpr size_t kMaxDdsHeaderByteSize = sizeof(uint32_t) + sizeof(DdsFileHeader) + sizeof(DdsFileHeaderDx10);
+
+        constexpr uint32_t kDdsdCaps = 0x1;
+        constexpr uint32_t kDdsdHeight = 0x2;
+        constexpr uint32_t kDdsdWidth = 0x4;
+        constexpr uint32_t kDdsdPitch = 0x8;
+        constexpr uint32_t kDdsdPixelFormat = 0x1000;
+        constexpr uint32_t kDdsdLinearSize = 0x80000;
+        constexpr uint32_t kDdsdDepth = 0x800000;
+        constexpr uint32_t kDdsdMipMapCount = 0x20000;
+
+        constexpr uint32_t kDdpfAlphaPixels = 0x1;
+        constexpr uint32_t kDdpfAlpha = 0x2;
+        constexpr uint32_t kDdpfFourCC = 0x4;
+        constexpr uint32_t kDdpfRgb = 0x40;
+        constexpr uint32_t kDdpfLuminance = 0x20000;
+        constexpr uint32_t kDdpfBumpDuDv = 0x80000;
+
+        constexpr uint32_t kDdsCapsComplex = 0x8;
+        constexpr uint32_t kDdsCapsTexture = 0x1000;
+        constexpr uint32_t kDdsCapsMipMap = 0x400000;
+
+        constexpr uint32_t kDdsCaps2Cubemap = 0x200;
+        constexpr uint32_t kDdsCaps2CubemapAllFaces = 0xFC00;
+        constexpr uint32_t kDdsCaps2Volume = 0x200000;
+
+        constexpr uint32_t kDx10Texture1D = 2;
+        constexpr uint32_t kDx10Texture2D = 3;
+        constexpr uint32_t kDx10Texture3D = 4;
+        constexpr uint32_t kDx10MiscTextureCube = 0x4;
+    }
+
+    [[nodiscard]]
+    static bool isBitMask(const DdsPixelFormat &pixelFormat, uint32_t r, uint32_t g, uint32_t b, uint32_t a) noexcept {
+        return pixelFormat.rBitMask == r && pixelFormat.gBitMask == g && pixelFormat.bBitMask == b && pixelFormat.aBitMask == a;
+    }
+
+    // Maps a pre-DX10 pixel format onto the DXGI format with the same memory layout, the same way D3DX and DirectXTex
+    // interpret them.
+    [[nodiscard]]
+    static DXGI_FORMAT legacyDxgiFormat(const DdsPixelFormat &pixelFormat) noexcept {
+        if(pixelFormat.flags & kDdpfFourCC) {
+            switch(pixelFormat.fourCC) {
+            case makeFourCC('D', 'X', 'T', '1'):
+                return DXGI_FORMAT_BC1_UNORM;
+            case makeFourCC('D', 'X', 'T', '2'):
+                [[fallthrough]];
+            case makeFourCC('D', 'X', 'T', '3'):
+                return DXGI_FORMAT_BC2_UNORM;
+            case makeFourCC('D', 'X', 'T', '4'):
+                [[fallthrough]];
+            case makeFourCC('D', 'X', 'T', '5'):
+                return DXGI_FORMAT_BC3_UNORM;
+            case makeFourCC('A', 'T', 'I', '1'):
+                [[fallthrough]];
+            case makeFourCC('B', 'C', '4', 'U'):
+                return DXGI_FORMAT_BC4_UNORM;
+            case makeFourCC('B', 'C', '4', 'S'):
+                return DXGI_FORMAT_BC4_SNORM;
+            case makeFourCC('A', 'T', 'I', '2'):
+                [[fallthrough]];
+            case makeFourCC('B', 'C', '5', 'U'):
+                return DXGI_FORMAT_BC5_UNORM;
+            case makeFourCC('B', 'C', '5', 'S'):
+                return DXGI_FORMAT_BC5_SNORM;
+            case makeFourCC('R', 'G', 'B', 'G'):
+                return DXGI_FORMAT_R8G8_B8G8_UNORM;
+            case makeFourCC('G', 'R', 'G', 'B'):
+                return DXGI_FORMAT_G8R8_G8B8_UNORM;
+            // D3DFORMAT values stored in the FourCC field.
+            case 36:
+                return DXGI_FORMAT_R16G16B16A16_UNORM;
+            case 110:
+                return DXGI_FORMAT_R16G16B16A16_SNORM;
+            case 111:
+                return DXGI_FORMAT_R16_FLOAT;
+            case 112:
+                return DXGI_FORMAT_R16G16_FLOAT;
+            case 113:
+                return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case 114:
+                return DXGI_FORMAT_R32_FLOAT;
+            case 115:
+                return DXGI_FORMAT_R32G32_FLOAT;
+            case 116:
+                return DXGI_FORMAT_R32G32B32A32_FLOAT;
+            default:
+                return DXGI_FORMAT_UNKNOWN;
+            }
+        }
+
+        if(pixelFormat.flags & kDdpfRgb) {
+            switch(pixelFormat.rgbBitCount) {
+            case 32:
+                if(isBitMask(pixelFormat, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000)) {
+                    return DXGI_FORMAT_R8G8B8A8_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000)) {
+                    return DXGI_FORMAT_B8G8R8A8_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0x00FF0000, 0x0000FF00, 0x000000FF, 0)) {
+                    return DXGI_FORMAT_B8G8R8X8_UNORM;
+                }
+
+                // D3DX writes A2B10G10R10 with the red and blue masks swapped.
+                if(isBitMask(pixelFormat, 0x3FF00000, 0x000FFC00, 0x000003FF, 0xC0000000) ||
+                   isBitMask(pixelFormat, 0x000003FF, 0x000FFC00, 0x3FF00000, 0xC0000000)) {
+                    return DXGI_FORMAT_R10G10B10A2_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0x0000FFFF, 0xFFFF0000, 0, 0)) {
+                    return DXGI_FORMAT_R16G16_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0xFFFFFFFF, 0, 0, 0)) {
+                    return DXGI_FORMAT_R32_FLOAT;
+                }
+                break;
+            case 16:
+                if(isBitMask(pixelFormat, 0x7C00, 0x03E0, 0x001F, 0x8000)) {
+                    return DXGI_FORMAT_B5G5R5A1_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0xF800, 0x07E0, 0x001F, 0)) {
+                    return DXGI_FORMAT_B5G6R5_UNORM;
+                }
+
+                if(isBitMask(pixelFormat, 0x0F00, 0x00F0, 0x000F, 0xF000)) {
+                    return DXGI_FORMAT_B4G4R4A4_UNORM;
+                }
+                break;
+            }
+
+            return DXGI_FORMAT_UNKNOWN;
+        }
+
+        if(pixelFormat.flags & kDdpfLuminance) {
+            if(pixelFormat.rgbBitCount == 8 && isBitMask(pixelFormat, 0xFF, 0, 0, 0)) {
+                return DXGI_FORMAT_R8_UNORM;
+            }
+
+            if(pixelFormat.rgbBitCount == 16 && isBitMask(pixelFormat, 0xFFFF, 0, 0, 0)) {
+                return DXGI_FORMAT_R16_UNORM;
+            }
+
+            if(pixelFormat.rgbBitCount == 16 && (pixelFormat.flags & kDdpfAlphaPixels) && isBitMask(pixelFormat, 0x00FF, 0, 0, 0xFF00)) {
+                return DXGI_FORMAT_R8G8_UNORM;
+            }
+
+            return DXGI_FORMAT_UNKNOWN;
+        }
+
+        if(pixelFormat.flags & kDdpfAlpha) {
+            return (pixelFormat.rgbBitCount == 8) ? DXGI_FORMAT_A8_UNORM : DXGI_FORMAT_UNKNOWN;
+        }
+
+        if(pixelFormat.flags & kDdpfBumpDuDv) {
+            if(pixelFormat.rgbBitCount == 16 && isBitMask(pixelFormat, 0x00FF, 0xFF00, 0, 0)) {
+                return DXGI_FORMAT_R8G8_SNORM;
+            }
+
+            if(pixelFormat.rgbBitCount == 32 && isBitMask(pixelFormat, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000)) {
+                return DXGI_FORMAT_R8G8B8A8_SNORM;
+            }
+
+            if(pixelFormat.rgbBitCount == 32 && isBitMask(pixelFormat, 0x0000FFFF, 0xFFFF0000, 0, 0)) {
+                return DXGI_FORMAT_R16G16_SNORM;
+            }
+        }
+
+        return DXGI_FORMAT_UNKNOWN;
+    }
+
+    [[nodiscard]]
+    static gpufmt::Format legacyFormat(const DdsPixelFormat &pixelFormat) noexcept {
+        // 24 bit RGB has no DXGI equivalent, but gpufmt has a format for it.
+        if((pixelFormat.flags & kDdpfRgb) && pixelFormat.rgbBitCount == 24) {
+            if(isBitMask(pixelFormat, 0x00FF0000, 0x0000FF00, 0x000000FF, 0)) {
+                return gpufmt::Format::B8G8R8_UNORM;
+            }
+
+            if(isBitMask(pixelFormat, 0x000000FF, 0x0000FF00, 0x00FF0000, 0)) {
+                return gpufmt::Format::R8G8B8_UNORM;
+            }
+
+            return gpufmt::Format::UNDEFINED;
+        }
+
+        const DXGI_FORMAT dxgiFormat = legacyDxgiFormat(pixelFormat);
+
+        if(dxgiFormat == DXGI_FORMAT_UNKNOWN) {
+            return gpufmt::Format::UNDEFINED;
+        }
+
+        return gpufmt::dxgi::translateFormat(dxgiFormat);
+    }
+
+    DdsHeader parseDdsHeader(cputex::span<const cputex::byte> fileData, DdsError &error) noexcept {
+        DdsHeader ddsHeader;
+
+        if(fileData.size_bytes() < sizeof(uint32_t) + sizeof(DdsFileHeader)) {
+            error = DdsError::FileTooSmall;
+            return ddsHeader;
+        }
+
+        uint32_t magic;
+        std::memcpy(&magic, fileData.data(), sizeof(magic));
+
+        DdsFileHeader header;
+        std::memcpy(&header, fileData.data() + sizeof(magic), sizeof(header));
+
+        if(magic != kDdsMagic || header.size != sizeof(DdsFileHeader) || header.pixelFormat.size != sizeof(DdsPixelFormat)) {
+            error = DdsError::InvalidHeader;
+            return ddsHeader;
+        }
+
+        TextureParams &params = ddsHeader.params;
+        params.extent = Extent{ static_cast<cputex::ExtentComponent>(header.width), static_cast<cputex::ExtentComponent>(header.height), 1 };
+        params.mips = (header.flags & kDdsdMipMapCount) ? static_cast<cputex::CountType>(std::max(header.mipMapCount, 1u)) : 1;
+        params.arraySize = 1;
+        params.faces = 1;
+        params.surfaceByteAlignment = 1;
+        params.rowPitchAlignment = 1;
+        params.sliceAlignment = 1;
+
+        if(header.width == 0 || header.width > static_cast<uint32_t>(maxExtentComponent) ||
+           header.height > static_cast<uint32_t>(maxExtentComponent) ||
+           header.depth > static_cast<uint32_t>(maxExtentComponent) ||
+           params.mips > maxMipCount) {
+            error = DdsError::InvalidHeader;
+            return ddsHeader;
+        }
+
+        ddsHeader.dataOffset = static_cast<cputex::SizeType>(sizeof(magic) + sizeof(header));
+
+        if((header.pixelFormat.flags & kDdpfFourCC) && header.pixelFormat.fourCC == kDx10FourCC) {
+            if(fileData.size_bytes() < sizeof(magic) + sizeof(header) + sizeof(DdsFileHeaderDx10)) {
+                error = DdsError::FileTooSmall;
+                return ddsHeader;
+            }
+
+            DdsFileHeaderDx10 headerDx10;
+            std::memcpy(&headerDx10, fileData.data() + ddsHeader.dataOffset, sizeof(headerDx10));
+            ddsHeader.dataOffset += static_cast<cputex::SizeType>(sizeof(headerDx10));
+
+            params.format = gpufmt::dxgi::translateFormat(static_cast<DXGI_FORMAT>(headerDx10.dxgiFormat));
+
+            if(headerDx10.arraySize == 0 || headerDx10.arraySize > static_cast<uint32_t>(std::numeric_limits<cputex::CountType>::max())) {
+                error = DdsError::InvalidHeader;
+                return ddsHeader;
+            }
+
+            params.arraySize = static_cast<cputex::CountType>(headerDx10.arraySize);
+
+            switch(headerDx10.resourceDimension) {
+            case kDx10Texture1D:
+                params.dimension = TextureDimension::Texture1D;
+                params.extent.y = 1;
+                break;
+            case kDx10Texture2D:
+                if(headerDx10.miscFlag & kDx10MiscTextureCube) {
+                    params.dimension = TextureDimension::TextureCube;
+                    params.faces = 6;
+                } else {
+                    params.dimension = TextureDimension::Texture2D;
+                }
+                break;
+            case kDx10Texture3D:
+                if(params.arraySize != 1) {
+                    error = DdsError::UnsupportedDimension;
+                    return ddsHeader;
+                }
+
+                params.dimension = TextureDimension::Texture3D;
+                params.extent.z = static_cast<cputex::ExtentComponent>(header.depth);
+                break;
+            default:
+                error = DdsError::InvalidHeader;
+                return ddsHeader;
+            }
+        } else {
+            params.format = legacyFormat(header.pixelFormat);
+
+            if(header.caps2 & kDdsCaps2Cubemap) {
+                // cputex has no partial cubemaps.
+                if((header.caps2 & kDdsCaps2CubemapAllFaces) != kDdsCaps2CubemapAllFaces) {
+                    error = DdsError::UnsupportedDimension;
+                    return ddsHeader;
+                }
+
+                params.dimension = TextureDimension::TextureCube;
+                params.faces = 6;
+            } else if((header.flags & kDdsdDepth) && (header.caps2 & kDdsCaps2Volume)) {
+                params.dimension = TextureDimension::Texture3D;
+                params.extent.z = static_cast<cputex::ExtentComponent>(header.depth);
+            } else {
+                params.dimension = TextureDimension::Texture2D;
+            }
+        }
+
+        if(params.format == gpufmt::Format::UNDEFINED) {
+            error = DdsError::UnsupportedFormat;
+            return ddsHeader;
+        }
+
+        const TextureLayout layout = cputex::computeLayout(params);
+
+        if(!layout.isValid()) {
+            error = DdsError::InvalidHeader;
+            return ddsHeader;
+        }
+
+        params = layout.params;
+        ddsHeader.dataByteSize = layout.sizeInBytes;
+        error = DdsError::None;
+        return ddsHeader;
+    }
+
+    UniqueTexture readDds(cputex::span<const cputex::byte> fileData, DdsError &error) {
+        const DdsHeader ddsHeader = parseDdsHeader(fileData, error);
+
+        if(error != DdsError::None) {
+            return {};
+        }
+
+        if(static_cast<cputex::SizeType>(fileData.size_bytes()) - ddsHeader.dataOffset < ddsHeader.dataByteSize) {
+            error = DdsError::FileTooSmall;
+            return {};
+        }
+
+        UniqueTexture texture{ ddsHeader.params, fileData.subspan(static_cast<size_t>(ddsHeader.dataOffset), static_cast<size_t>(ddsHeader.dataByteSize)) };
+
+        if(texture.empty()) {
+            error = DdsError::TextureCreationFailed;
+        }
+
+        return texture;
+    }
+
+    [[nodiscard]]
+    static bool readSurfaceData(std::ifstream &file, cputex::TextureSpan texture) {
+        cputex::span<cputex::byte> surfaceData = texture.accessData();
+        file.read(reinterpret_cast<char *>(surfaceData.data()), static_cast<std::streamsize>(surfaceData.size_bytes()));
+        return file.gcount() == static_cast<std::streamsize>(surfaceData.size_bytes());
+    }
+
+    [[nodiscard]]
+    static bool readSurfaceData(std::ifstream &file, UniqueTexture &texture) {
+        return readSurfaceData(file, cputex::TextureSpan(texture));
+    }
+
+    [[nodiscard]]
+    static bool readSurfaceData(std::ifstream &file, SharedTexture &texture) {
+        SharedTextureLock lock = texture.lock();
+        return readSurfaceData(file, lock);
+    }
+
+    // Reads the headers, then the surface data straight into the texture, so there is never a second copy of it.
+    template<class TextureT>
+    [[nodiscard]]
+    static TextureT readDdsFile(const std::filesystem::path &path, DdsError &error) {
+        std::ifstream file(path, std::ios::binary);
+
+        if(!file) {
+            error = DdsError::FileOpenFailed;
+            return {};
+        }
+
+        std::array<cputex::byte, kMaxDdsHeaderByteSize> headerData{};
+        file.read(reinterpret_cast<char *>(headerData.data()), static_cast<std::streamsize>(headerData.size()));
+
+        const DdsHeader ddsHeader = parseDdsHeader(cputex::span<const cputex::byte>(headerData.data(), static_cast<size_t>(file.gcount())), error);
+
+        if(error != DdsError::None) {
+            return {};
+        }
+
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(ddsHeader.dataOffset));
+
+        TextureT texture{ cputex::uninitialized, ddsHeader.params };
+
+        if(texture.empty()) {
+            error = DdsError::TextureCreationFailed;
+            return {};
+        }
+
+        if(!readSurfaceData(file, texture)) {
+            error = (file.eof()) ? DdsError::FileTooSmall : DdsError::FileReadFailed;
+            return {};
+        }
+
+        return texture;
+    }
+
+    template<class TextureT>
+    [[nodiscard]]
+    static TextureT mapDdsFile(const std::filesystem::path &path, DdsError &error) {
+        const cputex::span<cputex::byte> mapping = internal::mapFile(path);
+
+        if(mapping.empty()) {
+            error = (std::filesystem::exists(path)) ? DdsError::FileMapFailed : DdsError::FileOpenFailed;
+            return {};
+        }
+
+        const DdsHeader ddsHeader = parseDdsHeader(mapping, error);
+
+        if(error == DdsError::None && static_cast<cputex::SizeType>(mapping.size_bytes()) - ddsHeader.dataOffset < ddsHeader.dataByteSize) {
+            error = DdsError::FileTooSmall;
+        }
+
+        if(error != DdsError::None) {
+            internal::unmapFile(mapping);
+            return {};
+        }
+
+        // Every alignment is 1, so the surface data can start at any offset into the mapping.
+        TextureT texture{ cputex::adoptMemory, ddsHeader.params,
+                          mapping.subspan(static_cast<size_t>(ddsHeader.dataOffset), static_cast<size_t>(ddsHeader.dataByteSize)),
+                          [mapping](cputex::span<cputex::byte>) { internal::unmapFile(mapping); } };
+
+        if(texture.empty()) {
+            internal::unmapFile(mapping);
+            error = DdsError::TextureCreationFailed;
+        }
+
+        return texture;
+    }
+
+    UniqueTexture readDds(const std::filesystem::path &path, DdsLoadMode mode, DdsError &error) {
+        return (mode == DdsLoadMode::MemoryMap) ? mapDdsFile<UniqueTexture>(path, error) : readDdsFile<UniqueTexture>(path, error);
+    }
+
+    SharedTexture readSharedDds(const std::filesystem::path &path, DdsLoadMode mode, DdsError &error) {
+        return (mode == DdsLoadMode::MemoryMap) ? mapDdsFile<SharedTexture>(path, error) : readDdsFile<SharedTexture>(path, error);
+    }
+
+    // Fills in the headers for a texture. Returns false if its format has neither a DXGI nor a legacy equivalent.
+    [[nodiscard]]
+    static bool makeDdsHeaders(const TextureView &texture, DdsFileHeader &header, DdsFileHeaderDx10 &headerDx10, bool &useDx10) noexcept {
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(texture.format());
+        const Extent &extent = texture.extent();
+
+        header = DdsFileHeader{};
+        header.size = sizeof(DdsFileHeader);
+        header.flags = kDdsdCaps | kDdsdHeight | kDdsdWidth | kDdsdPixelFormat;
+        header.width = static_cast<uint32_t>(extent.x);
+        header.height = static_cast<uint32_t>(std::max(extent.y, cputex::ExtentComponent(1)));
+        header.mipMapCount = static_cast<uint32_t>(texture.mips());
+        header.pixelFormat.size = sizeof(DdsPixelFormat);
+        header.caps = kDdsCapsTexture;
+
+        const cputex::SizeType rowByteSize = info.blockByteSize * ((extent.x + info.blockExtent.x - 1) / info.blockExtent.x);
+
+        if(info.compression != gpufmt::CompressionType::None) {
+            const cputex::SizeType blockRows = (header.height + info.blockExtent.y - 1) / info.blockExtent.y;
+            header.flags |= kDdsdLinearSize;
+            header.pitchOrLinearSize = static_cast<uint32_t>(rowByteSize * blockRows);
+        } else {
+            header.flags |= kDdsdPitch;
+            header.pitchOrLinearSize = static_cast<uint32_t>(rowByteSize);
+        }
+
+        if(texture.mips() > 1) {
+            header.flags |= kDdsdMipMapCount;
+            header.caps |= kDdsCapsComplex | kDdsCapsMipMap;
+        }
+
+        if(texture.dimension() == TextureDimension::Texture3D) {
+            header.flags |= kDdsdDepth;
+            header.depth = static_cast<uint32_t>(extent.z);
+            header.caps |= kDdsCapsComplex;
+            header.caps2 |= kDdsCaps2Volume;
+        } else if(texture.dimension() == TextureDimension::TextureCube) {
+            header.caps |= kDdsCapsComplex;
+            header.caps2 |= kDdsCaps2Cubemap | kDdsCaps2CubemapAllFaces;
+        }
+
+        const gpufmt::dxgi::FormatConversion conversion = gpufmt::dxgi::translateFormat(texture.format());
+
+        if(conversion.exact) {
+            useDx10 = true;
+            header.pixelFormat.flags = kDdpfFourCC;
+            header.pixelFormat.fourCC = kDx10FourCC;
+
+            headerDx10 = DdsFileHeaderDx10{};
+            headerDx10.dxgiFormat = static_cast<uint32_t>(*conversion.exact);
+            headerDx10.arraySize = static_cast<uint32_t>(texture.arraySize());
+
+            switch(texture.dimension()) {
+            case TextureDimension::Texture1D:
+                headerDx10.resourceDimension = kDx10Texture1D;
+                break;
+            case TextureDimension::Texture2D:
+                headerDx10.resourceDimension = kDx10Texture2D;
+                break;
+            case TextureDimension::TextureCube:
+                headerDx10.resourceDimension = kDx10Texture2D;
+                headerDx10.miscFlag = kDx10MiscTextureCube;
+                break;
+            case TextureDimension::Texture3D:
+                headerDx10.resourceDimension = kDx10Texture3D;
+                break;
+            }
+
+            return true;
+        }
+
+        // Only the DX10 extension can describe arrays, and 24 bit RGB is the one format written without it.
+        useDx10 = false;
+
+        if(texture.arraySize() != 1) {
+            return false;
+        }
+
+        header.pixelFormat.flags = kDdpfRgb;
+        header.pixelFormat.rgbBitCount = 24;
+
+        switch(texture.format()) {
+        case gpufmt::Format::B8G8R8_UNORM:
+            header.pixelFormat.rBitMask = 0x00FF0000;
+            header.pixelFormat.gBitMask = 0x0000FF00;
+            header.pixelFormat.bBitMask = 0x000000FF;
+            return true;
+        case gpufmt::Format::R8G8B8_UNORM:
+            header.pixelFormat.rBitMask = 0x000000FF;
+            header.pixelFormat.gBitMask = 0x0000FF00;
+            header.pixelFormat.bBitMask = 0x00FF0000;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    [[nodiscard]]
+    static bool writeSurface(SurfaceView surface, const DdsWriteCallback &callback) {
+        if(surface.isPacked()) {
+            return callback(surface.getData().first(static_cast<size_t>(surface.sizeInBytes())));
+        }
+
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(surface.format());
+        const cputex::ExtentComponent blockRows = (surface.extent().y + info.blockExtent.y - 1) / info.blockExtent.y;
+        const cputex::ExtentComponent volumeSlices = (surface.extent().z + info.blockExtent.z - 1) / info.blockExtent.z;
+
+        for(cputex::ExtentComponent volumeSlice = 0; volumeSlice < volumeSlices; ++volumeSlice) {
+            for(cputex::ExtentComponent blockRow = 0; blockRow < blockRows; ++blockRow) {
+                if(!callback(surface.getRowData(blockRow, volumeSlice))) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    DdsError writeDds(TextureView texture, const DdsWriteCallback &callback) {
+        if(texture.empty()) {
+            return DdsError::EmptyTexture;
+        }
+
+        DdsFileHeader header;
+        DdsFileHeaderDx10 headerDx10;
+        bool useDx10 = false;
+
+        if(!makeDdsHeaders(texture, header, headerDx10, useDx10)) {
+            return DdsError::UnsupportedFormat;
+        }
+
+        std::array<cputex::byte, kMaxDdsHeaderByteSize> headerData{};
+        std::memcpy(headerData.data(), &kDdsMagic, sizeof(kDdsMagic));
+        std::memcpy(headerData.data() + sizeof(kDdsMagic), &header, sizeof(header));
+
+        size_t headerByteSize = sizeof(kDdsMagic) + sizeof(header);
+
+        if(useDx10) {
+            std::memcpy(headerData.data() + headerByteSize, &headerDx10, sizeof(headerDx10));
+            headerByteSize += sizeof(headerDx10);
+        }
+
+        if(!callback(cputex::span<const cputex::byte>(headerData.data(), headerByteSize))) {
+            return DdsError::FileWriteFailed;
+        }
+
+        // Without any padding the surface data already is the DDS payload.
+        TextureParams packedParams;
+        packedParams.format = texture.format();
+        packedParams.dimension = texture.dimension();
+        packedParams.extent = texture.extent();
+        packedParams.arraySize = texture.arraySize();
+        packedParams.faces = texture.faces();
+        packedParams.mips = texture.mips();
+        packedParams.surfaceByteAlignment = 1;
+
+        if(cputex::computeLayout(packedParams).sizeInBytes == texture.sizeInBytes()) {
+            return (callback(texture.getData())) ? DdsError::None : DdsError::FileWriteFailed;
+        }
+
+        for(cputex::CountType arraySlice = 0; arraySlice < texture.arraySize(); ++arraySlice) {
+            for(cputex::CountType face = 0; face < texture.faces(); ++face) {
+                for(cputex::CountType mip = 0; mip < texture.mips(); ++mip) {
+                    if(!writeSurface((SurfaceView)texture.getMipSurface(arraySlice, face, mip), callback)) {
+                        return DdsError::FileWriteFailed;
+                    }
+                }
+            }
+        }
+
+        return DdsError::None;
+    }
+
+    DdsError writeDds(TextureView texture, int fileDescriptor) {
+        return writeDds(texture, [fileDescriptor](cputex::span<const cputex::byte> data) {
+            return internal::writeFile(fileDescriptor, data);
+        });
+    }
+
+    DdsError writeDds(TextureView texture, const std::filesystem::path &path) {
+        const int fileDescriptor = internal::createFile(path);
+
+        if(fileDescriptor < 0) {
+            return DdsError::FileOpenFailed;
+        }
+
+        DdsError error = writeDds(texture, fileDescriptor);
+
+        // Write errors can be deferred until the file is closed.
+        if(!internal::closeFile(fileDescriptor) && error == DdsError::None) {
+            error = DdsError::FileWriteFailed;
+        }
+
+        return error;
+    }
+}
@@ -0,0 +1,123 @@
+#include <cputex/execution.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace cputex::execution {
+    struct ThreadPool::Job {
+        TaskFunc task = nullptr;
+        void *context = nullptr;
+        cputex::SizeType taskCount = 0;
+        std::atomic<cputex::SizeType> nextTask{ 0 };
+
+        // Threads currently running tasks from this job, including the thread that submitted it. Only accessed with
+        // the pool mutex held.
+        cputex::SizeType threadCount = 0;
+
+        void run() noexcept {
+            for(cputex::SizeType taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed);
+                taskIndex < taskCount;
+                taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed))
+            {
+                task(context, taskIndex);
+            }
+        }
+    };
+
+    ThreadPool::ThreadPool(cputex::SizeType workerCount) {
+        mWorkers.reserve(static_cast<size_t>(workerCount));
+
+        for(cputex::SizeType i = 0; i < workerCount; ++i) {
+            mWorkers.emplace_back([this]() { workerMain(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+
+        mJobAvailable.notify_all();
+
+        for(std::thread &worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallelFor(cputex::SizeType taskCount, TaskFunc task, void *context) noexcept {
+        if(taskCount <= 0) {
+            return;
+        }
+
+        if(taskCount == 1 || mWorkers.empty()) {
+            for(cputex::SizeType taskIndex = 0; taskIndex < taskCount; ++taskIndex) {
+                task(context, taskIndex);
+            }
+
+            return;
+        }
+
+        Job job;
+        job.task = task;
+        job.context = context;
+        job.taskCount = taskCount;
+        job.threadCount = 1;
+
+        {
+            std::lock_guard lock(mMutex);
+            mJobs.push_back(&job);
+        }
+
+        mJobAvailable.notify_all();
+
+        job.run();
+
+        // Every task has been claimed. Wait for the workers still running one before the job goes out of scope.
+        std::unique_lock lock(mMutex);
+
+        if(auto it = std::find(mJobs.begin(), mJobs.end(), &job); it != mJobs.end()) {
+            mJobs.erase(it);
+        }
+
+        --job.threadCount;
+        mJobFinished.wait(lock, [&job]() { return job.threadCount == 0; });
+    }
+
+    cputex::SizeType ThreadPool::concurrency() const noexcept {
+        return static_cast<cputex::SizeType>(mWorkers.size()) + 1;
+    }
+
+    void ThreadPool::workerMain() noexcept {
+        std::unique_lock lock(mMutex);
+
+        while(true) {
+            mJobAvailable.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+
+            if(mJobs.empty()) {
+                return;
+            }
+
+            Job *job = mJobs.front();
+            ++job->threadCount;
+
+            lock.unlock();
+            job->run();
+            lock.lock();
+
+            // run only returns once every task has been claimed, so no other thread needs to find this job again.
+            if(auto it = std::find(mJobs.begin(), mJobs.end(), job); it != mJobs.end()) {
+                mJobs.erase(it);
+            }
+
+            if(--job->threadCount == 0) {
+                mJobFinished.notify_all();
+            }
+        }
+    }
+
+    Executor &defaultExecutor() noexcept {
+        static ThreadPool pool(std::max<cputex::SizeType>(static_cast<cputex::SizeType>(std::thread::hardware_concurrency()), 1) - 1);
+        return pool;
+    }
+}
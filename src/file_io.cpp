@@ -0,0 +1,244 @@
+#include <cputex/internal/file_io.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cputex::internal {
+#if defined(_WIN32)
+    cputex::span<cputex::byte> mapFile(const std::filesystem::path &path) noexcept {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if(file == INVALID_HANDLE_VALUE) {
+            return {};
+        }
+
+        LARGE_INTEGER fileSize{};
+
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+            CloseHandle(file);
+            return {};
+        }
+
+        HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if(fileMapping == nullptr) {
+            return {};
+        }
+
+        // The view keeps the mapping object alive until it is unmapped.
+        void *view = MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(fileMapping);
+
+        if(view == nullptr) {
+            return {};
+        }
+
+        return cputex::span<cputex::byte>(static_cast<cputex::byte *>(view), static_cast<size_t>(fileSize.QuadPart));
+    }
+
+    void unmapFile(cputex::span<cputex::byte> mapping) noexcept {
+        if(!mapping.empty()) {
+            UnmapViewOfFile(mapping.data());
+        }
+    }
+
+    int openFile(const std::filesystem::path &path) noexcept {
+        return _wopen(path.c_str(), _O_RDONLY | _O_BINARY);
+    }
+
+    cputex::SizeType fileSize(int fileDescriptor) noexcept {
+        struct _stat64 fileStat{};
+
+        if(_fstat64(fileDescriptor, &fileStat) != 0) {
+            return -1;
+        }
+
+        return static_cast<cputex::SizeType>(fileStat.st_size);
+    }
+
+    cputex::SizeType readFileAt(int fileDescriptor, cputex::SizeType byteOffset, cputex::span<cputex::byte> data) noexcept {
+        HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(fileDescriptor));
+
+        if(file == INVALID_HANDLE_VALUE) {
+            return -1;
+        }
+
+        cputex::byte *next = data.data();
+        size_t remaining = data.size_bytes();
+        cputex::SizeType totalRead = 0;
+
+        // An OVERLAPPED offset on a synchronous handle reads at that offset, like pread.
+        while(remaining > 0) {
+            const cputex::SizeType offset = byteOffset + totalRead;
+
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD read = 0;
+
+            if(!ReadFile(file, next, static_cast<DWORD>(std::min(remaining, static_cast<size_t>(std::numeric_limits<DWORD>::max()))), &read, &overlapped)) {
+                if(GetLastError() == ERROR_HANDLE_EOF) {
+                    break;
+                }
+
+                return -1;
+            }
+
+            if(read == 0) {
+                break;
+            }
+
+            next += read;
+            remaining -= read;
+            totalRead += read;
+        }
+
+        return totalRead;
+    }
+
+    int createFile(const std::filesystem::path &path) noexcept {
+        return _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+    }
+
+    bool closeFile(int fileDescriptor) noexcept {
+        return _close(fileDescriptor) == 0;
+    }
+
+    bool writeFile(int fileDescriptor, cputex::span<const cputex::byte> data) noexcept {
+        const cputex::byte *next = data.data();
+        size_t remaining = data.size_bytes();
+
+        while(remaining > 0) {
+            const int written = _write(fileDescriptor, next, static_cast<unsigned int>(std::min(remaining, static_cast<size_t>(std::numeric_limits<int>::max()))));
+
+            if(written <= 0) {
+                return false;
+            }
+
+            next += written;
+            remaining -= static_cast<size_t>(written);
+        }
+
+        return true;
+    }
+#else
+    cputex::span<cputex::byte> mapFile(const std::filesystem::path &path) noexcept {
+        const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if(file < 0) {
+            return {};
+        }
+
+        struct stat fileStat{};
+
+        if(fstat(file, &fileStat) != 0 || fileStat.st_size <= 0) {
+            close(file);
+            return {};
+        }
+
+        // The mapping keeps its own reference to the file, so the descriptor isn't needed past this point.
+        void *view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        close(file);
+
+        if(view == MAP_FAILED) {
+            return {};
+        }
+
+        return cputex::span<cputex::byte>(static_cast<cputex::byte *>(view), static_cast<size_t>(fileStat.st_size));
+    }
+
+    void unmapFile(cputex::span<cputex::byte> mapping) noexcept {
+        if(!mapping.empty()) {
+            munmap(mapping.data(), mapping.size_bytes());
+        }
+    }
+
+    int openFile(const std::filesystem::path &path) noexcept {
+        return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    cputex::SizeType fileSize(int fileDescriptor) noexcept {
+        struct stat fileStat{};
+
+        if(fstat(fileDescriptor, &fileStat) != 0) {
+            return -1;
+        }
+
+        return static_cast<cputex::SizeType>(fileStat.st_size);
+    }
+
+    cputex::SizeType readFileAt(int fileDescriptor, cputex::SizeType byteOffset, cputex::span<cputex::byte> data) noexcept {
+        cputex::byte *next = data.data();
+        size_t remaining = data.size_bytes();
+        cputex::SizeType totalRead = 0;
+
+        while(remaining > 0) {
+            const ssize_t read = pread(fileDescriptor, next, remaining, static_cast<off_t>(byteOffset + totalRead));
+
+            if(read < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if(read < 0) {
+                return -1;
+            }
+
+            if(read == 0) {
+                break;
+            }
+
+            next += read;
+            remaining -= static_cast<size_t>(read);
+            totalRead += read;
+        }
+
+        return totalRead;
+    }
+
+    int createFile(const std::filesystem::path &path) noexcept {
+        return open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    }
+
+    bool closeFile(int fileDescriptor) noexcept {
+        return close(fileDescriptor) == 0;
+    }
+
+    bool writeFile(int fileDescriptor, cputex::span<const cputex::byte> data) noexcept {
+        const cputex::byte *next = data.data();
+        size_t remaining = data.size_bytes();
+
+        // Writes can come back short, e.g. when interrupted by a signal or past a pipe's capacity.
+        while(remaining > 0) {
+            const ssize_t written = write(fileDescriptor, next, remaining);
+
+            if(written < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if(written <= 0) {
+                return false;
+            }
+
+            next += written;
+            remaining -= static_cast<size_t>(written);
+        }
+
+        return true;
+    }
+#endif
+}
@@ -0,0 +1,200 @@
+#include <cputex/internal/half.h>
+#include <cputex/internal/cpu_features.h>
+
+#if defined(CPUTEX_ARCH_X86)
+#include <immintrin.h>
+#elif defined(CPUTEX_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+#include <cstring>
+
+namespace cputex::internal {
+    [[nodiscard]]
+    static uint32_t floatBits(float value) noexcept {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    [[nodiscard]]
+    static float bitsToFloat(uint32_t bits) noexcept {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]]
+    static float halfToFloatValue(uint16_t half) noexcept {
+        // Rebias the exponent, then fix up the two special exponents. Subnormal halves are normalized by letting the
+        // fpu subtract the implicit one back out, which is exact.
+        constexpr uint32_t kShiftedExponent = 0x7C00u << 13;
+        constexpr float kSubnormalMagic = 6.103515625e-05f; // 2^-14
+
+        uint32_t bits = (static_cast<uint32_t>(half) & 0x7FFFu) << 13;
+        const uint32_t exponent = bits & kShiftedExponent;
+        bits += (127u - 15u) << 23;
+
+        if(exponent == kShiftedExponent) {
+            bits += (128u - 16u) << 23;
+
+            // Signaling NaNs come out quiet, like the hardware conversions.
+            if((bits & 0x7FFFFFu) != 0) {
+                bits |= 0x400000u;
+            }
+        }
+        else if(exponent == 0) {
+            bits += 1u << 23;
+            bits = floatBits(bitsToFloat(bits) - kSubnormalMagic);
+        }
+
+        return bitsToFloat(bits | ((static_cast<uint32_t>(half) & 0x8000u) << 16));
+    }
+
+    [[nodiscard]]
+    static uint16_t floatToHalfValue(float value) noexcept {
+        constexpr uint32_t kFloatInfinity = 255u << 23;
+        constexpr uint32_t kHalfOverflow = (127u + 16u) << 23;
+        constexpr uint32_t kSubnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        uint32_t bits = floatBits(value);
+        const uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint16_t half;
+
+        if(bits >= kHalfOverflow) {
+            if(bits > kFloatInfinity) {
+                half = static_cast<uint16_t>(0x7E00u | ((bits >> 13) & 0x3FFu));
+            }
+            else {
+                half = 0x7C00u;
+            }
+        }
+        else if(bits < (113u << 23)) {
+            // Below the smallest normal half. Adding the magic number lines the half's subnormal mantissa up with the
+            // bottom of the float mantissa, so the fpu's own round to nearest even does the rounding.
+            half = static_cast<uint16_t>(floatBits(bitsToFloat(bits) + bitsToFloat(kSubnormalMagic)) - kSubnormalMagic);
+        }
+        else {
+            // Rebias, then round to nearest even on the 13 dropped bits. A carry out of the mantissa correctly bumps
+            // the exponent, all the way to infinity for values that round above the largest half.
+            const uint32_t mantissaOdd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xFFFu;
+            bits += mantissaOdd;
+            half = static_cast<uint16_t>(bits >> 13);
+        }
+
+        return static_cast<uint16_t>(half | (sign >> 16));
+    }
+
+    void halfToFloatScalar(const uint16_t *source, float *dest, cputex::SizeType count) noexcept {
+        for(cputex::SizeType i = 0; i < count; ++i) {
+            dest[i] = halfToFloatValue(source[i]);
+        }
+    }
+
+    void floatToHalfScalar(const float *source, uint16_t *dest, cputex::SizeType count) noexcept {
+        for(cputex::SizeType i = 0; i < count; ++i) {
+            dest[i] = floatToHalfValue(source[i]);
+        }
+    }
+
+    using HalfToFloatFunc = void(*)(const uint16_t *source, float *dest, cputex::SizeType count) noexcept;
+    using FloatToHalfFunc = void(*)(const float *source, uint16_t *dest, cputex::SizeType count) noexcept;
+
+#if defined(CPUTEX_ARCH_X86)
+    CPUTEX_TARGET("avx,f16c")
+    static void halfToFloatF16c(const uint16_t *source, float *dest, cputex::SizeType count) noexcept {
+        while(count >= 8) {
+            _mm256_storeu_ps(dest, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source))));
+
+            source += 8;
+            dest += 8;
+            count -= 8;
+        }
+
+        halfToFloatScalar(source, dest, count);
+    }
+
+    CPUTEX_TARGET("avx,f16c")
+    static void floatToHalfF16c(const float *source, uint16_t *dest, cputex::SizeType count) noexcept {
+        while(count >= 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm256_cvtps_ph(_mm256_loadu_ps(source), _MM_FROUND_TO_NEAREST_INT));
+
+            source += 8;
+            dest += 8;
+            count -= 8;
+        }
+
+        floatToHalfScalar(source, dest, count);
+    }
+#elif defined(CPUTEX_ARCH_ARM64)
+    static void halfToFloatNeon(const uint16_t *source, float *dest, cputex::SizeType count) noexcept {
+        while(count >= 8) {
+            const float16x8_t halves = vreinterpretq_f16_u16(vld1q_u16(source));
+            vst1q_f32(dest, vcvt_f32_f16(vget_low_f16(halves)));
+            vst1q_f32(dest + 4, vcvt_high_f32_f16(halves));
+
+            source += 8;
+            dest += 8;
+            count -= 8;
+        }
+
+        halfToFloatScalar(source, dest, count);
+    }
+
+    static void floatToHalfNeon(const float *source, uint16_t *dest, cputex::SizeType count) noexcept {
+        while(count >= 8) {
+            const float16x8_t halves = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(source)), vld1q_f32(source + 4));
+            vst1q_u16(dest, vreinterpretq_u16_f16(halves));
+
+            source += 8;
+            dest += 8;
+            count -= 8;
+        }
+
+        floatToHalfScalar(source, dest, count);
+    }
+#endif
+
+    [[nodiscard]]
+    static HalfToFloatFunc selectHalfToFloatKernel() noexcept {
+#if defined(CPUTEX_ARCH_X86)
+        if(cpuFeatures().f16c) {
+            return &halfToFloatF16c;
+        }
+#elif defined(CPUTEX_ARCH_ARM64)
+        if(cpuFeatures().neon) {
+            return &halfToFloatNeon;
+        }
+#endif
+
+        return &halfToFloatScalar;
+    }
+
+    [[nodiscard]]
+    static FloatToHalfFunc selectFloatToHalfKernel() noexcept {
+#if defined(CPUTEX_ARCH_X86)
+        if(cpuFeatures().f16c) {
+            return &floatToHalfF16c;
+        }
+#elif defined(CPUTEX_ARCH_ARM64)
+        if(cpuFeatures().neon) {
+            return &floatToHalfNeon;
+        }
+#endif
+
+        return &floatToHalfScalar;
+    }
+
+    void halfToFloat(const uint16_t *source, float *dest, cputex::SizeType count) noexcept {
+        static const HalfToFloatFunc kernel = selectHalfToFloatKernel();
+        kernel(source, dest, count);
+    }
+
+    void floatToHalf(const float *source, uint16_t *dest, cputex::SizeType count) noexcept {
+        static const FloatToHalfFunc kernel = selectFloatToHalfKernel();
+        kernel(source, dest, count);
+    }
+}
@@ -0,0 +1,1018 @@
+#include <cputex/ktx2.h>
+
+#include <cputex/internal/file_io.h>
+#include <cputex/texture_layout.h>
+
+#include <gpufmt/info.h>
+#include <gpufmt/vulkan.h>
+
+#if defined(CPUTEX_ZSTD)
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace cputex {
+    namespace {
+        constexpr std::array<uint8_t, 12> kKtx2Identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+        // The file layout from the KTX 2.0 specification. All fields are little endian.
+        struct Ktx2FileHeader {
+            std::array<uint8_t, 12> identifier;
+            uint32_t vkFormat;
+            uint32_t typeSize;
+            uint32_t pixelWidth;
+            uint32_t pixelHeight;
+            uint32_t pixelDepth;
+            uint32_t layerCount;
+            uint32_t faceCount;
+            uint32_t levelCount;
+            uint32_t supercompressionScheme;
+            uint32_t dfdByteOffset;
+            uint32_t dfdByteLength;
+            uint32_t kvdByteOffset;
+            uint32_t kvdByteLength;
+            uint64_t sgdByteOffset;
+            uint64_t sgdByteLength;
+        };
+
+        struct Ktx2FileLevel {
+            uint64_t byteOffset;
+            uint64_t byteLength;
+            uint64_t uncompressedByteLength;
+        };
+
+        static_assert(sizeof(Ktx2FileHeader) == kKtx2HeaderByteSize);
+        static_assert(sizeof(Ktx2FileLevel) == 24);
+
+        // The basic descriptor block of a data format descriptor, followed in the file by its samples.
+        struct Ktx2FileDfd {
+            uint32_t dfdTotalSize;
+            uint32_t vendorIdAndDescriptorType;
+            uint32_t versionNumberAndDescriptorBlockSize;
+            uint32_t colorModelPrimariesTransferFlags;
+            uint32_t texelBlockDimensions;
+            uint32_t bytesPlanes0To3;
+            uint32_t bytesPlanes4To7;
+        };
+
+        static_assert(sizeof(Ktx2FileDfd) == 28);
+
+        // Where one channel sits in the texel block and the range of values that map to 0 and 1.
+        struct Ktx2FileDfdSample {
+            uint32_t bitOffsetLengthChannelQualifiers;
+            uint32_t samplePositions;
+            uint32_t sampleLower;
+            uint32_t sampleUpper;
+        };
+
+        static_assert(sizeof(Ktx2FileDfdSample) == 16);
+
+        constexpr uint32_t kKhrDfVersion = 2;
+        constexpr uint32_t kKhrDfModelRgbsda = 1;
+        constexpr uint32_t kKhrDfPrimariesBt709 = 1;
+        constexpr uint32_t kKhrDfTransferLinear = 1;
+        constexpr uint32_t kKhrDfTransferSrgb = 2;
+
+        constexpr uint32_t kKhrDfChannelRed = 0;
+        constexpr uint32_t kKhrDfChannelGreen = 1;
+        constexpr uint32_t kKhrDfChannelBlue = 2;
+        constexpr uint32_t kKhrDfChannelStencil = 13;
+        constexpr uint32_t kKhrDfChannelDepth = 14;
+        constexpr uint32_t kKhrDfChannelAlpha = 15;
+
+        constexpr uint32_t kKhrDfSampleLinear = 0x10;
+        constexpr uint32_t kKhrDfSampleSigned = 0x40;
+        constexpr uint32_t kKhrDfSampleFloat = 0x80;
+
+        constexpr uint32_t kFloatMinusOne = 0xBF800000u;
+        constexpr uint32_t kFloatOne = 0x3F800000u;
+
+        // KTXwriter is the one key the specification asks every writer to set. Key and value are null terminated and
+        // the entry is padded out to 4 bytes.
+        constexpr char kKtx2WriterKeyValue[] = "KTXwriter\0cputexture";
+        constexpr uint32_t kKtx2WriterKeyValueByteLength = sizeof(kKtx2WriterKeyValue);
+        constexpr uint32_t kKtx2KvdByteLength = (sizeof(uint32_t) + kKtx2WriterKeyValueByteLength + 3) & ~uint32_t(3);
+    }
+
+    // Size of the data type of a Vulkan format's texel blocks: the size of one component, or of the whole texel for
+    // packed formats, and 1 for compressed formats. Core formats are numbered in groups of equal component size.
+    [[nodiscard]]
+    static uint32_t vulkanTypeSize(uint32_t vkFormat) noexcept {
+        if(vkFormat >= 2 && vkFormat <= 8) { return 2; }    // *_PACK16
+        if(vkFormat >= 51 && vkFormat <= 69) { return 4; }  // *_PACK32
+        if(vkFormat >= 70 && vkFormat <= 97) { return 2; }  // 16 bit components
+        if(vkFormat >= 98 && vkFormat <= 109) { return 4; } // 32 bit components
+        if(vkFormat >= 110 && vkFormat <= 121) { return 8; } // 64 bit components
+
+        switch(vkFormat) {
+        case 122: // B10G11R11_UFLOAT_PACK32
+        case 123: // E5B9G9R9_UFLOAT_PACK32
+        case 125: // X8_D24_UNORM_PACK32
+        case 126: // D32_SFLOAT
+        case 129: // D24_UNORM_S8_UINT
+        case 130: // D32_SFLOAT_S8_UINT
+            return 4;
+        case 124: // D16_UNORM
+        case 128: // D16_UNORM_S8_UINT
+        case 1000340000: // A4R4G4B4_UNORM_PACK16
+        case 1000340001: // A4B4G4R4_UNORM_PACK16
+            return 2;
+        default:
+            return 1;
+        }
+    }
+
+    // KHR_DF_MODEL_* for a Vulkan format, which tells readers that go by the DFD which block compression to expect.
+    [[nodiscard]]
+    static uint32_t vulkanColorModel(uint32_t vkFormat) noexcept {
+        if(vkFormat >= 131 && vkFormat <= 134) { return 128; } // BC1
+        if(vkFormat >= 135 && vkFormat <= 136) { return 129; } // BC2
+        if(vkFormat >= 137 && vkFormat <= 138) { return 130; } // BC3
+        if(vkFormat >= 139 && vkFormat <= 140) { return 131; } // BC4
+        if(vkFormat >= 141 && vkFormat <= 142) { return 132; } // BC5
+        if(vkFormat >= 143 && vkFormat <= 144) { return 133; } // BC6H
+        if(vkFormat >= 145 && vkFormat <= 146) { return 134; } // BC7
+        if(vkFormat >= 147 && vkFormat <= 156) { return 161; } // ETC2 and EAC
+        if(vkFormat >= 157 && vkFormat <= 184) { return 162; } // ASTC
+        if(vkFormat >= 1000066000 && vkFormat <= 1000066013) { return 162; } // ASTC HDR
+
+        return kKhrDfModelRgbsda;
+    }
+
+    [[nodiscard]]
+    static bool isVulkanSrgbFormat(uint32_t vkFormat) noexcept {
+        switch(vkFormat) {
+        case 15: case 22: case 29: case 36: case 43: case 50: case 57:
+        case 132: case 134: case 136: case 138: case 146:
+        case 148: case 150: case 152:
+            return true;
+        default:
+            // ASTC alternates between UNORM and SRGB.
+            return vkFormat >= 158 && vkFormat <= 184 && vkFormat % 2 == 0;
+        }
+    }
+
+    enum class VulkanNumericType {
+        Unorm,
+        Snorm,
+        Uscaled,
+        Sscaled,
+        Uint,
+        Sint,
+        Srgb,
+        Sfloat,
+        Ufloat,
+    };
+
+    // A sample as the KTX specification's reference writer fills it in: normalized types span their integer range,
+    // integer types 0 or -1 to 1, and floats -1.0 or 0.0 to 1.0. Alpha stays linear in sRGB formats.
+    [[nodiscard]]
+    static Ktx2FileDfdSample makeDfdSample(uint32_t channel, uint32_t bitOffset, uint32_t bitLength, VulkanNumericType type) noexcept {
+        uint32_t qualifiers = 0;
+        uint32_t lower = 0;
+        uint32_t upper = (bitLength >= 32) ? 0xFFFFFFFFu : (1u << bitLength) - 1u;
+
+        switch(type) {
+        case VulkanNumericType::Unorm:
+            break;
+        case VulkanNumericType::Srgb:
+            qualifiers = (channel == kKhrDfChannelAlpha) ? kKhrDfSampleLinear : 0u;
+            break;
+        case VulkanNumericType::Snorm:
+            qualifiers = kKhrDfSampleSigned;
+            upper = (bitLength >= 32) ? 0x7FFFFFFFu : (1u << (bitLength - 1)) - 1u;
+            lower = ~upper + 1u;
+            break;
+        case VulkanNumericType::Uscaled:
+        case VulkanNumericType::Uint:
+            upper = 1;
+            break;
+        case VulkanNumericType::Sscaled:
+        case VulkanNumericType::Sint:
+            qualifiers = kKhrDfSampleSigned;
+            lower = 0xFFFFFFFFu;
+            upper = 1;
+            break;
+        case VulkanNumericType::Sfloat:
+            qualifiers = kKhrDfSampleFloat | kKhrDfSampleSigned;
+            lower = kFloatMinusOne;
+            upper = kFloatOne;
+            break;
+        case VulkanNumericType::Ufloat:
+            qualifiers = kKhrDfSampleFloat;
+            upper = kFloatOne;
+            break;
+        }
+
+        Ktx2FileDfdSample sample{};
+        sample.bitOffsetLengthChannelQualifiers = bitOffset | ((bitLength - 1) << 16) | ((channel | qualifiers) << 24);
+        sample.sampleLower = lower;
+        sample.sampleUpper = upper;
+        return sample;
+    }
+
+    // The DFD samples of a Vulkan format, one per channel in bit offset order, or per stored part of a compressed block.
+    // Returns the number of samples, 0 for formats without a plain channel layout: packed floats, shared exponents and
+    // combined depth stencil, which vkFormat alone describes.
+    [[nodiscard]]
+    static int vulkanDfdSamples(uint32_t vkFormat, std::array<Ktx2FileDfdSample, 4> &samples) noexcept {
+        constexpr uint32_t R = kKhrDfChannelRed;
+        constexpr uint32_t G = kKhrDfChannelGreen;
+        constexpr uint32_t B = kKhrDfChannelBlue;
+        constexpr uint32_t A = kKhrDfChannelAlpha;
+
+        struct Channel {
+            uint32_t channel;
+            uint32_t bitOffset;
+            uint32_t bitLength;
+        };
+
+        int sampleCount = 0;
+
+        const auto addChannels = [&](std::initializer_list<Channel> channels, VulkanNumericType type) {
+            for(const Channel &channel : channels) {
+                samples[sampleCount++] = makeDfdSample(channel.channel, channel.bitOffset, channel.bitLength, type);
+            }
+
+            return sampleCount;
+        };
+
+        // Components of equal size stored in channel order, one after another.
+        const auto addArray = [&](std::initializer_list<uint32_t> channels, uint32_t bitLength, VulkanNumericType type) {
+            uint32_t bitOffset = 0;
+
+            for(const uint32_t channel : channels) {
+                samples[sampleCount++] = makeDfdSample(channel, bitOffset, bitLength, type);
+                bitOffset += bitLength;
+            }
+
+            return sampleCount;
+        };
+
+        constexpr std::array<VulkanNumericType, 7> kNormScaledIntSrgb = { VulkanNumericType::Unorm, VulkanNumericType::Snorm,
+                                                                          VulkanNumericType::Uscaled, VulkanNumericType::Sscaled,
+                                                                          VulkanNumericType::Uint, VulkanNumericType::Sint,
+                                                                          VulkanNumericType::Srgb };
+        constexpr std::array<VulkanNumericType, 7> kNormScaledIntFloat = { VulkanNumericType::Unorm, VulkanNumericType::Snorm,
+                                                                           VulkanNumericType::Uscaled, VulkanNumericType::Sscaled,
+                                                                           VulkanNumericType::Uint, VulkanNumericType::Sint,
+                                                                           VulkanNumericType::Sfloat };
+        constexpr std::array<VulkanNumericType, 3> kIntFloat = { VulkanNumericType::Uint, VulkanNumericType::Sint, VulkanNumericType::Sfloat };
+
+        // Packed format names list their components from the most significant bits down.
+        switch(vkFormat) {
+        case 1: return addChannels({ { G, 0, 4 }, { R, 4, 4 } }, VulkanNumericType::Unorm); // R4G4_UNORM_PACK8
+        case 2: return addChannels({ { A, 0, 4 }, { B, 4, 4 }, { G, 8, 4 }, { R, 12, 4 } }, VulkanNumericType::Unorm); // R4G4B4A4_UNORM_PACK16
+        case 3: return addChannels({ { A, 0, 4 }, { R, 4, 4 }, { G, 8, 4 }, { B, 12, 4 } }, VulkanNumericType::Unorm); // B4G4R4A4_UNORM_PACK16
+        case 4: return addChannels({ { B, 0, 5 }, { G, 5, 6 }, { R, 11, 5 } }, VulkanNumericType::Unorm); // R5G6B5_UNORM_PACK16
+        case 5: return addChannels({ { R, 0, 5 }, { G, 5, 6 }, { B, 11, 5 } }, VulkanNumericType::Unorm); // B5G6R5_UNORM_PACK16
+        case 6: return addChannels({ { A, 0, 1 }, { B, 1, 5 }, { G, 6, 5 }, { R, 11, 5 } }, VulkanNumericType::Unorm); // R5G5B5A1_UNORM_PACK16
+        case 7: return addChannels({ { A, 0, 1 }, { R, 1, 5 }, { G, 6, 5 }, { B, 11, 5 } }, VulkanNumericType::Unorm); // B5G5R5A1_UNORM_PACK16
+        case 8: return addChannels({ { B, 0, 5 }, { G, 5, 5 }, { R, 10, 5 }, { A, 15, 1 } }, VulkanNumericType::Unorm); // A1R5G5B5_UNORM_PACK16
+        case 124: return addChannels({ { kKhrDfChannelDepth, 0, 16 } }, VulkanNumericType::Unorm); // D16_UNORM
+        case 125: return addChannels({ { kKhrDfChannelDepth, 0, 24 } }, VulkanNumericType::Unorm); // X8_D24_UNORM_PACK32
+        case 126: return addChannels({ { kKhrDfChannelDepth, 0, 32 } }, VulkanNumericType::Sfloat); // D32_SFLOAT
+        case 127: return addChannels({ { kKhrDfChannelStencil, 0, 8 } }, VulkanNumericType::Uint); // S8_UINT
+        default:
+            break;
+        }
+
+        if(vkFormat >= 9 && vkFormat <= 57) {
+            const uint32_t group = (vkFormat - 9) / 7;
+            const VulkanNumericType type = kNormScaledIntSrgb[(vkFormat - 9) % 7];
+
+            switch(group) {
+            case 0: return addArray({ R }, 8, type);
+            case 1: return addArray({ R, G }, 8, type);
+            case 2: return addArray({ R, G, B }, 8, type);
+            case 3: return addArray({ B, G, R }, 8, type);
+            case 4: return addArray({ R, G, B, A }, 8, type);
+            case 5: return addArray({ B, G, R, A }, 8, type);
+            default: return addArray({ R, G, B, A }, 8, type); // A8B8G8R8_*_PACK32 is R8G8B8A8 in little endian
+            }
+        }
+
+        if(vkFormat >= 58 && vkFormat <= 69) {
+            const VulkanNumericType type = kNormScaledIntSrgb[(vkFormat - 58) % 6];
+
+            return (vkFormat <= 63)
+                ? addChannels({ { B, 0, 10 }, { G, 10, 10 }, { R, 20, 10 }, { A, 30, 2 } }, type)  // A2R10G10B10_*_PACK32
+                : addChannels({ { R, 0, 10 }, { G, 10, 10 }, { B, 20, 10 }, { A, 30, 2 } }, type); // A2B10G10R10_*_PACK32
+        }
+
+        if(vkFormat >= 70 && vkFormat <= 97) {
+            const VulkanNumericType type = kNormScaledIntFloat[(vkFormat - 70) % 7];
+            constexpr std::array<uint32_t, 4> channels = { R, G, B, A };
+            const uint32_t channelCount = (vkFormat - 70) / 7 + 1;
+
+            for(uint32_t channel = 0; channel < channelCount; ++channel) {
+                samples[sampleCount++] = makeDfdSample(channels[channel], channel * 16, 16, type);
+            }
+
+            return sampleCount;
+        }
+
+        if(vkFormat >= 98 && vkFormat <= 121) {
+            const VulkanNumericType type = kIntFloat[(vkFormat - 98) % 3];
+            constexpr std::array<uint32_t, 4> channels = { R, G, B, A };
+            const uint32_t bitLength = (vkFormat <= 109) ? 32 : 64;
+            const uint32_t channelCount = ((vkFormat - 98) / 3) % 4 + 1;
+
+            for(uint32_t channel = 0; channel < channelCount; ++channel) {
+                samples[sampleCount++] = makeDfdSample(channels[channel], channel * bitLength, bitLength, type);
+            }
+
+            return sampleCount;
+        }
+
+        // Compressed blocks are described by the parts stored in them, in the channel numbering of their color model.
+        const VulkanNumericType blockType = isVulkanSrgbFormat(vkFormat) ? VulkanNumericType::Srgb : VulkanNumericType::Unorm;
+
+        switch(vkFormat) {
+        case 131: case 132: return addChannels({ { 0, 0, 64 } }, blockType);                 // BC1 RGB, color
+        case 133: case 134: return addChannels({ { 1, 0, 64 } }, blockType);                 // BC1 RGBA, color with alpha
+        case 135: case 136:                                                                  // BC2
+        case 137: case 138: return addChannels({ { A, 0, 64 }, { 0, 64, 64 } }, blockType); // BC3
+        case 139: return addChannels({ { 0, 0, 64 } }, VulkanNumericType::Unorm);           // BC4_UNORM
+        case 140: return addChannels({ { 0, 0, 64 } }, VulkanNumericType::Snorm);           // BC4_SNORM
+        case 141: return addChannels({ { R, 0, 64 }, { G, 64, 64 } }, VulkanNumericType::Unorm); // BC5_UNORM
+        case 142: return addChannels({ { R, 0, 64 }, { G, 64, 64 } }, VulkanNumericType::Snorm); // BC5_SNORM
+        case 143: return addChannels({ { 0, 0, 128 } }, VulkanNumericType::Ufloat);         // BC6H_UFLOAT
+        case 144: return addChannels({ { 0, 0, 128 } }, VulkanNumericType::Sfloat);         // BC6H_SFLOAT
+        case 145: case 146: return addChannels({ { 0, 0, 128 } }, blockType);                // BC7
+        case 147: case 148:                                                                  // ETC2_R8G8B8
+        case 149: case 150: return addChannels({ { 2, 0, 64 } }, blockType);                 // ETC2_R8G8B8A1, punchthrough alpha
+        case 151: case 152: return addChannels({ { A, 0, 64 }, { 2, 64, 64 } }, blockType); // ETC2_R8G8B8A8
+        case 153: return addChannels({ { R, 0, 64 } }, VulkanNumericType::Unorm);           // EAC_R11_UNORM
+        case 154: return addChannels({ { R, 0, 64 } }, VulkanNumericType::Snorm);           // EAC_R11_SNORM
+        case 155: return addChannels({ { R, 0, 64 }, { G, 64, 64 } }, VulkanNumericType::Unorm); // EAC_R11G11_UNORM
+        case 156: return addChannels({ { R, 0, 64 }, { G, 64, 64 } }, VulkanNumericType::Snorm); // EAC_R11G11_SNORM
+        default:
+            break;
+        }
+
+        if(vkFormat >= 157 && vkFormat <= 184) {
+            return addChannels({ { 0, 0, 128 } }, blockType); // ASTC LDR
+        }
+
+        if(vkFormat >= 1000066000 && vkFormat <= 1000066013) {
+            return addChannels({ { 0, 0, 128 } }, VulkanNumericType::Sfloat); // ASTC HDR
+        }
+
+        return 0;
+    }
+
+    // Byte size of one tightly packed surface of every mip. KTX2 has no row, slice or surface padding.
+    [[nodiscard]]
+    static TextureLayout packedLayout(TextureParams params) noexcept {
+        params.surfaceByteAlignment = 1;
+        params.rowPitchAlignment = 1;
+        params.sliceAlignment = 1;
+        return cputex::computeLayout(params);
+    }
+
+    Ktx2Header parseKtx2Header(cputex::span<const cputex::byte> fileData, Ktx2Error &error) noexcept {
+        Ktx2Header ktx2Header;
+        ktx2Header.byteSize = kKtx2HeaderByteSize;
+
+        if(static_cast<cputex::SizeType>(fileData.size_bytes()) < kKtx2HeaderByteSize) {
+            error = Ktx2Error::FileTooSmall;
+            return ktx2Header;
+        }
+
+        Ktx2FileHeader header;
+        std::memcpy(&header, fileData.data(), sizeof(header));
+
+        if(header.identifier != kKtx2Identifier) {
+            error = Ktx2Error::InvalidHeader;
+            return ktx2Header;
+        }
+
+        const uint32_t levelCount = std::max(header.levelCount, 1u);
+        const uint32_t layerCount = std::max(header.layerCount, 1u);
+
+        if(header.pixelWidth == 0 || header.pixelWidth > static_cast<uint32_t>(maxExtentComponent) ||
+           header.pixelHeight > static_cast<uint32_t>(maxExtentComponent) ||
+           header.pixelDepth > static_cast<uint32_t>(maxExtentComponent) ||
+           layerCount > static_cast<uint32_t>(std::numeric_limits<cputex::CountType>::max()) ||
+           (header.faceCount != 1 && header.faceCount != 6) ||
+           (header.faceCount == 6 && header.pixelDepth > 0) ||
+           levelCount > static_cast<uint32_t>(maxMipCount)) {
+            error = Ktx2Error::InvalidHeader;
+            return ktx2Header;
+        }
+
+        ktx2Header.byteSize = kKtx2HeaderByteSize + static_cast<cputex::SizeType>(levelCount * sizeof(Ktx2FileLevel));
+
+        if(static_cast<cputex::SizeType>(fileData.size_bytes()) < ktx2Header.byteSize) {
+            error = Ktx2Error::FileTooSmall;
+            return ktx2Header;
+        }
+
+        TextureParams &params = ktx2Header.params;
+        params.format = gpufmt::vulkan::translateFormat(static_cast<VkFormat>(header.vkFormat));
+        params.extent = Extent{ static_cast<cputex::ExtentComponent>(header.pixelWidth),
+                                static_cast<cputex::ExtentComponent>(std::max(header.pixelHeight, 1u)),
+                                static_cast<cputex::ExtentComponent>(std::max(header.pixelDepth, 1u)) };
+        params.arraySize = static_cast<cputex::CountType>(layerCount);
+        params.faces = static_cast<cputex::CountType>(header.faceCount);
+        params.mips = static_cast<cputex::CountType>(levelCount);
+
+        if(header.faceCount == 6) {
+            params.dimension = TextureDimension::TextureCube;
+        } else if(header.pixelDepth > 0) {
+            params.dimension = TextureDimension::Texture3D;
+        } else if(header.pixelHeight == 0) {
+            params.dimension = TextureDimension::Texture1D;
+        } else {
+            params.dimension = TextureDimension::Texture2D;
+        }
+
+        // A VK_FORMAT_UNDEFINED file holds BasisLZ or another format only its DFD describes.
+        if(params.format == gpufmt::Format::UNDEFINED) {
+            error = Ktx2Error::UnsupportedFormat;
+            return ktx2Header;
+        }
+
+        const TextureLayout layout = packedLayout(params);
+
+        if(!layout.isValid() || layout.params.mips != params.mips) {
+            error = Ktx2Error::InvalidHeader;
+            return ktx2Header;
+        }
+
+        ktx2Header.supercompression = static_cast<Ktx2Supercompression>(header.supercompressionScheme);
+
+        for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+            Ktx2FileLevel level;
+            std::memcpy(&level, fileData.data() + kKtx2HeaderByteSize + mip * sizeof(Ktx2FileLevel), sizeof(level));
+
+            const cputex::SizeType levelByteSize = layout.mipByteSizes[mip] * params.arraySize * params.faces;
+
+            if(level.byteOffset > static_cast<uint64_t>(std::numeric_limits<cputex::SizeType>::max()) ||
+               level.byteLength > static_cast<uint64_t>(std::numeric_limits<cputex::SizeType>::max()) ||
+               level.uncompressedByteLength != static_cast<uint64_t>(levelByteSize) ||
+               (ktx2Header.supercompression == Ktx2Supercompression::None && level.byteLength != level.uncompressedByteLength)) {
+                error = Ktx2Error::InvalidHeader;
+                return ktx2Header;
+            }
+
+            ktx2Header.levels[mip].byteOffset = static_cast<cputex::SizeType>(level.byteOffset);
+            ktx2Header.levels[mip].byteLength = static_cast<cputex::SizeType>(level.byteLength);
+            ktx2Header.levels[mip].uncompressedByteLength = static_cast<cputex::SizeType>(level.uncompressedByteLength);
+        }
+
+        error = Ktx2Error::None;
+        return ktx2Header;
+    }
+
+    [[nodiscard]]
+    static bool isSupportedSupercompression(Ktx2Supercompression supercompression) noexcept {
+#if defined(CPUTEX_ZSTD)
+        return supercompression == Ktx2Supercompression::None || supercompression == Ktx2Supercompression::Zstandard;
+#else
+        return supercompression == Ktx2Supercompression::None;
+#endif
+    }
+
+    // Decodes one level into mip destMip of every surface of texture. A level holds its surfaces back to back in
+    // array slice, face order, each surfaceByteSize bytes. The texture's rows must be packed.
+    [[nodiscard]]
+    static Ktx2Error decodeLevel(Ktx2Supercompression supercompression, cputex::span<const cputex::byte> levelData, cputex::SizeType surfaceByteSize,
+                                 cputex::TextureSpan texture, cputex::CountType destMip) noexcept {
+        if(supercompression == Ktx2Supercompression::None) {
+            for(cputex::CountType arraySlice = 0; arraySlice < texture.arraySize(); ++arraySlice) {
+                for(cputex::CountType face = 0; face < texture.faces(); ++face) {
+                    const cputex::span<const cputex::byte> surfaceData = levelData.first(static_cast<size_t>(surfaceByteSize));
+                    std::copy(surfaceData.begin(), surfaceData.end(), texture.accessMipSurfaceData(arraySlice, face, destMip).begin());
+                    levelData = levelData.subspan(static_cast<size_t>(surfaceByteSize));
+                }
+            }
+
+            return Ktx2Error::None;
+        }
+
+#if defined(CPUTEX_ZSTD)
+        if(supercompression == Ktx2Supercompression::Zstandard) {
+            // Streamed straight into each surface in turn, so a level spread over several surfaces needs no staging.
+            std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ ZSTD_createDCtx(), &ZSTD_freeDCtx };
+
+            if(context == nullptr) {
+                return Ktx2Error::DecompressionFailed;
+            }
+
+            ZSTD_inBuffer input{ levelData.data(), levelData.size_bytes(), 0 };
+
+            for(cputex::CountType arraySlice = 0; arraySlice < texture.arraySize(); ++arraySlice) {
+                for(cputex::CountType face = 0; face < texture.faces(); ++face) {
+                    ZSTD_outBuffer output{ texture.accessMipSurfaceData(arraySlice, face, destMip).data(), static_cast<size_t>(surfaceByteSize), 0 };
+
+                    while(output.pos < output.size) {
+                        const size_t previousInputPos = input.pos;
+                        const size_t previousOutputPos = output.pos;
+                        const size_t result = ZSTD_decompressStream(context.get(), &output, &input);
+
+                        if(ZSTD_isError(result) || (input.pos == previousInputPos && output.pos == previousOutputPos)) {
+                            return Ktx2Error::DecompressionFailed;
+                        }
+                    }
+                }
+            }
+
+            return Ktx2Error::None;
+        }
+#endif
+
+        return Ktx2Error::UnsupportedSupercompression;
+    }
+
+    // Reads every level of an in memory file. A null policy decodes the levels one after another.
+    [[nodiscard]]
+    static UniqueTexture readKtx2Levels(const cputex::execution::ParallelPolicy *policy, cputex::span<const cputex::byte> fileData, Ktx2Error &error) {
+        const Ktx2Header ktx2Header = parseKtx2Header(fileData, error);
+
+        if(error != Ktx2Error::None) {
+            return {};
+        }
+
+        if(!isSupportedSupercompression(ktx2Header.supercompression)) {
+            error = Ktx2Error::UnsupportedSupercompression;
+            return {};
+        }
+
+        const cputex::CountType mips = ktx2Header.params.mips;
+
+        for(cputex::CountType mip = 0; mip < mips; ++mip) {
+            const Ktx2Level &level = ktx2Header.levels[mip];
+
+            if(level.byteOffset > static_cast<cputex::SizeType>(fileData.size_bytes()) ||
+               level.byteLength > static_cast<cputex::SizeType>(fileData.size_bytes()) - level.byteOffset) {
+                error = Ktx2Error::FileTooSmall;
+                return {};
+            }
+        }
+
+        UniqueTexture texture{ cputex::uninitialized, ktx2Header.params };
+
+        if(texture.empty()) {
+            error = Ktx2Error::TextureCreationFailed;
+            return {};
+        }
+
+        const TextureLayout layout = packedLayout(ktx2Header.params);
+        cputex::TextureSpan textureSpan{ texture };
+        std::array<Ktx2Error, maxMipCount> levelErrors{};
+
+        auto decodeMip = [&](cputex::SizeType mipIndex) {
+            const auto mip = static_cast<cputex::CountType>(mipIndex);
+            const Ktx2Level &level = ktx2Header.levels[mip];
+            levelErrors[mip] = decodeLevel(ktx2Header.supercompression, fileData.subspan(static_cast<size_t>(level.byteOffset), static_cast<size_t>(level.byteLength)),
+                                           layout.mipByteSizes[mip], textureSpan, mip);
+        };
+
+        if(policy != nullptr) {
+            cputex::execution::parallelFor(policy->executor(), mips, decodeMip);
+        } else {
+            for(cputex::CountType mip = 0; mip < mips; ++mip) {
+                decodeMip(mip);
+            }
+        }
+
+        for(cputex::CountType mip = 0; mip < mips; ++mip) {
+            if(levelErrors[mip] != Ktx2Error::None) {
+                error = levelErrors[mip];
+                return {};
+            }
+        }
+
+        return texture;
+    }
+
+    UniqueTexture readKtx2(cputex::span<const cputex::byte> fileData, Ktx2Error &error) {
+        return readKtx2Levels(nullptr, fileData, error);
+    }
+
+    UniqueTexture readKtx2(const cputex::execution::ParallelPolicy &policy, cputex::span<const cputex::byte> fileData, Ktx2Error &error) {
+        return readKtx2Levels(&policy, fileData, error);
+    }
+
+    [[nodiscard]]
+    static UniqueTexture readKtx2File(const cputex::execution::ParallelPolicy *policy, const std::filesystem::path &path, Ktx2Error &error) {
+        const cputex::span<cputex::byte> mapping = internal::mapFile(path);
+
+        if(mapping.empty()) {
+            error = (std::filesystem::exists(path)) ? Ktx2Error::FileMapFailed : Ktx2Error::FileOpenFailed;
+            return {};
+        }
+
+        UniqueTexture texture = readKtx2Levels(policy, mapping, error);
+        internal::unmapFile(mapping);
+        return texture;
+    }
+
+    UniqueTexture readKtx2(const std::filesystem::path &path, Ktx2Error &error) {
+        return readKtx2File(nullptr, path, error);
+    }
+
+    UniqueTexture readKtx2(const cputex::execution::ParallelPolicy &policy, const std::filesystem::path &path, Ktx2Error &error) {
+        return readKtx2File(&policy, path, error);
+    }
+
+    // Params for a texture holding only one mip of the file's texture.
+    [[nodiscard]]
+    static TextureParams mipParams(const Ktx2Header &ktx2Header, cputex::CountType mip) noexcept {
+        TextureParams params = ktx2Header.params;
+        params.extent = packedLayout(params).mipExtents[mip];
+        params.mips = 1;
+        return params;
+    }
+
+    UniqueTexture readKtx2Mip(cputex::span<const cputex::byte> fileData, cputex::CountType mip, Ktx2Error &error) {
+        const Ktx2Header ktx2Header = parseKtx2Header(fileData, error);
+
+        if(error != Ktx2Error::None) {
+            return {};
+        }
+
+        if(mip < 0 || mip >= ktx2Header.params.mips) {
+            error = Ktx2Error::InvalidMip;
+            return {};
+        }
+
+        if(!isSupportedSupercompression(ktx2Header.supercompression)) {
+            error = Ktx2Error::UnsupportedSupercompression;
+            return {};
+        }
+
+        const Ktx2Level &level = ktx2Header.levels[mip];
+
+        if(level.byteOffset > static_cast<cputex::SizeType>(fileData.size_bytes()) ||
+           level.byteLength > static_cast<cputex::SizeType>(fileData.size_bytes()) - level.byteOffset) {
+            error = Ktx2Error::FileTooSmall;
+            return {};
+        }
+
+        UniqueTexture texture{ cputex::uninitialized, mipParams(ktx2Header, mip) };
+
+        if(texture.empty()) {
+            error = Ktx2Error::TextureCreationFailed;
+            return {};
+        }
+
+        error = decodeLevel(ktx2Header.supercompression, fileData.subspan(static_cast<size_t>(level.byteOffset), static_cast<size_t>(level.byteLength)),
+                            packedLayout(ktx2Header.params).mipByteSizes[mip], cputex::TextureSpan(texture), 0);
+
+        return (error == Ktx2Error::None) ? std::move(texture) : UniqueTexture{};
+    }
+
+    UniqueTexture readKtx2Mip(const std::filesystem::path &path, cputex::CountType mip, Ktx2Error &error) {
+        std::ifstream file(path, std::ios::binary);
+
+        if(!file) {
+            error = Ktx2Error::FileOpenFailed;
+            return {};
+        }
+
+        // The level index follows the header, and its size is only known once the header is parsed.
+        std::vector<cputex::byte> headerData(static_cast<size_t>(kKtx2HeaderByteSize));
+        Ktx2Header ktx2Header;
+
+        for(int attempt = 0; attempt < 2; ++attempt) {
+            file.seekg(0);
+            file.read(reinterpret_cast<char *>(headerData.data()), static_cast<std::streamsize>(headerData.size()));
+            ktx2Header = parseKtx2Header(cputex::span<const cputex::byte>(headerData.data(), static_cast<size_t>(file.gcount())), error);
+
+            if(error != Ktx2Error::FileTooSmall || ktx2Header.byteSize <= static_cast<cputex::SizeType>(headerData.size())) {
+                break;
+            }
+
+            file.clear();
+            headerData.resize(static_cast<size_t>(ktx2Header.byteSize));
+        }
+
+        if(error != Ktx2Error::None) {
+            return {};
+        }
+
+        if(mip < 0 || mip >= ktx2Header.params.mips) {
+            error = Ktx2Error::InvalidMip;
+            return {};
+        }
+
+        if(!isSupportedSupercompression(ktx2Header.supercompression)) {
+            error = Ktx2Error::UnsupportedSupercompression;
+            return {};
+        }
+
+        UniqueTexture texture{ cputex::uninitialized, mipParams(ktx2Header, mip) };
+
+        if(texture.empty()) {
+            error = Ktx2Error::TextureCreationFailed;
+            return {};
+        }
+
+        const Ktx2Level &level = ktx2Header.levels[mip];
+        const cputex::SizeType surfaceByteSize = packedLayout(ktx2Header.params).mipByteSizes[mip];
+        cputex::TextureSpan textureSpan{ texture };
+
+        file.seekg(static_cast<std::streamoff>(level.byteOffset));
+
+        if(ktx2Header.supercompression == Ktx2Supercompression::None) {
+            // Read straight into the surfaces.
+            for(cputex::CountType arraySlice = 0; arraySlice < textureSpan.arraySize(); ++arraySlice) {
+                for(cputex::CountType face = 0; face < textureSpan.faces(); ++face) {
+                    file.read(reinterpret_cast<char *>(textureSpan.accessMipSurfaceData(arraySlice, face, 0).data()), static_cast<std::streamsize>(surfaceByteSize));
+
+                    if(file.gcount() != static_cast<std::streamsize>(surfaceByteSize)) {
+                        error = (file.eof()) ? Ktx2Error::FileTooSmall : Ktx2Error::FileReadFailed;
+                        return {};
+                    }
+                }
+            }
+
+            return texture;
+        }
+
+        std::vector<cputex::byte> levelData(static_cast<size_t>(level.byteLength));
+        file.read(reinterpret_cast<char *>(levelData.data()), static_cast<std::streamsize>(levelData.size()));
+
+        if(file.gcount() != static_cast<std::streamsize>(levelData.size())) {
+            error = (file.eof()) ? Ktx2Error::FileTooSmall : Ktx2Error::FileReadFailed;
+            return {};
+        }
+
+        error = decodeLevel(ktx2Header.supercompression, levelData, surfaceByteSize, textureSpan, 0);
+
+        return (error == Ktx2Error::None) ? std::move(texture) : UniqueTexture{};
+    }
+
+    // Calls func with the tightly packed bytes of one mip level, in KTX2's array slice, face order. Packed surfaces
+    // come in one piece each, surfaces with padded rows a row at a time.
+    template<class Func>
+    [[nodiscard]]
+    static bool forEachLevelChunk(const TextureView &texture, cputex::CountType mip, Func &&func) {
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(texture.format());
+
+        for(cputex::CountType arraySlice = 0; arraySlice < texture.arraySize(); ++arraySlice) {
+            for(cputex::CountType face = 0; face < texture.faces(); ++face) {
+                const SurfaceView surface = (SurfaceView)texture.getMipSurface(arraySlice, face, mip);
+
+                if(surface.isPacked()) {
+                    if(!func(surface.getData().first(static_cast<size_t>(surface.sizeInBytes())))) {
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                const cputex::ExtentComponent blockRows = (surface.extent().y + info.blockExtent.y - 1) / info.blockExtent.y;
+                const cputex::ExtentComponent volumeSlices = (surface.extent().z + info.blockExtent.z - 1) / info.blockExtent.z;
+
+                for(cputex::ExtentComponent volumeSlice = 0; volumeSlice < volumeSlices; ++volumeSlice) {
+                    for(cputex::ExtentComponent blockRow = 0; blockRow < blockRows; ++blockRow) {
+                        if(!func(surface.getRowData(blockRow, volumeSlice))) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+#if defined(CPUTEX_ZSTD)
+    // Compresses one level as a single zstd frame, fed surface by surface so the level is never gathered first.
+    [[nodiscard]]
+    static bool compressLevel(const TextureView &texture, cputex::CountType mip, cputex::SizeType levelByteSize, int compressionLevel, std::vector<cputex::byte> &compressedData) {
+        std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ ZSTD_createCCtx(), &ZSTD_freeCCtx };
+
+        if(context == nullptr ||
+           ZSTD_isError(ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, compressionLevel)) ||
+           ZSTD_isError(ZSTD_CCtx_setPledgedSrcSize(context.get(), static_cast<unsigned long long>(levelByteSize)))) {
+            return false;
+        }
+
+        // Sized to the worst case, so the output never runs out of room.
+        compressedData.resize(ZSTD_compressBound(static_cast<size_t>(levelByteSize)));
+        ZSTD_outBuffer output{ compressedData.data(), compressedData.size(), 0 };
+
+        const bool compressed = forEachLevelChunk(texture, mip, [&](cputex::span<const cputex::byte> chunk) {
+            ZSTD_inBuffer input{ chunk.data(), chunk.size_bytes(), 0 };
+
+            while(input.pos < input.size) {
+                if(ZSTD_isError(ZSTD_compressStream2(context.get(), &output, &input, ZSTD_e_continue))) {
+                    return false;
+                }
+            }
+
+            return true;
+        });
+
+        if(!compressed) {
+            return false;
+        }
+
+        ZSTD_inBuffer input{ nullptr, 0, 0 };
+        size_t remaining;
+
+        do {
+            remaining = ZSTD_compressStream2(context.get(), &output, &input, ZSTD_e_end);
+
+            if(ZSTD_isError(remaining)) {
+                return false;
+            }
+        } while(remaining != 0);
+
+        compressedData.resize(output.pos);
+        return true;
+    }
+#endif
+
+    [[nodiscard]]
+    static Ktx2Error writeKtx2Levels(const cputex::execution::ParallelPolicy *policy, const TextureView &texture, const Ktx2WriteCallback &callback, const Ktx2WriteOptions &options) {
+        if(texture.empty()) {
+            return Ktx2Error::EmptyTexture;
+        }
+
+        if(!isSupportedSupercompression(options.supercompression)) {
+            return Ktx2Error::UnsupportedSupercompression;
+        }
+
+        const gpufmt::vulkan::FormatConversion conversion = gpufmt::vulkan::translateFormat(texture.format());
+
+        if(!conversion) {
+            return Ktx2Error::UnsupportedFormat;
+        }
+
+        const uint32_t vkFormat = static_cast<uint32_t>(*conversion.exact);
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(texture.format());
+        const cputex::CountType mips = texture.mips();
+
+        TextureParams params;
+        params.format = texture.format();
+        params.dimension = texture.dimension();
+        params.extent = texture.extent();
+        params.arraySize = texture.arraySize();
+        params.faces = texture.faces();
+        params.mips = mips;
+
+        const TextureLayout layout = packedLayout(params);
+        const cputex::SizeType surfacesPerLevel = static_cast<cputex::SizeType>(texture.arraySize()) * texture.faces();
+
+        std::array<std::vector<cputex::byte>, maxMipCount> compressedLevels;
+
+#if defined(CPUTEX_ZSTD)
+        if(options.supercompression == Ktx2Supercompression::Zstandard) {
+            std::array<bool, maxMipCount> levelCompressed{};
+
+            auto compressMip = [&](cputex::SizeType mipIndex) {
+                const auto mip = static_cast<cputex::CountType>(mipIndex);
+                levelCompressed[mip] = compressLevel(texture, mip, layout.mipByteSizes[mip] * surfacesPerLevel, options.zstdCompressionLevel, compressedLevels[mip]);
+            };
+
+            if(policy != nullptr) {
+                cputex::execution::parallelFor(policy->executor(), mips, compressMip);
+            } else {
+                for(cputex::CountType mip = 0; mip < mips; ++mip) {
+                    compressMip(mip);
+                }
+            }
+
+            if(!std::all_of(levelCompressed.begin(), levelCompressed.begin() + mips, [](bool compressed) { return compressed; })) {
+                return Ktx2Error::CompressionFailed;
+            }
+        }
+#else
+        (void)policy;
+#endif
+
+        const bool supercompressed = (options.supercompression != Ktx2Supercompression::None);
+
+        Ktx2FileHeader header{};
+        header.identifier = kKtx2Identifier;
+        header.vkFormat = vkFormat;
+        header.typeSize = vulkanTypeSize(vkFormat);
+        header.pixelWidth = static_cast<uint32_t>(params.extent.x);
+        header.pixelHeight = (params.dimension == TextureDimension::Texture1D) ? 0u : static_cast<uint32_t>(params.extent.y);
+        header.pixelDepth = (params.dimension == TextureDimension::Texture3D) ? static_cast<uint32_t>(params.extent.z) : 0u;
+        header.layerCount = (params.arraySize > 1) ? static_cast<uint32_t>(params.arraySize) : 0u;
+        header.faceCount = static_cast<uint32_t>(params.faces);
+        header.levelCount = static_cast<uint32_t>(mips);
+        header.supercompressionScheme = static_cast<uint32_t>(options.supercompression);
+        header.dfdByteOffset = static_cast<uint32_t>(kKtx2HeaderByteSize + mips * sizeof(Ktx2FileLevel));
+        std::array<Ktx2FileDfdSample, 4> dfdSamples{};
+        const int dfdSampleCount = vulkanDfdSamples(vkFormat, dfdSamples);
+        const uint32_t dfdSamplesByteSize = static_cast<uint32_t>(dfdSampleCount * sizeof(Ktx2FileDfdSample));
+
+        header.dfdByteLength = sizeof(Ktx2FileDfd) + dfdSamplesByteSize;
+        header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+        header.kvdByteLength = kKtx2KvdByteLength;
+
+        Ktx2FileDfd dfd{};
+        dfd.dfdTotalSize = header.dfdByteLength;
+        dfd.versionNumberAndDescriptorBlockSize = kKhrDfVersion | ((header.dfdByteLength - sizeof(uint32_t)) << 16);
+        dfd.colorModelPrimariesTransferFlags = vulkanColorModel(vkFormat) | (kKhrDfPrimariesBt709 << 8) |
+                                               ((isVulkanSrgbFormat(vkFormat) ? kKhrDfTransferSrgb : kKhrDfTransferLinear) << 16);
+        dfd.texelBlockDimensions = static_cast<uint32_t>(info.blockExtent.x - 1) | (static_cast<uint32_t>(info.blockExtent.y - 1) << 8) |
+                                   (static_cast<uint32_t>(info.blockExtent.z - 1) << 16);
+        // Supercompressed files leave the plane sizes unset.
+        dfd.bytesPlanes0To3 = (supercompressed) ? 0u : static_cast<uint32_t>(info.blockByteSize);
+
+        // Uncompressed levels start on a multiple of the block size and of 4, supercompressed levels anywhere.
+        const cputex::SizeType levelAlignment = (supercompressed) ? 1 : std::lcm(static_cast<cputex::SizeType>(info.blockByteSize), cputex::SizeType(4));
+        const cputex::SizeType headersByteSize = header.kvdByteOffset + header.kvdByteLength;
+
+        // Smallest level first.
+        std::array<Ktx2FileLevel, maxMipCount> levels{};
+        cputex::SizeType byteOffset = headersByteSize;
+
+        for(cputex::CountType mip = mips - 1; mip >= 0; --mip) {
+            byteOffset = ((byteOffset + levelAlignment - 1) / levelAlignment) * levelAlignment;
+
+            Ktx2FileLevel &level = levels[mip];
+            level.byteOffset = static_cast<uint64_t>(byteOffset);
+            level.uncompressedByteLength = static_cast<uint64_t>(layout.mipByteSizes[mip] * surfacesPerLevel);
+            level.byteLength = (supercompressed) ? static_cast<uint64_t>(compressedLevels[mip].size()) : level.uncompressedByteLength;
+
+            byteOffset += static_cast<cputex::SizeType>(level.byteLength);
+        }
+
+        std::vector<cputex::byte> headers(static_cast<size_t>(headersByteSize), cputex::byte{ 0 });
+        std::memcpy(headers.data(), &header, sizeof(header));
+        std::memcpy(headers.data() + kKtx2HeaderByteSize, levels.data(), mips * sizeof(Ktx2FileLevel));
+        std::memcpy(headers.data() + header.dfdByteOffset, &dfd, sizeof(dfd));
+        std::memcpy(headers.data() + header.dfdByteOffset + sizeof(dfd), dfdSamples.data(), dfdSamplesByteSize);
+        std::memcpy(headers.data() + header.kvdByteOffset, &kKtx2WriterKeyValueByteLength, sizeof(uint32_t));
+        std::memcpy(headers.data() + header.kvdByteOffset + sizeof(uint32_t), kKtx2WriterKeyValue, kKtx2WriterKeyValueByteLength);
+
+        if(!callback(headers)) {
+            return Ktx2Error::FileWriteFailed;
+        }
+
+        cputex::SizeType writtenByteSize = headersByteSize;
+        // Levels are at most 32 byte aligned, for 32 byte blocks.
+        constexpr std::array<cputex::byte, 32> padding{};
+
+        for(cputex::CountType mip = mips - 1; mip >= 0; --mip) {
+            const auto levelOffset = static_cast<cputex::SizeType>(levels[mip].byteOffset);
+
+            if(levelOffset > writtenByteSize && !callback(cputex::span<const cputex::byte>(padding.data(), static_cast<size_t>(levelOffset - writtenByteSize)))) {
+                return Ktx2Error::FileWriteFailed;
+            }
+
+            const bool written = (supercompressed) ? callback(compressedLevels[mip]) : forEachLevelChunk(texture, mip, callback);
+
+            if(!written) {
+                return Ktx2Error::FileWriteFailed;
+            }
+
+            writtenByteSize = levelOffset + static_cast<cputex::SizeType>(levels[mip].byteLength);
+        }
+
+        return Ktx2Error::None;
+    }
+
+    Ktx2Error writeKtx2(TextureView texture, const Ktx2WriteCallback &callback, const Ktx2WriteOptions &options) {
+        return writeKtx2Levels(nullptr, texture, callback, options);
+    }
+
+    Ktx2Error writeKtx2(const cputex::execution::ParallelPolicy &policy, TextureView texture, const Ktx2WriteCallback &callback, const Ktx2WriteOptions &options) {
+        return writeKtx2Levels(&policy, texture, callback, options);
+    }
+
+    [[nodiscard]]
+    static Ktx2Error writeKtx2File(const cputex::execution::ParallelPolicy *policy, const TextureView &texture, const std::filesystem::path &path, const Ktx2WriteOptions &options) {
+        const int fileDescriptor = internal::createFile(path);
+
+        if(fileDescriptor < 0) {
+            return Ktx2Error::FileOpenFailed;
+        }
+
+        Ktx2Error error = writeKtx2Levels(policy, texture, [fileDescriptor](cputex::span<const cputex::byte> data) {
+            return internal::writeFile(fileDescriptor, data);
+        }, options);
+
+        // Write errors can be deferred until the file is closed.
+        if(!internal::closeFile(fileDescriptor) && error == Ktx2Error::None) {
+            error = Ktx2Error::FileWriteFailed;
+        }
+
+        return error;
+    }
+
+    Ktx2Error writeKtx2(TextureView texture, const std::filesystem::path &path, const Ktx2WriteOptions &options) {
+        return writeKtx2File(nullptr, texture, path, options);
+    }
+
+    Ktx2Error writeKtx2(const cputex::execution::ParallelPolicy &policy, TextureView texture, const std::filesystem::path &path, const Ktx2WriteOptions &options) {
+        return writeKtx2File(&policy, texture, path, options);
+    }
+}
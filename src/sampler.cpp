@@ -1,12 +1,186 @@
 #include "cputex/sampler.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
 
 namespace cputex {
+    namespace {
+        // The most texels in a block of any format, a 12x12 ASTC block.
+        constexpr cputex::CountType kMaxBlockTexelCount = 144;
+
+        template<class T>
+        concept SampleVector = requires {
+            typename T::value_type;
+            T::length();
+        };
+
+        // Only samples with floating point components are blended.
+        template<class T>
+        [[nodiscard]]
+        constexpr bool isFilterable() noexcept {
+            if constexpr(std::is_arithmetic_v<T>) {
+                return std::floating_point<T>;
+            } else if constexpr(SampleVector<T>) {
+                return std::floating_point<typename T::value_type>;
+            } else {
+                return false;
+            }
+        }
+
+        template<class T>
+        [[nodiscard]]
+        glm::dvec4 toDVec4(const T &sample) noexcept {
+            glm::dvec4 result{ 0.0 };
+
+            if constexpr(std::is_arithmetic_v<T>) {
+                result.x = static_cast<double>(sample);
+            } else if constexpr(SampleVector<T>) {
+                for(int i = 0; i < static_cast<int>(T::length()); ++i) {
+                    result[i] = static_cast<double>(sample[i]);
+                }
+            }
+
+            return result;
+        }
+
+        template<class T>
+        [[nodiscard]]
+        T fromDVec4(const glm::dvec4 &value) noexcept {
+            T result{};
+
+            if constexpr(std::is_arithmetic_v<T>) {
+                result = static_cast<T>(value.x);
+            } else if constexpr(SampleVector<T>) {
+                for(int i = 0; i < static_cast<int>(T::length()); ++i) {
+                    result[i] = static_cast<typename T::value_type>(value[i]);
+                }
+            }
+
+            return result;
+        }
+
+        // Returns -1 when the coordinate falls on the border.
+        [[nodiscard]]
+        int64_t resolveAddress(int64_t coordinate, int64_t extent, AddressMode mode) noexcept {
+            switch(mode) {
+            case AddressMode::Wrap:
+            {
+                const int64_t wrapped = coordinate % extent;
+                return (wrapped < 0) ? wrapped + extent : wrapped;
+            }
+            case AddressMode::Mirror:
+            {
+                const int64_t period = extent * 2;
+                int64_t mirrored = coordinate % period;
+                mirrored = (mirrored < 0) ? mirrored + period : mirrored;
+                return (mirrored < extent) ? mirrored : period - 1 - mirrored;
+            }
+            case AddressMode::Clamp:
+                return std::clamp<int64_t>(coordinate, 0, extent - 1);
+            case AddressMode::Border:
+            default:
+                return (coordinate >= 0 && coordinate < extent) ? coordinate : -1;
+            }
+        }
+
+        // Keeps texel positions far outside the texture, or not finite, within what the integer math handles.
+        [[nodiscard]]
+        double limitTexelPosition(double position) noexcept {
+            constexpr double kLimit = double(int64_t(1) << 40);
+            return std::isnan(position) ? 0.0 : std::clamp(position, -kLimit, kLimit);
+        }
+
+        [[nodiscard]]
+        cputex::SizeType texelIndexInBlock(const cputex::Extent &texel, const cputex::Extent &blockExtent) noexcept {
+            const cputex::SizeType x = texel.x % blockExtent.x;
+            const cputex::SizeType y = texel.y % blockExtent.y;
+            const cputex::SizeType z = texel.z % blockExtent.z;
+            return z * (blockExtent.y * blockExtent.x) + y * blockExtent.x + x;
+        }
+
+        // Texels decoded by the same call to Sampler::decodeBlock.
+        [[nodiscard]]
+        bool isSameBlock(const cputex::Extent &first, const cputex::Extent &second, const cputex::Extent &blockExtent) noexcept {
+            return first.x / blockExtent.x == second.x / blockExtent.x &&
+                first.y / blockExtent.y == second.y / blockExtent.y &&
+                first.z == second.z;
+        }
+    }
+
+    // Blends the taps of a sample. Taps are summed as doubles and converted back to the type the format samples to, or
+    // the tap with the most weight is kept for formats that aren't filterable.
+    class Sampler::Accumulator {
+    public:
+        void add(const gpufmt::SampleVariant &sample, double weight) noexcept {
+            if(weight <= 0.0) {
+                return;
+            }
+
+            if(weight > mHeaviestWeight) {
+                mHeaviest = sample;
+                mHeaviestWeight = weight;
+            }
+
+            mSum += std::visit([](const auto &typedSample) { return toDVec4(typedSample); }, sample) * weight;
+            mWeight += weight;
+        }
+
+        [[nodiscard]]
+        gpufmt::SampleVariant result() const noexcept {
+            if(mHeaviestWeight <= 0.0) {
+                return {};
+            }
+
+            return std::visit([this](const auto &typedSample) -> gpufmt::SampleVariant {
+                using SampleType = std::decay_t<decltype(typedSample)>;
+
+                if constexpr(isFilterable<SampleType>()) {
+                    return fromDVec4<SampleType>(mSum / mWeight);
+                } else {
+                    return typedSample;
+                }
+            }, mHeaviest);
+        }
+
+    private:
+        gpufmt::SampleVariant mHeaviest;
+        glm::dvec4 mSum{ 0.0 };
+        double mWeight = 0.0;
+        double mHeaviestWeight = 0.0;
+    };
+
     Sampler::Sampler(TextureView texture) noexcept
+        : Sampler(texture, SamplerDesc{})
+    {}
+
+    Sampler::Sampler(TextureView texture, const SamplerDesc &desc) noexcept
         : mTexture(texture)
         , mSampler(texture.format())
-    {}
+        , mDesc(desc)
+    {
+        mDesc.maxAnisotropy = std::max(mDesc.maxAnisotropy, cputex::CountType(1));
+
+        if(mTexture.empty()) {
+            return;
+        }
+
+        // The border color takes the type the format samples to, which is only known from a decoded texel.
+        std::array<gpufmt::SampleVariant, kMaxBlockTexelCount> blockSamples;
+
+        if(!decodeBlock(cputex::Extent{ 0, 0, 0 }, blockSamples, 0, 0, 0)) {
+            return;
+        }
+
+        const glm::dvec4 borderColor{ mDesc.borderColor };
+        mBorderSample = std::visit([&borderColor](const auto &typedSample) -> gpufmt::SampleVariant {
+            using SampleType = std::decay_t<decltype(typedSample)>;
+            return fromDVec4<SampleType>(borderColor);
+        }, blockSamples[0]);
+    }
 
     const cputex::Extent &Sampler::blockExtent() const noexcept {
         return mSampler.blockExtent();
@@ -15,33 +189,103 @@ namespace cputex {
     cputex::CountType Sampler::blockTexelCount() const noexcept {
         return static_cast<cputex::CountType>(mSampler.blockTexelCount());
     }
-    
+
     gpufmt::SampleVariant Sampler::sample(glm::vec3 uvCoords, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
-        std::array<gpufmt::SampleVariant, 144> blockSamples;
+        std::array<gpufmt::SampleVariant, kMaxBlockTexelCount> blockSamples;
         return sample(uvCoords, blockSamples, arraySlice, face, mip);
     }
 
     gpufmt::SampleVariant Sampler::sample(glm::vec3 uvCoords, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+        if(mTexture.empty() || mip < 0 || mip >= mTexture.mips()) {
+            return {};
+        }
+
+        if(blockSamples.size() < static_cast<size_t>(blockTexelCount())) {
+            return {};
+        }
+
+        Accumulator accumulator;
+        accumulateMip(accumulator, uvCoords, mDesc.magFilter, 1.0, blockSamples, arraySlice, face, mip);
+        return accumulator.result();
+    }
+
+    gpufmt::SampleVariant Sampler::sampleLevel(glm::vec3 uvCoords, float lod, cputex::CountType arraySlice, cputex::CountType face) const noexcept {
+        std::array<gpufmt::SampleVariant, kMaxBlockTexelCount> blockSamples;
+        return sampleLevel(uvCoords, lod, blockSamples, arraySlice, face);
+    }
+
+    gpufmt::SampleVariant Sampler::sampleLevel(glm::vec3 uvCoords, float lod, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face) const noexcept {
         if(mTexture.empty()) {
             return {};
         }
 
-        uvCoords.x = (uvCoords.x <= 1.0f) ? uvCoords.x : uvCoords.x - std::trunc(uvCoords.x);
-        uvCoords.y = (uvCoords.y <= 1.0f) ? uvCoords.y : uvCoords.y - std::trunc(uvCoords.y);
-        uvCoords.z = (uvCoords.z <= 1.0f) ? uvCoords.z : uvCoords.z - std::trunc(uvCoords.z);
+        if(blockSamples.size() < static_cast<size_t>(blockTexelCount())) {
+            return {};
+        }
 
-        const Extent &extent = mTexture.extent(mip);
+        Accumulator accumulator;
+        accumulateLevel(accumulator, uvCoords, lod, 1.0, blockSamples, arraySlice, face);
+        return accumulator.result();
+    }
 
-        gpufmt::Extent texel;
-        texel.x = static_cast<int>(std::floor(((extent.x - 1.0f) * uvCoords.x) + 0.5f));
-        texel.y = static_cast<int>(std::floor(((extent.y - 1.0f) * uvCoords.y) + 0.5f));
-        texel.z = static_cast<int>(std::floor(((extent.z - 1.0f) * uvCoords.z) + 0.5f));
+    gpufmt::SampleVariant Sampler::sampleGrad(glm::vec3 uvCoords, glm::vec3 ddx, glm::vec3 ddy, cputex::CountType arraySlice, cputex::CountType face) const noexcept {
+        std::array<gpufmt::SampleVariant, kMaxBlockTexelCount> blockSamples;
+        return sampleGrad(uvCoords, ddx, ddy, blockSamples, arraySlice, face);
+    }
 
-        return load(texel, blockSamples, arraySlice, face, mip);
+    gpufmt::SampleVariant Sampler::sampleGrad(glm::vec3 uvCoords, glm::vec3 ddx, glm::vec3 ddy, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face) const noexcept {
+        if(mTexture.empty()) {
+            return {};
+        }
+
+        if(blockSamples.size() < static_cast<size_t>(blockTexelCount())) {
+            return {};
+        }
+
+        // The footprint of a pixel in texels of the base mip, along each screen axis.
+        const cputex::Extent &extent = mTexture.extent(0);
+        glm::vec3 texelScale{ float(extent.x), float(extent.y), float(extent.z) };
+
+        switch(mTexture.dimension()) {
+        case TextureDimension::Texture1D:
+            texelScale.y = 0.0f;
+            [[fallthrough]];
+        case TextureDimension::Texture2D:
+        case TextureDimension::TextureCube:
+            texelScale.z = 0.0f;
+            break;
+        default:
+            break;
+        }
+
+        const float lengthX = glm::length(ddx * texelScale);
+        const float lengthY = glm::length(ddy * texelScale);
+        const float majorLength = std::max(lengthX, lengthY);
+        const float minorLength = std::min(lengthX, lengthY);
+
+        Accumulator accumulator;
+
+        if(mDesc.maxAnisotropy > 1 && majorLength > minorLength) {
+            // Spread samples along the major axis, each at the level of detail of the minor axis, up to maxAnisotropy.
+            const float ratio = (minorLength > 0.0f) ? majorLength / minorLength : float(mDesc.maxAnisotropy);
+            const cputex::CountType sampleCount = std::min(static_cast<cputex::CountType>(std::ceil(std::min(ratio, float(mDesc.maxAnisotropy)))), mDesc.maxAnisotropy);
+            const float lod = std::log2(majorLength / float(sampleCount));
+            const glm::vec3 majorAxis = (lengthX >= lengthY) ? ddx : ddy;
+            const double weight = 1.0 / sampleCount;
+
+            for(cputex::CountType i = 0; i < sampleCount; ++i) {
+                const float offset = (float(i) + 0.5f) / float(sampleCount) - 0.5f;
+                accumulateLevel(accumulator, uvCoords + majorAxis * offset, lod, weight, blockSamples, arraySlice, face);
+            }
+        } else {
+            accumulateLevel(accumulator, uvCoords, std::log2(majorLength), 1.0, blockSamples, arraySlice, face);
+        }
+
+        return accumulator.result();
     }
 
     gpufmt::SampleVariant Sampler::load(cputex::Extent texel, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
-        std::array<gpufmt::SampleVariant, 144> blockSamples;
+        std::array<gpufmt::SampleVariant, kMaxBlockTexelCount> blockSamples;
         return load(texel, blockSamples, arraySlice, face, mip);
     }
 
@@ -50,36 +294,175 @@ namespace cputex {
             return {};
         }
 
-        if(blockSamples.size() < blockTexelCount()) {
+        if(blockSamples.size() < static_cast<size_t>(blockTexelCount())) {
+            return {};
+        }
+
+        if(!decodeBlock(texel, blockSamples, arraySlice, face, mip)) {
             return {};
         }
 
+        return blockSamples[texelIndexInBlock(texel, gpufmt::formatInfo(mTexture.format()).blockExtent)];
+    }
+
+    bool Sampler::decodeBlock(cputex::Extent texel, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+        if(mip < 0 || mip >= mTexture.mips()) {
+            return false;
+        }
+
+        const auto &surfaceExtent = mTexture.extent(mip);
+
+        if(texel.x < 0 || texel.y < 0 || texel.z < 0 ||
+           texel.x >= surfaceExtent.x || texel.y >= surfaceExtent.y || texel.z >= surfaceExtent.z) {
+            return false;
+        }
+
         auto surface = mTexture.get2DSurfaceData(arraySlice, face, mip, texel.z);
 
         const auto &formatInfo = gpufmt::formatInfo(mTexture.format());
         cputex::Extent bloxel = texel / formatInfo.blockExtent;
 
-        const auto &surfaceExtent = mTexture.extent(mip);
         cputex::Extent surfaceBlockExtent = (surfaceExtent + (formatInfo.blockExtent - cputex::Extent{cputex::ExtentComponent(1), cputex::ExtentComponent(1), cputex::ExtentComponent(1)})) / formatInfo.blockExtent;
 
+        // Only the block row holding the texel is handed to the sampler, so the padding between rows doesn't matter.
         gpufmt::Surface<const cputex::byte> blockSurface;
-        blockSurface.blockData = surface;
-        blockSurface.extentInBlocks = surfaceBlockExtent;
+        blockSurface.blockData = surface.subspan(bloxel.y * mTexture.rowPitch(mip), surfaceBlockExtent.x * formatInfo.blockByteSize);
+        blockSurface.extentInBlocks = cputex::Extent{ surfaceBlockExtent.x, 1, 1 };
 
-        gpufmt::BlockSampleError error = mSampler.variantSampleTo(blockSurface, bloxel, blockSamples);
+        return mSampler.variantSampleTo(blockSurface, cputex::Extent{ bloxel.x, 0, 0 }, blockSamples) == gpufmt::BlockSampleError::None;
+    }
 
-        if(error != gpufmt::BlockSampleError::None) {
-            return {};
+    void Sampler::accumulateMip(Accumulator &accumulator, glm::vec3 uvCoords, Filter filter, double weight, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face, cputex::CountType mip) const noexcept {
+        const cputex::Extent &extent = mTexture.extent(mip);
+
+        cputex::CountType axisCount = 2;
+
+        switch(mTexture.dimension()) {
+        case TextureDimension::Texture1D:
+            axisCount = 1;
+            break;
+        case TextureDimension::Texture3D:
+            axisCount = 3;
+            break;
+        default:
+            break;
         }
 
-        cputex::Extent texelInBlock;
-        texelInBlock.x = texel.x % formatInfo.blockExtent.x;
-        texelInBlock.y = texel.y % formatInfo.blockExtent.y;
-        texelInBlock.z = texel.z % formatInfo.blockExtent.z;
+        const std::array<AddressMode, 3> addressModes{ mDesc.addressU, mDesc.addressV, mDesc.addressW };
+
+        // Per axis, the one or two texels the sample lands between and their weights. Point filtering takes the texel
+        // holding the coordinate, linear filtering the two texels whose centers surround it.
+        std::array<std::array<int64_t, 2>, 3> axisTexels{};
+        std::array<std::array<double, 2>, 3> axisWeights{};
+        std::array<cputex::CountType, 3> axisTapCounts{ 1, 1, 1 };
 
-        cputex::ExtentComponent texelIndex = texelInBlock.z * (formatInfo.blockExtent.y * formatInfo.blockExtent.x) + texelInBlock.y * formatInfo.blockExtent.x + texelInBlock.x;
-        return blockSamples[texelIndex];
+        for(cputex::CountType axis = 0; axis < 3; ++axis) {
+            axisWeights[axis][0] = 1.0;
+
+            if(axis >= axisCount) {
+                continue;
+            }
+
+            const double position = limitTexelPosition(double(uvCoords[axis]) * double(extent[axis]));
+
+            if(filter == Filter::Point) {
+                axisTexels[axis][0] = static_cast<int64_t>(std::floor(position));
+            } else {
+                const double texelPosition = position - 0.5;
+                const double base = std::floor(texelPosition);
+                const double fraction = texelPosition - base;
+
+                axisTexels[axis] = { static_cast<int64_t>(base), static_cast<int64_t>(base) + 1 };
+                axisWeights[axis] = { 1.0 - fraction, fraction };
+                axisTapCounts[axis] = 2;
+            }
+        }
+
+        struct Tap {
+            cputex::Extent texel;
+            double weight = 0.0;
+            bool done = false;
+        };
+
+        std::array<Tap, 8> taps;
+        cputex::CountType tapCount = 0;
+
+        for(cputex::CountType z = 0; z < axisTapCounts[2]; ++z) {
+            for(cputex::CountType y = 0; y < axisTapCounts[1]; ++y) {
+                for(cputex::CountType x = 0; x < axisTapCounts[0]; ++x) {
+                    const double tapWeight = weight * axisWeights[0][x] * axisWeights[1][y] * axisWeights[2][z];
+
+                    if(tapWeight <= 0.0) {
+                        continue;
+                    }
+
+                    const std::array<int64_t, 3> coordinates{ axisTexels[0][x], axisTexels[1][y], axisTexels[2][z] };
+                    cputex::Extent texel{ 0, 0, 0 };
+                    bool onBorder = false;
+
+                    for(cputex::CountType axis = 0; axis < axisCount; ++axis) {
+                        const int64_t resolved = resolveAddress(coordinates[axis], extent[axis], addressModes[axis]);
+                        onBorder = onBorder || resolved < 0;
+                        texel[axis] = static_cast<cputex::ExtentComponent>(resolved);
+                    }
+
+                    if(onBorder) {
+                        accumulator.add(mBorderSample, tapWeight);
+                        continue;
+                    }
+
+                    taps[tapCount++] = Tap{ texel, tapWeight };
+                }
+            }
+        }
+
+        // Decode each block once, and take every tap that falls in it from the same decoded samples.
+        const cputex::Extent &formatBlockExtent = gpufmt::formatInfo(mTexture.format()).blockExtent;
+
+        for(cputex::CountType i = 0; i < tapCount; ++i) {
+            if(taps[i].done) {
+                continue;
+            }
+
+            const bool decoded = decodeBlock(taps[i].texel, blockSamples, arraySlice, face, mip);
+
+            for(cputex::CountType j = i; j < tapCount; ++j) {
+                if(taps[j].done || !isSameBlock(taps[i].texel, taps[j].texel, formatBlockExtent)) {
+                    continue;
+                }
+
+                if(decoded) {
+                    accumulator.add(blockSamples[texelIndexInBlock(taps[j].texel, formatBlockExtent)], taps[j].weight);
+                }
+
+                taps[j].done = true;
+            }
+        }
     }
 
+    void Sampler::accumulateLevel(Accumulator &accumulator, glm::vec3 uvCoords, float lod, double weight, cputex::span<gpufmt::SampleVariant> blockSamples, cputex::CountType arraySlice, cputex::CountType face) const noexcept {
+        const float maxLevel = float(mTexture.mips() - 1);
+
+        lod = std::isnan(lod) ? 0.0f : lod + mDesc.mipLodBias;
+        lod = std::min(std::max(lod, mDesc.minLod), mDesc.maxLod);
 
-}
\ No newline at end of file
+        // Magnifying when the footprint is no bigger than a texel, as GPUs do.
+        const Filter filter = (lod <= 0.0f) ? mDesc.magFilter : mDesc.minFilter;
+        lod = std::clamp(lod, 0.0f, maxLevel);
+
+        if(mDesc.mipFilter == Filter::Point) {
+            const auto mip = static_cast<cputex::CountType>(std::floor(lod + 0.5f));
+            accumulateMip(accumulator, uvCoords, filter, weight, blockSamples, arraySlice, face, std::min(mip, mTexture.mips() - 1));
+            return;
+        }
+
+        const auto mip = static_cast<cputex::CountType>(std::floor(lod));
+        const double fraction = double(lod) - double(mip);
+
+        accumulateMip(accumulator, uvCoords, filter, weight * (1.0 - fraction), blockSamples, arraySlice, face, mip);
+
+        if(fraction > 0.0) {
+            accumulateMip(accumulator, uvCoords, filter, weight * fraction, blockSamples, arraySlice, face, std::min(mip + 1, mTexture.mips() - 1));
+        }
+    }
+}
@@ -10,6 +10,24 @@ namespace cputex {
         : mTextureStorage(params, initialData, true)
     {}
 
+    SharedTexture::SharedTexture(cputex::Uninitialized, const TextureParams &params)
+        : mTextureStorage(cputex::uninitialized, params, true)
+    {}
+
+    SharedTexture::SharedTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter)
+    {
+        cputex::AdoptError error;
+        mTextureStorage = internal::TextureStorage(cputex::adoptMemory, params, data, std::move(deleter), true, error);
+    }
+
+    SharedTexture::SharedTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter, cputex::AdoptError &error)
+        : mTextureStorage(cputex::adoptMemory, params, data, std::move(deleter), true, error)
+    {}
+
+    SharedTexture::SharedTexture(UniqueTexture &&texture)
+        : mTextureStorage(texture.mTextureStorage.shareUnique())
+    {}
+
     SharedTexture::SharedTexture(const SharedTexture &other) noexcept
         : mTextureStorage(other.mTextureStorage)
     {
@@ -23,7 +41,6 @@ namespace cputex {
 
     SharedTexture::~SharedTexture() noexcept {
         if(mTextureStorage.decRef()) {
-            std::lock_guard writeLock(mBufferMutex);
             mTextureStorage.destroy();
         }
     }
@@ -32,7 +49,6 @@ namespace cputex {
         other.mTextureStorage.addRef();
         
         if(mTextureStorage.decRef()) {
-            std::lock_guard writeLock(mBufferMutex);
             mTextureStorage.destroy();
         }
 
@@ -43,7 +59,6 @@ namespace cputex {
 
     SharedTexture& SharedTexture::operator=(SharedTexture &&other) noexcept {
         if(mTextureStorage.decRef()) {
-            std::lock_guard writeLock(mBufferMutex);
             mTextureStorage.destroy();
         }
 
@@ -100,6 +115,10 @@ namespace cputex {
         return mTextureStorage.surfaceByteAligment();
     }
 
+    std::pmr::memory_resource *SharedTexture::memoryResource() const noexcept {
+        return mTextureStorage.memoryResource();
+    }
+
     cputex::SizeType SharedTexture::sizeInBytes() const noexcept {
         return mTextureStorage.sizeInBytes();
     }
@@ -108,6 +127,14 @@ namespace cputex {
         return mTextureStorage.sizeInBytes(mip);
     }
 
+    cputex::SizeType SharedTexture::rowPitch(CountType mip) const noexcept {
+        return mTextureStorage.rowPitch(mip);
+    }
+
+    cputex::SizeType SharedTexture::slicePitch(CountType mip) const noexcept {
+        return mTextureStorage.slicePitch(mip);
+    }
+
     CountType SharedTexture::surfaceCount() const noexcept {
         return mTextureStorage.surfaceCount();
     }
@@ -125,7 +152,24 @@ namespace cputex {
     }
 
     SharedTextureLock SharedTexture::lock() {
-        return SharedTextureLock{ mTextureStorage, mBufferMutex };
+        return SharedTextureLock{ mTextureStorage };
+    }
+
+    SharedTextureReadLock SharedTexture::readLock() const {
+        return SharedTextureReadLock{ mTextureStorage };
+    }
+
+    SharedTexture SharedTexture::snapshot() const {
+        if(!mTextureStorage.isValid()) {
+            return SharedTexture();
+        }
+
+        std::shared_lock readLock(mTextureStorage.getHeader()->bufferMutex);
+
+        SharedTexture snapshotTexture;
+        snapshotTexture.mTextureStorage = mTextureStorage.snapshot();
+
+        return snapshotTexture;
     }
 
     SharedTexture SharedTexture::clone() const noexcept {
@@ -134,7 +178,7 @@ namespace cputex {
         }
 
         SharedTexture clonedTexture;
-        clonedTexture.mTextureStorage = internal::TextureStorage(mTextureStorage.getHeader()->params, true);
+        clonedTexture.mTextureStorage = internal::TextureStorage(cputex::uninitialized, mTextureStorage.getHeader()->params, true);
 
         if(!clonedTexture) {
             return SharedTexture();
@@ -145,4 +189,71 @@ namespace cputex {
 
         return clonedTexture;
     }
-}
\ No newline at end of file
+
+    WeakTexture::WeakTexture(const SharedTexture &texture) noexcept
+        : mTextureStorage(texture.mTextureStorage)
+    {
+        mTextureStorage.addWeakRef();
+    }
+
+    WeakTexture::WeakTexture(const WeakTexture &other) noexcept
+        : mTextureStorage(other.mTextureStorage)
+    {
+        mTextureStorage.addWeakRef();
+    }
+
+    WeakTexture::WeakTexture(WeakTexture &&other) noexcept
+        : mTextureStorage(std::move(other.mTextureStorage))
+    {
+    }
+
+    WeakTexture::~WeakTexture() noexcept {
+        mTextureStorage.decWeakRef();
+    }
+
+    WeakTexture &WeakTexture::operator=(const WeakTexture &other) noexcept {
+        // decWeakRef empties this texture's storage, which on self-assignment is other's too.
+        if(this != &other) {
+            other.mTextureStorage.addWeakRef();
+            mTextureStorage.decWeakRef();
+            mTextureStorage = other.mTextureStorage;
+        }
+
+        return *this;
+    }
+
+    WeakTexture &WeakTexture::operator=(WeakTexture &&other) noexcept {
+        if(this != &other) {
+            mTextureStorage.decWeakRef();
+            mTextureStorage = std::move(other.mTextureStorage);
+        }
+
+        return *this;
+    }
+
+    WeakTexture &WeakTexture::operator=(const SharedTexture &texture) noexcept {
+        texture.mTextureStorage.addWeakRef();
+        mTextureStorage.decWeakRef();
+        mTextureStorage = texture.mTextureStorage;
+
+        return *this;
+    }
+
+    bool WeakTexture::expired() const noexcept {
+        return mTextureStorage.expired();
+    }
+
+    SharedTexture WeakTexture::lock() const noexcept {
+        SharedTexture texture;
+
+        if(mTextureStorage.tryAddRef()) {
+            texture.mTextureStorage = mTextureStorage;
+        }
+
+        return texture;
+    }
+
+    void WeakTexture::reset() noexcept {
+        mTextureStorage.decWeakRef();
+    }
+}
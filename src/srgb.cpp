@@ -0,0 +1,198 @@
+#include <cputex/internal/srgb.h>
+#include <cputex/internal/cpu_features.h>
+
+#if defined(CPUTEX_ARCH_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CPUTEX_SRGB_SSE2 1
+#include <emmintrin.h>
+#elif defined(CPUTEX_ARCH_ARM64)
+#define CPUTEX_SRGB_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace cputex::internal {
+    // linear -> srgb is 12.92 * x up to kLinearThreshold, and 1.055 * x^(1/2.4) - 0.055 above it. The curved segment
+    // is approximated by P(t) / Q(t) with t = sqrt(x), fitted by minimax over (kLinearThreshold, 1].
+    static constexpr float kLinearThreshold = 0.0031308f;
+    static constexpr float kLinearScale = 12.92f;
+
+    static constexpr float kP0 = -0.04893876585155587f;
+    static constexpr float kP1 = 1.1746175723524803f;
+    static constexpr float kP2 = 17.85316059899504f;
+    static constexpr float kP3 = 17.954170881426812f;
+
+    static constexpr float kQ1 = 14.47305971065918f;
+    static constexpr float kQ2 = 20.57449992864295f;
+    static constexpr float kQ3 = 0.8855744413077579f;
+
+    [[nodiscard]]
+    static const std::array<float, 256> &srgbDecodeTable() noexcept {
+        static const std::array<float, 256> table = []() {
+            std::array<float, 256> values;
+
+            for(size_t i = 0; i < values.size(); ++i) {
+                const double encoded = static_cast<double>(i) / 255.0;
+                values[i] = static_cast<float>((encoded <= 0.04045) ? encoded / 12.92 : std::pow((encoded + 0.055) / 1.055, 2.4));
+            }
+
+            return values;
+        }();
+
+        return table;
+    }
+
+    [[nodiscard]]
+    static float clampUnit(float value) noexcept {
+        // Written so that NaN fails the first comparison and becomes 0.
+        if(!(value > 0.0f)) {
+            return 0.0f;
+        }
+
+        return std::min(value, 1.0f);
+    }
+
+    [[nodiscard]]
+    static float encodeSrgbChannel(float linear) noexcept {
+        if(linear <= kLinearThreshold) {
+            return linear * kLinearScale;
+        }
+
+        const float t = std::sqrt(linear);
+        const float p = ((kP3 * t + kP2) * t + kP1) * t + kP0;
+        const float q = ((kQ3 * t + kQ2) * t + kQ1) * t + 1.0f;
+        return p / q;
+    }
+
+    [[nodiscard]]
+    static uint8_t quantizeUnorm8(float value) noexcept {
+        return static_cast<uint8_t>(static_cast<int>(value * 255.0f + 0.5f));
+    }
+
+    static void encodeSrgb8Scalar(cputex::span<const glm::vec4> samples, uint8_t *dest) noexcept {
+        for(const glm::vec4 &sample : samples) {
+            dest[0] = quantizeUnorm8(encodeSrgbChannel(clampUnit(sample.x)));
+            dest[1] = quantizeUnorm8(encodeSrgbChannel(clampUnit(sample.y)));
+            dest[2] = quantizeUnorm8(encodeSrgbChannel(clampUnit(sample.z)));
+            dest[3] = quantizeUnorm8(clampUnit(sample.w));
+            dest += 4;
+        }
+    }
+
+    void decodeSrgb8(const uint8_t *source, cputex::span<glm::vec4> samples) noexcept {
+        const std::array<float, 256> &table = srgbDecodeTable();
+
+        for(glm::vec4 &sample : samples) {
+            sample = glm::vec4(table[source[0]], table[source[1]], table[source[2]], static_cast<float>(source[3]) * (1.0f / 255.0f));
+            source += 4;
+        }
+    }
+
+#if defined(CPUTEX_SRGB_SSE2)
+    // Encodes and quantizes one texel, leaving the result as four 32 bit integers.
+    [[nodiscard]]
+    static __m128i encodeSrgbTexelSse2(__m128 linear) noexcept {
+        // The alpha lane skips the curve.
+        const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+        // maxps returns the second operand when either is NaN.
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(linear, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+        const __m128 t = _mm_sqrt_ps(clamped);
+        __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kP3), t), _mm_set1_ps(kP2));
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kP1));
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(kP0));
+        __m128 q = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kQ3), t), _mm_set1_ps(kQ2));
+        q = _mm_add_ps(_mm_mul_ps(q, t), _mm_set1_ps(kQ1));
+        q = _mm_add_ps(_mm_mul_ps(q, t), _mm_set1_ps(1.0f));
+        const __m128 curve = _mm_div_ps(p, q);
+
+        const __m128 linearSegment = _mm_mul_ps(clamped, _mm_set1_ps(kLinearScale));
+        const __m128 useLinear = _mm_or_ps(_mm_cmple_ps(clamped, _mm_set1_ps(kLinearThreshold)), alphaMask);
+        const __m128 alphaOrLinear = _mm_or_ps(_mm_and_ps(alphaMask, clamped), _mm_andnot_ps(alphaMask, linearSegment));
+        const __m128 encoded = _mm_or_ps(_mm_and_ps(useLinear, alphaOrLinear), _mm_andnot_ps(useLinear, curve));
+
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(encoded, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+    }
+
+    static void encodeSrgb8Sse2(cputex::span<const glm::vec4> samples, uint8_t *dest) noexcept {
+        static_assert(sizeof(glm::vec4) == 16, "glm::vec4 is expected to be four tightly packed floats");
+
+        const float *source = reinterpret_cast<const float *>(samples.data());
+        size_t remaining = samples.size();
+
+        while(remaining >= 4) {
+            const __m128i texel0 = encodeSrgbTexelSse2(_mm_loadu_ps(source));
+            const __m128i texel1 = encodeSrgbTexelSse2(_mm_loadu_ps(source + 4));
+            const __m128i texel2 = encodeSrgbTexelSse2(_mm_loadu_ps(source + 8));
+            const __m128i texel3 = encodeSrgbTexelSse2(_mm_loadu_ps(source + 12));
+
+            // Every value is already in [0, 255] so the saturating packs don't change anything.
+            const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(texel0, texel1), _mm_packs_epi32(texel2, texel3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), packed);
+
+            source += 16;
+            dest += 16;
+            remaining -= 4;
+        }
+
+        encodeSrgb8Scalar(samples.last(remaining), dest);
+    }
+#elif defined(CPUTEX_SRGB_NEON)
+    [[nodiscard]]
+    static uint32x4_t encodeSrgbTexelNeon(float32x4_t linear) noexcept {
+        static constexpr uint32_t kAlphaMask[4] = { 0, 0, 0, 0xFFFFFFFFu };
+        const uint32x4_t alphaMask = vld1q_u32(kAlphaMask);
+
+        // vmaxnmq returns the number when one operand is NaN.
+        const float32x4_t clamped = vminq_f32(vmaxnmq_f32(linear, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+
+        const float32x4_t t = vsqrtq_f32(clamped);
+        float32x4_t p = vaddq_f32(vmulq_n_f32(t, kP3), vdupq_n_f32(kP2));
+        p = vaddq_f32(vmulq_f32(p, t), vdupq_n_f32(kP1));
+        p = vaddq_f32(vmulq_f32(p, t), vdupq_n_f32(kP0));
+        float32x4_t q = vaddq_f32(vmulq_n_f32(t, kQ3), vdupq_n_f32(kQ2));
+        q = vaddq_f32(vmulq_f32(q, t), vdupq_n_f32(kQ1));
+        q = vaddq_f32(vmulq_f32(q, t), vdupq_n_f32(1.0f));
+        const float32x4_t curve = vdivq_f32(p, q);
+
+        const float32x4_t linearSegment = vmulq_n_f32(clamped, kLinearScale);
+        const uint32x4_t useLinear = vorrq_u32(vcleq_f32(clamped, vdupq_n_f32(kLinearThreshold)), alphaMask);
+        const float32x4_t alphaOrLinear = vbslq_f32(alphaMask, clamped, linearSegment);
+        const float32x4_t encoded = vbslq_f32(useLinear, alphaOrLinear, curve);
+
+        return vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(encoded, 255.0f), vdupq_n_f32(0.5f)));
+    }
+
+    static void encodeSrgb8Neon(cputex::span<const glm::vec4> samples, uint8_t *dest) noexcept {
+        static_assert(sizeof(glm::vec4) == 16, "glm::vec4 is expected to be four tightly packed floats");
+
+        const float *source = reinterpret_cast<const float *>(samples.data());
+        size_t remaining = samples.size();
+
+        while(remaining >= 4) {
+            const uint16x8_t low = vcombine_u16(vmovn_u32(encodeSrgbTexelNeon(vld1q_f32(source))), vmovn_u32(encodeSrgbTexelNeon(vld1q_f32(source + 4))));
+            const uint16x8_t high = vcombine_u16(vmovn_u32(encodeSrgbTexelNeon(vld1q_f32(source + 8))), vmovn_u32(encodeSrgbTexelNeon(vld1q_f32(source + 12))));
+            vst1q_u8(dest, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+
+            source += 16;
+            dest += 16;
+            remaining -= 4;
+        }
+
+        encodeSrgb8Scalar(samples.last(remaining), dest);
+    }
+#endif
+
+    void encodeSrgb8(cputex::span<const glm::vec4> samples, uint8_t *dest) noexcept {
+#if defined(CPUTEX_SRGB_SSE2)
+        encodeSrgb8Sse2(samples, dest);
+#elif defined(CPUTEX_SRGB_NEON)
+        encodeSrgb8Neon(samples, dest);
+#else
+        encodeSrgb8Scalar(samples, dest);
+#endif
+    }
+}
@@ -0,0 +1,251 @@
+#include <cputex/internal/swizzle.h>
+#include <cputex/internal/cpu_features.h>
+
+#if defined(CPUTEX_ARCH_X86)
+#include <immintrin.h>
+#elif defined(CPUTEX_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+
+namespace cputex::internal {
+    enum class ByteChannelType {
+        Unorm,
+        Snorm,
+        Uint,
+        Sint,
+        Srgb,
+    };
+
+    struct ByteFormatLayout {
+        gpufmt::Format format;
+        ByteChannelType channelType;
+        uint8_t channelCount;
+        // The channel (0 = r, 1 = g, 2 = b, 3 = a) stored in each byte of a texel.
+        std::array<uint8_t, 4> channels;
+    };
+
+    // The A8B8G8R8 pack32 formats are stored as a little endian uint32 with red in the least significant byte, so in
+    // memory they are laid out exactly like R8G8B8A8.
+    static constexpr std::array kByteFormatLayouts{
+        ByteFormatLayout{ gpufmt::Format::R8_UNORM, ByteChannelType::Unorm, 1, { 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8_SNORM, ByteChannelType::Snorm, 1, { 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8_UINT, ByteChannelType::Uint, 1, { 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8_SINT, ByteChannelType::Sint, 1, { 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8_SRGB, ByteChannelType::Srgb, 1, { 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8_UNORM, ByteChannelType::Unorm, 2, { 0, 1 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8_SNORM, ByteChannelType::Snorm, 2, { 0, 1 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8_UINT, ByteChannelType::Uint, 2, { 0, 1 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8_SINT, ByteChannelType::Sint, 2, { 0, 1 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8_SRGB, ByteChannelType::Srgb, 2, { 0, 1 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8_UNORM, ByteChannelType::Unorm, 3, { 0, 1, 2 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8_SNORM, ByteChannelType::Snorm, 3, { 0, 1, 2 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8_UINT, ByteChannelType::Uint, 3, { 0, 1, 2 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8_SINT, ByteChannelType::Sint, 3, { 0, 1, 2 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8_SRGB, ByteChannelType::Srgb, 3, { 0, 1, 2 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8_UNORM, ByteChannelType::Unorm, 3, { 2, 1, 0 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8_SNORM, ByteChannelType::Snorm, 3, { 2, 1, 0 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8_UINT, ByteChannelType::Uint, 3, { 2, 1, 0 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8_SINT, ByteChannelType::Sint, 3, { 2, 1, 0 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8_SRGB, ByteChannelType::Srgb, 3, { 2, 1, 0 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8A8_UNORM, ByteChannelType::Unorm, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8A8_SNORM, ByteChannelType::Snorm, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8A8_UINT, ByteChannelType::Uint, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8A8_SINT, ByteChannelType::Sint, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::R8G8B8A8_SRGB, ByteChannelType::Srgb, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8A8_UNORM, ByteChannelType::Unorm, 4, { 2, 1, 0, 3 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8A8_SNORM, ByteChannelType::Snorm, 4, { 2, 1, 0, 3 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8A8_UINT, ByteChannelType::Uint, 4, { 2, 1, 0, 3 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8A8_SINT, ByteChannelType::Sint, 4, { 2, 1, 0, 3 } },
+        ByteFormatLayout{ gpufmt::Format::B8G8R8A8_SRGB, ByteChannelType::Srgb, 4, { 2, 1, 0, 3 } },
+        ByteFormatLayout{ gpufmt::Format::A8B8G8R8_UNORM_PACK32, ByteChannelType::Unorm, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::A8B8G8R8_SNORM_PACK32, ByteChannelType::Snorm, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::A8B8G8R8_UINT_PACK32, ByteChannelType::Uint, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::A8B8G8R8_SINT_PACK32, ByteChannelType::Sint, 4, { 0, 1, 2, 3 } },
+        ByteFormatLayout{ gpufmt::Format::A8B8G8R8_SRGB_PACK32, ByteChannelType::Srgb, 4, { 0, 1, 2, 3 } },
+    };
+
+    [[nodiscard]]
+    static const ByteFormatLayout *findByteFormatLayout(gpufmt::Format format) noexcept {
+        auto itr = std::find_if(kByteFormatLayouts.cbegin(), kByteFormatLayouts.cend(), [format](const ByteFormatLayout &layout) {
+            return layout.format == format;
+        });
+
+        return (itr != kByteFormatLayouts.cend()) ? &(*itr) : nullptr;
+    }
+
+    [[nodiscard]]
+    static uint8_t alphaOne(ByteChannelType channelType) noexcept {
+        switch(channelType) {
+        case ByteChannelType::Unorm:
+            [[fallthrough]];
+        case ByteChannelType::Srgb:
+            return 0xFF;
+        case ByteChannelType::Snorm:
+            return 0x7F;
+        case ByteChannelType::Uint:
+            [[fallthrough]];
+        case ByteChannelType::Sint:
+            return 0x01;
+        default:
+            return 0x00;
+        }
+    }
+
+    std::optional<ByteSwizzle> findByteSwizzle(gpufmt::Format sourceFormat, gpufmt::Format destFormat) noexcept {
+        const ByteFormatLayout *sourceLayout = findByteFormatLayout(sourceFormat);
+        const ByteFormatLayout *destLayout = findByteFormatLayout(destFormat);
+
+        if(sourceLayout == nullptr || destLayout == nullptr) {
+            return std::nullopt;
+        }
+
+        if(sourceLayout->channelType != destLayout->channelType) {
+            return std::nullopt;
+        }
+
+        ByteSwizzle swizzle;
+        swizzle.sourceTexelByteSize = sourceLayout->channelCount;
+        swizzle.destTexelByteSize = destLayout->channelCount;
+        swizzle.groupTexelCount = static_cast<uint8_t>(16u / std::max(sourceLayout->channelCount, destLayout->channelCount));
+        swizzle.shuffle.fill(ByteSwizzle::kFillByte);
+        swizzle.fill.fill(0u);
+
+        for(uint8_t groupTexel = 0; groupTexel < swizzle.groupTexelCount; ++groupTexel) {
+            for(uint8_t destByte = 0; destByte < destLayout->channelCount; ++destByte) {
+                const uint8_t channel = destLayout->channels[destByte];
+                const size_t groupDestByte = static_cast<size_t>(groupTexel) * destLayout->channelCount + destByte;
+
+                const auto sourceChannelEnd = sourceLayout->channels.cbegin() + sourceLayout->channelCount;
+                const auto sourceChannelItr = std::find(sourceLayout->channels.cbegin(), sourceChannelEnd, channel);
+
+                if(sourceChannelItr != sourceChannelEnd) {
+                    const auto sourceByte = static_cast<uint8_t>(sourceChannelItr - sourceLayout->channels.cbegin());
+                    swizzle.shuffle[groupDestByte] = static_cast<uint8_t>(groupTexel * sourceLayout->channelCount + sourceByte);
+                }
+                else {
+                    swizzle.fill[groupDestByte] = (channel == 3) ? alphaOne(destLayout->channelType) : uint8_t(0);
+                }
+            }
+        }
+
+        return swizzle;
+    }
+
+    void byteSwizzleScalar(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        for(cputex::SizeType texel = 0; texel < texelCount; ++texel) {
+            for(uint8_t destByte = 0; destByte < swizzle.destTexelByteSize; ++destByte) {
+                const uint8_t sourceByte = swizzle.shuffle[destByte];
+                dest[destByte] = (sourceByte == ByteSwizzle::kFillByte) ? cputex::byte(swizzle.fill[destByte]) : source[sourceByte];
+            }
+
+            source += swizzle.sourceTexelByteSize;
+            dest += swizzle.destTexelByteSize;
+        }
+    }
+
+    // The vector kernels always load and store a full 16 bytes per group, even when a group only uses 12 of them. The
+    // extra bytes stored past a group are overwritten by the next group, and the loops stop while a full 16 byte access
+    // is still in bounds. The remaining texels are handled by byteSwizzleScalar.
+
+#if defined(CPUTEX_ARCH_X86)
+    CPUTEX_TARGET("ssse3")
+    static void byteSwizzleSsse3(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(swizzle.shuffle.data()));
+        const __m128i fill = _mm_loadu_si128(reinterpret_cast<const __m128i *>(swizzle.fill.data()));
+
+        const cputex::SizeType groupSourceByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.sourceTexelByteSize;
+        const cputex::SizeType groupDestByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.destTexelByteSize;
+
+        while(texelCount * swizzle.sourceTexelByteSize >= 16 && texelCount * swizzle.destTexelByteSize >= 16) {
+            const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_or_si128(_mm_shuffle_epi8(texels, shuffle), fill));
+
+            source += groupSourceByteSize;
+            dest += groupDestByteSize;
+            texelCount -= swizzle.groupTexelCount;
+        }
+
+        byteSwizzleScalar(swizzle, source, dest, texelCount);
+    }
+
+    CPUTEX_TARGET("avx2")
+    static void byteSwizzleAvx2(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        // _mm256_shuffle_epi8 shuffles within each 128 bit lane, so each lane handles one group.
+        const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(swizzle.shuffle.data())));
+        const __m256i fill = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(swizzle.fill.data())));
+
+        const cputex::SizeType groupSourceByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.sourceTexelByteSize;
+        const cputex::SizeType groupDestByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.destTexelByteSize;
+
+        if(groupSourceByteSize == 16 && groupDestByteSize == 16) {
+            while(texelCount >= 2 * swizzle.groupTexelCount) {
+                const __m256i texels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), _mm256_or_si256(_mm256_shuffle_epi8(texels, shuffle), fill));
+
+                source += 32;
+                dest += 32;
+                texelCount -= 2 * swizzle.groupTexelCount;
+            }
+        }
+        else {
+            while(texelCount * swizzle.sourceTexelByteSize >= groupSourceByteSize + 16 &&
+                  texelCount * swizzle.destTexelByteSize >= groupDestByteSize + 16)
+            {
+                const __m128i lowTexels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+                const __m128i highTexels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + groupSourceByteSize));
+                const __m256i texels = _mm256_inserti128_si256(_mm256_castsi128_si256(lowTexels), highTexels, 1);
+                const __m256i swizzled = _mm256_or_si256(_mm256_shuffle_epi8(texels, shuffle), fill);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm256_castsi256_si128(swizzled));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + groupDestByteSize), _mm256_extracti128_si256(swizzled, 1));
+
+                source += 2 * groupSourceByteSize;
+                dest += 2 * groupDestByteSize;
+                texelCount -= 2 * swizzle.groupTexelCount;
+            }
+        }
+
+        byteSwizzleSsse3(swizzle, source, dest, texelCount);
+    }
+#elif defined(CPUTEX_ARCH_ARM64)
+    static void byteSwizzleNeon(const ByteSwizzle &swizzle, const cputex::byte *source, cputex::byte *dest, cputex::SizeType texelCount) noexcept {
+        // vqtbl1q_u8 writes 0 for out of range indices, which kFillByte is.
+        const uint8x16_t shuffle = vld1q_u8(swizzle.shuffle.data());
+        const uint8x16_t fill = vld1q_u8(swizzle.fill.data());
+
+        const cputex::SizeType groupSourceByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.sourceTexelByteSize;
+        const cputex::SizeType groupDestByteSize = static_cast<cputex::SizeType>(swizzle.groupTexelCount) * swizzle.destTexelByteSize;
+
+        while(texelCount * swizzle.sourceTexelByteSize >= 16 && texelCount * swizzle.destTexelByteSize >= 16) {
+            const uint8x16_t texels = vld1q_u8(reinterpret_cast<const uint8_t *>(source));
+            vst1q_u8(reinterpret_cast<uint8_t *>(dest), vorrq_u8(vqtbl1q_u8(texels, shuffle), fill));
+
+            source += groupSourceByteSize;
+            dest += groupDestByteSize;
+            texelCount -= swizzle.groupTexelCount;
+        }
+
+        byteSwizzleScalar(swizzle, source, dest, texelCount);
+    }
+#endif
+
+    ByteSwizzleFunc selectByteSwizzleKernel() noexcept {
+#if defined(CPUTEX_ARCH_X86)
+        if(cpuFeatures().avx2) {
+            return &byteSwizzleAvx2;
+        }
+
+        if(cpuFeatures().ssse3) {
+            return &byteSwizzleSsse3;
+        }
+#elif defined(CPUTEX_ARCH_ARM64)
+        if(cpuFeatures().neon) {
+            return &byteSwizzleNeon;
+        }
+#endif
+
+        return &byteSwizzleScalar;
+    }
+}
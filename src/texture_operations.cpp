@@ -4,11 +4,30 @@
 #include <gpufmt/storage.h>
 #include <gpufmt/traits.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace cputex {
+    // Calls func(volumeSlice, firstRow, rowCount) for every volume slice that overlaps rows [firstRow, firstRow + rowCount)
+    // of a surface whose slices are laid out one after the other, rowsPerSlice rows each.
+    template<class Func>
+    void forEachSliceRows(cputex::SizeType rowsPerSlice, cputex::SizeType firstRow, cputex::SizeType rowCount, Func &&func) {
+        const cputex::SizeType endRow = firstRow + rowCount;
+
+        while(firstRow < endRow) {
+            const cputex::SizeType volumeSlice = firstRow / rowsPerSlice;
+            const cputex::SizeType sliceRow = firstRow % rowsPerSlice;
+            const cputex::SizeType sliceRowCount = std::min(rowsPerSlice - sliceRow, endRow - firstRow);
+
+            func(static_cast<cputex::CountType>(volumeSlice), sliceRow, sliceRowCount);
+            firstRow += sliceRowCount;
+        }
+    }
+
     template<gpufmt::Format FormatV>
     class Clear {
     public:
-        void operator()(cputex::TextureSurfaceSpan surface, [[maybe_unused]] const glm::dvec4 &clearColor) noexcept {
+        void operator()(span<cputex::byte> surfaceSpan, [[maybe_unused]] const glm::dvec4 &clearColor) noexcept {
             using Traits = gpufmt::FormatTraits<FormatV>;
             using Storage = gpufmt::FormatStorage<FormatV>;
 
@@ -17,7 +36,6 @@ namespace cputex {
                          !Traits::info.stencil &&
                          FormatV != gpufmt::Format::UNDEFINED)
             {
-                span<cputex::byte> surfaceSpan = surface.accessData();
                 span<typename Traits::BlockType> surfaceBlockSpan(reinterpret_cast<typename Traits::BlockType *>(surfaceSpan.data()), surfaceSpan.size_bytes() / Traits::BlockByteSize);
 
                 typename Traits::WideSampleType wideClearColor(clearColor);
@@ -30,8 +48,55 @@ namespace cputex {
         }
     };
 
+    static void clearRows(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceSpan surface, const glm::dvec4 &clearColor) noexcept {
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(surface.format());
+
+        if(info.blockByteSize == 0) {
+            return;
+        }
+
+        const cputex::Extent extent = surface.extent();
+        const cputex::SizeType blockRowsPerSlice = (static_cast<cputex::SizeType>(extent.y) + info.blockExtent.y - 1) / info.blockExtent.y;
+        const cputex::SizeType blockSliceCount = (static_cast<cputex::SizeType>(extent.z) + info.blockExtent.z - 1) / info.blockExtent.z;
+        const cputex::SizeType rowByteSize = surface.rowByteSize();
+        const bool packed = surface.isPacked();
+
+        // Block rows are numbered across every block slice. Packed bands are cleared in one go, padded ones a row at a
+        // time so the padding, which may belong to someone else's pixels, is left alone.
+        auto clearBand = [&](cputex::SizeType firstBlockRow, cputex::SizeType blockRowCount) {
+            if(packed) {
+                gpufmt::visitFormat<Clear>(surface.format(), surface.accessData().subspan(firstBlockRow * rowByteSize, blockRowCount * rowByteSize), clearColor);
+                return;
+            }
+
+            for(cputex::SizeType blockRow = firstBlockRow; blockRow < firstBlockRow + blockRowCount; ++blockRow) {
+                const cputex::CountType blockSlice = static_cast<cputex::CountType>(blockRow / blockRowsPerSlice);
+                gpufmt::visitFormat<Clear>(surface.format(), surface.accessRowData(blockRow % blockRowsPerSlice, blockSlice), clearColor);
+            }
+        };
+
+        if(policy != nullptr) {
+            cputex::execution::parallelForEachBand(*policy, blockRowsPerSlice * blockSliceCount, rowByteSize, clearBand);
+        }
+        else {
+            clearBand(0, blockRowsPerSlice * blockSliceCount);
+        }
+    }
+
+    void clear(cputex::SurfaceSpan surface, const glm::dvec4 &clearColor) noexcept {
+        clearRows(nullptr, surface, clearColor);
+    }
+
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface, const glm::dvec4 &clearColor) noexcept {
+        clearRows(&policy, surface, clearColor);
+    }
+
     void clear(cputex::TextureSurfaceSpan surface, const glm::dvec4 &clearColor) noexcept {
-        gpufmt::visitFormat<Clear>(surface.format(), surface, clearColor);
+        clearRows(nullptr, (SurfaceSpan)surface, clearColor);
+    }
+
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::TextureSurfaceSpan surface, const glm::dvec4 &clearColor) noexcept {
+        clearRows(&policy, (SurfaceSpan)surface, clearColor);
     }
 
     void clear(cputex::TextureSpan texture, const glm::dvec4 &clearColor) noexcept {
@@ -44,47 +109,52 @@ namespace cputex {
         }
     }
 
+    void clear(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture, const glm::dvec4 &clearColor) noexcept {
+        cputex::execution::parallelForEachSurface(policy, texture.arraySize(), texture.faces(), texture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            clear(policy, texture.accessMipSurface(arraySlice, face, mip), clearColor);
+        });
+    }
 
     template<gpufmt::Format FormatV>
     class HorizontalFlip {
     public:
-        bool operator()(span<const cputex::byte> sourceSurface, span<cputex::byte> destSurface, const Extent &surfaceExtent) noexcept
+        // Swaps the row pairs [firstRowPair, firstRowPair + rowPairCount). Row pair n is row n and the n-th row from the
+        // bottom, so a surface has (height + 1) / 2 pairs. For odd heights the middle row pairs with itself and is
+        // copied as is.
+        bool operator()(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface, cputex::CountType volumeSlice, cputex::SizeType firstRowPair, cputex::SizeType rowPairCount) noexcept
         {
             using Traits = gpufmt::FormatTraits<FormatV>;
 
             if constexpr(Traits::info.compression != gpufmt::CompressionType::None ||
                          Traits::info.blockExtent.x > 1 || Traits::info.blockExtent.y > 1 || Traits::info.blockExtent.z > 1 ||
-                         std::is_void_v<Traits::BlockType>)
+                         std::is_void_v<typename Traits::BlockType>)
             {
                 return false;
             }
             else
             {
-                span<const Traits::BlockType> sourceTexelSpan{ reinterpret_cast<const Traits::BlockType *>(sourceSurface.data()), sourceSurface.size_bytes() / sizeof(Traits::BlockType) };
-                span<Traits::BlockType> destTexelSpan{ reinterpret_cast<Traits::BlockType *>(destSurface.data()), destSurface.size_bytes() / sizeof(Traits::BlockType) };
+                using BlockType = typename Traits::BlockType;
 
-                using ExtentValueType = decltype(surfaceExtent.x);
+                const cputex::Extent surfaceExtent = sourceSurface.extent();
+                const size_t rowLength = static_cast<size_t>(surfaceExtent.x);
 
-                ExtentValueType topRow{ 0 };
-                ExtentValueType bottomRow = surfaceExtent.y - ExtentValueType{ 1 };
+                for(cputex::SizeType rowPair = firstRowPair; rowPair < firstRowPair + rowPairCount; ++rowPair) {
+                    const cputex::SizeType topRow = rowPair;
+                    const cputex::SizeType bottomRow = static_cast<cputex::SizeType>(surfaceExtent.y) - 1 - topRow;
 
-                while(topRow < bottomRow) {
-                    span<const Traits::BlockType> sourceTopRowSpan = sourceTexelSpan.subspan(static_cast<size_t>(topRow) * static_cast<size_t>(surfaceExtent.x), surfaceExtent.x);
-                    span<const Traits::BlockType> sourceBottomRowSpan = sourceTexelSpan.subspan(static_cast<size_t>(bottomRow) * static_cast<size_t>(surfaceExtent.x), surfaceExtent.x);
+                    span<const BlockType> sourceTopRowSpan{ reinterpret_cast<const BlockType *>(sourceSurface.getRowData(topRow, volumeSlice).data()), rowLength };
+                    span<const BlockType> sourceBottomRowSpan{ reinterpret_cast<const BlockType *>(sourceSurface.getRowData(bottomRow, volumeSlice).data()), rowLength };
 
-                    span<Traits::BlockType> destTopRowSpan = destTexelSpan.subspan(static_cast<size_t>(topRow) * static_cast<size_t>(surfaceExtent.x), surfaceExtent.x);
-                    span<Traits::BlockType> destBottomRowSpan = destTexelSpan.subspan(static_cast<size_t>(bottomRow) * static_cast<size_t>(surfaceExtent.x), surfaceExtent.x);
+                    span<BlockType> destTopRowSpan{ reinterpret_cast<BlockType *>(destSurface.accessRowData(topRow, volumeSlice).data()), rowLength };
+                    span<BlockType> destBottomRowSpan{ reinterpret_cast<BlockType *>(destSurface.accessRowData(bottomRow, volumeSlice).data()), rowLength };
 
-                    for(ExtentValueType column{ 0u }; column < surfaceExtent.x; ++column) {
-                        const Traits::BlockType sourceTopValue = sourceTopRowSpan[column];
-                        const Traits::BlockType sourceBottomValue = sourceBottomRowSpan[column];
+                    for(size_t column = 0; column < rowLength; ++column) {
+                        const BlockType sourceTopValue = sourceTopRowSpan[column];
+                        const BlockType sourceBottomValue = sourceBottomRowSpan[column];
 
                         destTopRowSpan[column] = sourceBottomValue;
                         destBottomRowSpan[column] = sourceTopValue;
                     }
-
-                    ++topRow;
-                    --bottomRow;
                 }
 
                 return true;
@@ -92,21 +162,46 @@ namespace cputex {
         }
     };
 
-    bool flipHorizontal(cputex::SurfaceSpan surface) noexcept {
-        const cputex::Extent extent = surface.extent();
-        for(CountType volumeSlice = 0; volumeSlice < extent.z; ++volumeSlice) {
-            auto surfaceSlice = surface.accessVolumeSlice(volumeSlice);
-            bool result = gpufmt::visitFormat<HorizontalFlip>(surface.format(),
-                                                              surfaceSlice.getData(),
-                                                              surfaceSlice.accessData(),
-                                                              surfaceSlice.extent());
-            
-            if(!result) {
-                return false;
-            }
+    [[nodiscard]]
+    static bool flipHorizontalRows(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        const cputex::Extent extent = sourceSurface.extent();
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
+
+        const cputex::SizeType rowPairsPerSlice = (static_cast<cputex::SizeType>(extent.y) + 1) / 2;
+        const cputex::SizeType rowPairByteSize = 2 * static_cast<cputex::SizeType>(extent.x) * info.blockByteSize;
+        std::atomic_bool succeeded = true;
+
+        auto flipBand = [&](cputex::SizeType firstRowPair, cputex::SizeType rowPairCount) {
+            forEachSliceRows(rowPairsPerSlice, firstRowPair, rowPairCount, [&](cputex::CountType volumeSlice, cputex::SizeType sliceRowPair, cputex::SizeType sliceRowPairCount) {
+                bool result = gpufmt::visitFormat<HorizontalFlip>(sourceSurface.format(),
+                                                                  sourceSurface,
+                                                                  destSurface,
+                                                                  volumeSlice,
+                                                                  sliceRowPair,
+                                                                  sliceRowPairCount);
+
+                if(!result) {
+                    succeeded.store(false, std::memory_order_relaxed);
+                }
+            });
+        };
+
+        if(policy != nullptr) {
+            cputex::execution::parallelForEachBand(*policy, rowPairsPerSlice * extent.z, rowPairByteSize, flipBand);
+        }
+        else {
+            flipBand(0, rowPairsPerSlice * extent.z);
         }
 
-        return true;
+        return succeeded.load(std::memory_order_relaxed);
+    }
+
+    bool flipHorizontal(cputex::SurfaceSpan surface) noexcept {
+        return flipHorizontalRows(nullptr, surface, surface);
+    }
+
+    bool flipHorizontal(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface) noexcept {
+        return flipHorizontalRows(&policy, surface, surface);
     }
 
     bool flipHorizontal(cputex::TextureSpan texture) noexcept {
@@ -125,27 +220,34 @@ namespace cputex {
         return true;
     }
 
+    bool flipHorizontal(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture) noexcept {
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachSurface(policy, texture.arraySize(), texture.faces(), texture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            if(!flipHorizontal(policy, (SurfaceSpan)texture.accessMipSurface(arraySlice, face, mip))) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
+    }
+
     bool flipHorizontalTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept
     {
         if(!sourceSurface.equivalentLayout(destSurface)) {
             return false;
         }
 
-        const cputex::Extent extent = sourceSurface.extent();
-
-        for(CountType volumeSlice = 0; volumeSlice < extent.z; ++volumeSlice) {
-
-            bool result = gpufmt::visitFormat<HorizontalFlip>(sourceSurface.format(),
-                                                              sourceSurface.getVolumeSlice(volumeSlice).getData(),
-                                                              destSurface.accessVolumeSlice(volumeSlice).accessData(),
-                                                              cputex::Extent(extent.x, extent.y, 1));
+        return flipHorizontalRows(nullptr, sourceSurface, destSurface);
+    }
 
-            if(!result) {
-                return false;
-            }
+    bool flipHorizontalTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept
+    {
+        if(!sourceSurface.equivalentLayout(destSurface)) {
+            return false;
         }
 
-        return true;
+        return flipHorizontalRows(&policy, sourceSurface, destSurface);
     }
 
     bool flipHorizontalTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
@@ -168,42 +270,55 @@ namespace cputex {
         return true;
     }
 
+    bool flipHorizontalTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        if(!sourceTexture.equivalentLayout(destTexture)) {
+            return false;
+        }
+
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachSurface(policy, sourceTexture.arraySize(), sourceTexture.faces(), sourceTexture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            if(!flipHorizontalTo(policy, (SurfaceView)sourceTexture.getMipSurface(arraySlice, face, mip), (SurfaceSpan)destTexture.accessMipSurface(arraySlice, face, mip))) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
+    }
+
     template<gpufmt::Format FormatV>
     class VerticalFlip {
     public:
-        bool operator()(span<const cputex::byte> sourceSurface, span<cputex::byte> destSurface, const Extent &surfaceExtent) noexcept
+        // Mirrors rows [firstRow, firstRow + rowCount) left to right.
+        bool operator()(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface, cputex::CountType volumeSlice, cputex::SizeType firstRow, cputex::SizeType rowCount) noexcept
         {
             using Traits = gpufmt::FormatTraits<FormatV>;
 
             if constexpr(Traits::info.compression != gpufmt::CompressionType::None ||
                          Traits::info.blockExtent.x > 1 || Traits::info.blockExtent.y > 1 || Traits::info.blockExtent.z > 1 ||
-                         std::is_void_v<Traits::BlockType>)
+                         std::is_void_v<typename Traits::BlockType>)
             {
                 return false;
             }
             else
             {
-                span<const Traits::BlockType> sourceTexelSpan{ reinterpret_cast<const Traits::BlockType *>(sourceSurface.data()), sourceSurface.size_bytes() / sizeof(Traits::BlockType) };
-                span<Traits::BlockType> destTexelSpan{ reinterpret_cast<Traits::BlockType *>(destSurface.data()), destSurface.size_bytes() / sizeof(Traits::BlockType) };
+                using BlockType = typename Traits::BlockType;
 
-                using ExtentValueType = decltype(surfaceExtent.x);
+                const size_t rowLength = static_cast<size_t>(sourceSurface.extent().x);
 
-                for(ExtentValueType row{ 0 }; row < surfaceExtent.y; ++row) {
-                    span<const Traits::BlockType> sourceRowSpan = sourceTexelSpan.subspan(static_cast<size_t>(row) * static_cast<size_t>(surfaceExtent.x));
-                    span<Traits::BlockType> destRowSpan = destTexelSpan.subspan(static_cast<size_t>(row) * static_cast<size_t>(surfaceExtent.x));
+                for(cputex::SizeType row = firstRow; row < firstRow + rowCount; ++row) {
+                    span<const BlockType> sourceRowSpan{ reinterpret_cast<const BlockType *>(sourceSurface.getRowData(row, volumeSlice).data()), rowLength };
+                    span<BlockType> destRowSpan{ reinterpret_cast<BlockType *>(destSurface.accessRowData(row, volumeSlice).data()), rowLength };
 
-                    ExtentValueType leftColumn{ 0 };
-                    ExtentValueType rightColumn{ surfaceExtent.x - ExtentValueType{1} };
+                    // For odd widths the middle column pairs with itself and is copied as is.
+                    for(size_t leftColumn = 0; leftColumn < (rowLength + 1u) / 2u; ++leftColumn) {
+                        const size_t rightColumn = rowLength - 1u - leftColumn;
 
-                    while(leftColumn < rightColumn) {
-                        const Traits::BlockType sourceLeftValue = sourceRowSpan[leftColumn];
-                        const Traits::BlockType sourceRightValue = sourceRowSpan[rightColumn];
+                        const BlockType sourceLeftValue = sourceRowSpan[leftColumn];
+                        const BlockType sourceRightValue = sourceRowSpan[rightColumn];
 
                         destRowSpan[rightColumn] = sourceLeftValue;
                         destRowSpan[leftColumn] = sourceRightValue;
-
-                        ++leftColumn;
-                        --rightColumn;
                     }
                 }
 
@@ -212,18 +327,48 @@ namespace cputex {
         }
     };
 
-    bool flipVertical(cputex::SurfaceSpan surface) noexcept
-    {
-        const cputex::Extent extent = surface.extent();
-        for(CountType volumeSlice = 0; volumeSlice < extent.z; ++volumeSlice) {
-            bool result = gpufmt::visitFormat<VerticalFlip>(surface.format(), surface.getData(), surface.accessData(), Extent(extent.x, extent.y, 1));
+    [[nodiscard]]
+    static bool flipVerticalRows(const cputex::execution::ParallelPolicy *policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        const cputex::Extent extent = sourceSurface.extent();
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
 
-            if(!result) {
-                return false;
-            }
+        const cputex::SizeType rowsPerSlice = extent.y;
+        const cputex::SizeType rowByteSize = static_cast<cputex::SizeType>(extent.x) * info.blockByteSize;
+        std::atomic_bool succeeded = true;
+
+        auto flipBand = [&](cputex::SizeType firstRow, cputex::SizeType rowCount) {
+            forEachSliceRows(rowsPerSlice, firstRow, rowCount, [&](cputex::CountType volumeSlice, cputex::SizeType sliceRow, cputex::SizeType sliceRowCount) {
+                bool result = gpufmt::visitFormat<VerticalFlip>(sourceSurface.format(),
+                                                                sourceSurface,
+                                                                destSurface,
+                                                                volumeSlice,
+                                                                sliceRow,
+                                                                sliceRowCount);
+
+                if(!result) {
+                    succeeded.store(false, std::memory_order_relaxed);
+                }
+            });
+        };
+
+        if(policy != nullptr) {
+            cputex::execution::parallelForEachBand(*policy, rowsPerSlice * extent.z, rowByteSize, flipBand);
+        }
+        else {
+            flipBand(0, rowsPerSlice * extent.z);
         }
 
-        return true;
+        return succeeded.load(std::memory_order_relaxed);
+    }
+
+    bool flipVertical(cputex::SurfaceSpan surface) noexcept
+    {
+        return flipVerticalRows(nullptr, surface, surface);
+    }
+
+    bool flipVertical(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceSpan surface) noexcept
+    {
+        return flipVerticalRows(&policy, surface, surface);
     }
 
     bool flipVertical(cputex::TextureSpan texture) noexcept {
@@ -231,7 +376,7 @@ namespace cputex {
             for(CountType face = 0; face < texture.faces(); ++face) {
                 for(CountType mip = 0u; mip < texture.mips(); ++mip) {
                     const bool result = flipVertical((SurfaceSpan)texture.accessMipSurface(arraySlice, face, mip));
-                    
+
                     if(!result) {
                         return false;
                     }
@@ -242,22 +387,34 @@ namespace cputex {
         return true;
     }
 
+    bool flipVertical(const cputex::execution::ParallelPolicy &policy, cputex::TextureSpan texture) noexcept {
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachSurface(policy, texture.arraySize(), texture.faces(), texture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            if(!flipVertical(policy, (SurfaceSpan)texture.accessMipSurface(arraySlice, face, mip))) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
+    }
+
     bool flipVerticalTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept
     {
         if(!sourceSurface.equivalentLayout(destSurface)) {
             return false;
         }
 
-        const cputex::Extent extent = sourceSurface.extent();
-        for(CountType volumeSlice = 0; volumeSlice < extent.z; ++volumeSlice) {
-            bool result = gpufmt::visitFormat<VerticalFlip>(sourceSurface.format(), sourceSurface.getData(), destSurface.accessData(), Extent(extent.x, extent.y, 1));
+        return flipVerticalRows(nullptr, sourceSurface, destSurface);
+    }
 
-            if(!result) {
-                return false;
-            }
+    bool flipVerticalTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept
+    {
+        if(!sourceSurface.equivalentLayout(destSurface)) {
+            return false;
         }
 
-        return true;
+        return flipVerticalRows(&policy, sourceSurface, destSurface);
     }
 
     bool flipVerticalTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
@@ -280,77 +437,97 @@ namespace cputex {
         return true;
     }
 
-    template<gpufmt::Format FormatV>
-    class RegionCopy {
-    public:
-        [[nodiscard]]
-        bool operator()(cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) const noexcept {
-            using Traits = gpufmt::FormatTraits<FormatV>;
+    bool flipVerticalTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        if(!sourceTexture.equivalentLayout(destTexture)) {
+            return false;
+        }
 
-            if constexpr(!std::is_void_v<Traits::BlockType>)
-            {
-                const cputex::Extent sourceExtent = sourceSurface.extent();
-                const cputex::Extent destExtent = destSurface.extent();
-
-                if((sourceOffset.x + copyExtent.x) > sourceExtent.x ||
-                   (sourceOffset.y + copyExtent.y) > sourceExtent.y ||
-                   (sourceOffset.z + copyExtent.z) > sourceExtent.z)
-                {
-                    return false;
-                }
+        std::atomic_bool succeeded = true;
 
-                if((destOffset.x + copyExtent.x) > destExtent.x ||
-                   (destOffset.y + copyExtent.y) > destExtent.y ||
-                   (destOffset.z + copyExtent.z) > destExtent.z)
-                {
-                    return false;
-                }
+        cputex::execution::parallelForEachSurface(policy, sourceTexture.arraySize(), sourceTexture.faces(), sourceTexture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            if(!flipVerticalTo(policy, (SurfaceView)sourceTexture.getMipSurface(arraySlice, face, mip), (SurfaceSpan)destTexture.accessMipSurface(arraySlice, face, mip))) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
 
-                if((copyExtent.x % Traits::BlockExtent.x) != 0 ||
-                   (copyExtent.y % Traits::BlockExtent.y) != 0 ||
-                   (copyExtent.z % Traits::BlockExtent.z) != 0)
-                {
-                    return false;
-                }
+        return succeeded.load(std::memory_order_relaxed);
+    }
 
-                if((sourceOffset.x % Traits::BlockExtent.x) != 0 ||
-                   (sourceOffset.y % Traits::BlockExtent.y) != 0 ||
-                   (sourceOffset.z % Traits::BlockExtent.z) != 0)
-                {
-                    return false;
-                }
+    [[nodiscard]]
+    static bool validRegionCopy(cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept {
+        if(sourceSurface.format() != destSurface.format()) {
+            return false;
+        }
 
-                if((destOffset.x % Traits::BlockExtent.x) != 0 ||
-                   (destOffset.y % Traits::BlockExtent.y) != 0 ||
-                   (destOffset.z % Traits::BlockExtent.z) != 0)
-                {
-                    return false;
-                }
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
+        const cputex::Extent blockExtent = info.blockExtent;
+        const cputex::Extent sourceExtent = sourceSurface.extent();
+        const cputex::Extent destExtent = destSurface.extent();
+
+        if((sourceOffset.x + copyExtent.x) > sourceExtent.x ||
+           (sourceOffset.y + copyExtent.y) > sourceExtent.y ||
+           (sourceOffset.z + copyExtent.z) > sourceExtent.z)
+        {
+            return false;
+        }
+
+        if((destOffset.x + copyExtent.x) > destExtent.x ||
+           (destOffset.y + copyExtent.y) > destExtent.y ||
+           (destOffset.z + copyExtent.z) > destExtent.z)
+        {
+            return false;
+        }
+
+        if((copyExtent.x % blockExtent.x) != 0 ||
+           (copyExtent.y % blockExtent.y) != 0 ||
+           (copyExtent.z % blockExtent.z) != 0)
+        {
+            return false;
+        }
+
+        if((sourceOffset.x % blockExtent.x) != 0 ||
+           (sourceOffset.y % blockExtent.y) != 0 ||
+           (sourceOffset.z % blockExtent.z) != 0)
+        {
+            return false;
+        }
+
+        if((destOffset.x % blockExtent.x) != 0 ||
+           (destOffset.y % blockExtent.y) != 0 ||
+           (destOffset.z % blockExtent.z) != 0)
+        {
+            return false;
+        }
+
+        return true;
+    }
 
-                const auto sourceBlockData = sourceSurface.getDataAs<Traits::BlockType>();
-                auto destBlockData = destSurface.accessDataAs<Traits::BlockType>();
+    template<gpufmt::Format FormatV>
+    class RegionCopy {
+    public:
+        // Copies block rows [firstRow, firstRow + rowCount) of the copy region, counting rows across every slice of the
+        // region. The region has already been validated.
+        [[nodiscard]]
+        bool operator()(cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent, cputex::SizeType firstRow, cputex::SizeType rowCount) const noexcept {
+            using Traits = gpufmt::FormatTraits<FormatV>;
 
-                const auto sourceBlockExtent = sourceExtent / Traits::BlockExtent;
-                const auto destBlockExtent = destExtent / Traits::BlockExtent;
+            if constexpr(!std::is_void_v<typename Traits::BlockType>)
+            {
                 const auto copyBlockExtent = copyExtent / Traits::BlockExtent;
 
                 const auto sourceBlockOffset = sourceOffset / Traits::BlockExtent;
                 const auto destBlockOffset = destOffset / Traits::BlockExtent;
 
-                const auto sourceSliceBlockSize = sourceBlockExtent.x * sourceBlockExtent.y;
-                const auto destSliceBlockSize = destBlockExtent.x * destBlockExtent.y;
-
-                for(CountType slice = 0; slice < copyBlockExtent.z; ++slice) {
-                    for(CountType row = 0; row < copyBlockExtent.y; ++row) {
-                        const auto sourceBlockDataOffset = (sourceBlockOffset.z + slice) * sourceSliceBlockSize + (sourceBlockOffset.y + row) * sourceBlockExtent.x + sourceBlockOffset.x;
-                        const auto sourceSubspan = sourceBlockData.subspan(sourceBlockDataOffset, copyBlockExtent.x);
+                const size_t copyRowByteSize = static_cast<size_t>(copyBlockExtent.x) * sizeof(typename Traits::BlockType);
 
-                        const auto destBlockDataOffset = (destBlockOffset.z + slice) * destSliceBlockSize + (destBlockOffset.y + row) * destBlockExtent.x + destBlockOffset.x;
-                        auto destSubspan = destBlockData.subspan(destBlockDataOffset, copyBlockExtent.x);
+                forEachSliceRows(copyBlockExtent.y, firstRow, rowCount, [&](CountType slice, cputex::SizeType sliceRow, cputex::SizeType sliceRowCount) {
+                    for(cputex::SizeType row = sliceRow; row < sliceRow + sliceRowCount; ++row) {
+                        const auto sourceSubspan = sourceSurface.getRowData(sourceBlockOffset.y + row, sourceBlockOffset.z + slice).subspan(sourceBlockOffset.x * sizeof(typename Traits::BlockType), copyRowByteSize);
+                        auto destSubspan = destSurface.accessRowData(destBlockOffset.y + row, destBlockOffset.z + slice).subspan(destBlockOffset.x * sizeof(typename Traits::BlockType), copyRowByteSize);
 
                         std::copy(sourceSubspan.begin(), sourceSubspan.end(), destSubspan.begin());
                     }
-                }
+                });
 
                 return true;
             }
@@ -362,11 +539,33 @@ namespace cputex {
     };
 
     bool copySurfaceRegionTo(cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept {
-        if(sourceSurface.format() != destSurface.format()) {
+        if(!validRegionCopy(sourceSurface, sourceOffset, destSurface, destOffset, copyExtent)) {
+            return false;
+        }
+
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
+        const cputex::SizeType rowCount = static_cast<cputex::SizeType>(copyExtent.y / info.blockExtent.y) * (copyExtent.z / info.blockExtent.z);
+
+        return gpufmt::visitFormat<RegionCopy>(sourceSurface.format(), sourceSurface, sourceOffset, destSurface, destOffset, copyExtent, cputex::SizeType(0), rowCount);
+    }
+
+    bool copySurfaceRegionTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::Extent sourceOffset, cputex::SurfaceSpan destSurface, cputex::Extent destOffset, cputex::Extent copyExtent) noexcept {
+        if(!validRegionCopy(sourceSurface, sourceOffset, destSurface, destOffset, copyExtent)) {
             return false;
         }
 
-        return gpufmt::visitFormat<RegionCopy>(sourceSurface.format(), sourceSurface, sourceOffset, destSurface, destOffset, copyExtent);
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
+        const cputex::SizeType rowCount = static_cast<cputex::SizeType>(copyExtent.y / info.blockExtent.y) * (copyExtent.z / info.blockExtent.z);
+        const cputex::SizeType rowByteSize = static_cast<cputex::SizeType>(copyExtent.x / info.blockExtent.x) * info.blockByteSize;
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachBand(policy, rowCount, rowByteSize, [&](cputex::SizeType firstRow, cputex::SizeType bandRowCount) {
+            if(!gpufmt::visitFormat<RegionCopy>(sourceSurface.format(), sourceSurface, sourceOffset, destSurface, destOffset, copyExtent, firstRow, bandRowCount)) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
     }
 
     template<gpufmt::Format FormatV>
@@ -382,21 +581,21 @@ namespace cputex {
                 return gpufmt::DecompressError::FormatNotDecompressible;
             }
             else {
-                gpufmt::Surface<const CompressedTraits::BlockType> compressedBlockSurface;
-                compressedBlockSurface.blockData = compressedSurface.getDataAs<CompressedTraits::BlockType>();
+                gpufmt::Surface<const typename CompressedTraits::BlockType> compressedBlockSurface;
+                compressedBlockSurface.blockData = compressedSurface.getDataAs<typename CompressedTraits::BlockType>();
                 compressedBlockSurface.extentInBlocks = (compressedSurface.extent() + (CompressedTraits::BlockExtent - Extent{ 1, 1, 1 })) / CompressedTraits::BlockExtent;
 
                 if(decompressedSurface.format() == CompressedTraits::info.decompressedFormat) {
-                    gpufmt::Surface<DecompressedTraits::BlockType> decompressedBlockSurface;
-                    decompressedBlockSurface.blockData = decompressedSurface.accessDataAs<DecompressedTraits::BlockType>();
+                    gpufmt::Surface<typename DecompressedTraits::BlockType> decompressedBlockSurface;
+                    decompressedBlockSurface.blockData = decompressedSurface.accessDataAs<typename DecompressedTraits::BlockType>();
                     decompressedBlockSurface.extentInBlocks = decompressedSurface.extent();
 
                     return Storage::decompress(compressedBlockSurface, decompressedBlockSurface);
                 }
-                else if(compressedSurface.format() == CompressedTraits::info.decompressedFormatAlt) {
-                    if constexpr(DecompressedTraitsAlt::info.decompressedFormatAlt != gpufmt::Format::UNDEFINED) {
-                        gpufmt::Surface<DecompressedTraitsAlt::BlockType> decompressedBlockSurface;
-                        decompressedBlockSurface.blockData = decompressedSurface.accessDataAs<DecompressedTraitsAlt::BlockType>();
+                else if(decompressedSurface.format() == CompressedTraits::info.decompressedFormatAlt) {
+                    if constexpr(CompressedTraits::info.decompressedFormatAlt != gpufmt::Format::UNDEFINED) {
+                        gpufmt::Surface<typename DecompressedTraitsAlt::BlockType> decompressedBlockSurface;
+                        decompressedBlockSurface.blockData = decompressedSurface.accessDataAs<typename DecompressedTraitsAlt::BlockType>();
                         decompressedBlockSurface.extentInBlocks = decompressedSurface.extent();
 
                         return Storage::decompress(compressedBlockSurface, decompressedBlockSurface);
@@ -412,7 +611,8 @@ namespace cputex {
         }
     };
 
-    bool decompressSurfaceTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+    [[nodiscard]]
+    static bool validDecompression(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
         const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceSurface.format());
 
         if(!info.decompressible) {
@@ -425,12 +625,109 @@ namespace cputex {
             return false;
         }
 
-        if(!sourceSurface.equivalentDimensions(destSurface)) {
+        return sourceSurface.equivalentDimensions(destSurface);
+    }
+
+    // Decompresses block rows [firstBlockRow, firstBlockRow + blockRowCount), counting block rows across every volume
+    // slice. The decompressor only understands packed surfaces, so runs of rows are handed to it as 2d surfaces of their
+    // own, one block row at a time when the source is pitched. Destination rows that aren't contiguous are decompressed
+    // into a packed band first and copied out row by row.
+    [[nodiscard]]
+    static bool decompressBlockRows(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface, cputex::SizeType firstBlockRow, cputex::SizeType blockRowCount) noexcept {
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(sourceSurface.format());
+
+        const cputex::Extent extent = sourceSurface.extent();
+        const cputex::SizeType blockRowsPerSlice = (static_cast<cputex::SizeType>(extent.y) + sourceInfo.blockExtent.y - 1) / sourceInfo.blockExtent.y;
+        const cputex::SizeType sourceRowByteSize = sourceSurface.rowByteSize();
+        const cputex::SizeType destRowByteSize = destSurface.rowByteSize();
+        const bool sourceRowsContiguous = sourceSurface.rowPitch() == sourceRowByteSize;
+        const bool destRowsContiguous = destSurface.rowPitch() == destRowByteSize;
+
+        std::vector<cputex::byte> band;
+        bool succeeded = true;
+
+        forEachSliceRows(blockRowsPerSlice, firstBlockRow, blockRowCount, [&](CountType volumeSlice, cputex::SizeType sliceBlockRow, cputex::SizeType sliceBlockRowCount) {
+            const cputex::SizeType runBlockRowCount = (sourceRowsContiguous && destRowsContiguous) ? sliceBlockRowCount : 1;
+
+            for(cputex::SizeType blockRow = sliceBlockRow; blockRow < sliceBlockRow + sliceBlockRowCount && succeeded; blockRow += runBlockRowCount) {
+                // Only the last run of a slice can be shorter than a whole number of blocks.
+                const cputex::SizeType runRowCount = std::min(runBlockRowCount, sliceBlockRow + sliceBlockRowCount - blockRow);
+                const cputex::SizeType firstTexelRow = blockRow * sourceInfo.blockExtent.y;
+                const cputex::SizeType texelRowCount = std::min<cputex::SizeType>(runRowCount * sourceInfo.blockExtent.y, extent.y - firstTexelRow);
+                const cputex::Extent runExtent{ extent.x, static_cast<cputex::ExtentComponent>(texelRowCount), 1 };
+
+                const cputex::SizeType sourceOffset = volumeSlice * sourceSurface.slicePitch() + blockRow * sourceSurface.rowPitch();
+                cputex::SurfaceView sourceRun{ sourceSurface.format(), cputex::TextureDimension::Texture2D, runExtent, sourceSurface.getData().subspan(sourceOffset, runRowCount * sourceRowByteSize) };
+
+                if(destRowsContiguous) {
+                    const cputex::SizeType destOffset = volumeSlice * destSurface.slicePitch() + firstTexelRow * destRowByteSize;
+                    cputex::SurfaceSpan destRun{ destSurface.format(), cputex::TextureDimension::Texture2D, runExtent, destSurface.accessData().subspan(destOffset, texelRowCount * destRowByteSize) };
+
+                    succeeded = gpufmt::visitFormat<Decompressor>(sourceSurface.format(), sourceRun, destRun) == gpufmt::DecompressError::None;
+                }
+                else {
+                    band.resize(static_cast<size_t>(texelRowCount * destRowByteSize));
+                    cputex::SurfaceSpan bandSurface{ destSurface.format(), cputex::TextureDimension::Texture2D, runExtent, band };
+
+                    succeeded = gpufmt::visitFormat<Decompressor>(sourceSurface.format(), sourceRun, bandSurface) == gpufmt::DecompressError::None;
+
+                    for(cputex::SizeType bandRow = 0; bandRow < texelRowCount && succeeded; ++bandRow) {
+                        const cputex::span<const cputex::byte> bandRowData = bandSurface.getRowData(bandRow);
+                        std::copy(bandRowData.begin(), bandRowData.end(), destSurface.accessRowData(firstTexelRow + bandRow, volumeSlice).begin());
+                    }
+                }
+            }
+        });
+
+        return succeeded;
+    }
+
+    bool decompressSurfaceTo(cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        if(!validDecompression(sourceSurface, destSurface)) {
             return false;
         }
 
-        gpufmt::DecompressError error = gpufmt::visitFormat<Decompressor>(sourceSurface.format(), sourceSurface, destSurface);
-        return error == gpufmt::DecompressError::None;
+        if(sourceSurface.isPacked() && destSurface.isPacked()) {
+            gpufmt::DecompressError error = gpufmt::visitFormat<Decompressor>(sourceSurface.format(), sourceSurface, destSurface);
+            return error == gpufmt::DecompressError::None;
+        }
+
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(sourceSurface.format());
+
+        // Blocks that span several volume slices can't be cut into rows.
+        if(sourceInfo.blockExtent.z != 1) {
+            return false;
+        }
+
+        const cputex::Extent extent = sourceSurface.extent();
+        const cputex::SizeType blockRowsPerSlice = (static_cast<cputex::SizeType>(extent.y) + sourceInfo.blockExtent.y - 1) / sourceInfo.blockExtent.y;
+
+        return decompressBlockRows(sourceSurface, destSurface, 0, blockRowsPerSlice * extent.z);
+    }
+
+    bool decompressSurfaceTo(const cputex::execution::ParallelPolicy &policy, cputex::SurfaceView sourceSurface, cputex::SurfaceSpan destSurface) noexcept {
+        if(!validDecompression(sourceSurface, destSurface)) {
+            return false;
+        }
+
+        const gpufmt::FormatInfo &sourceInfo = gpufmt::formatInfo(sourceSurface.format());
+
+        // Blocks that span several volume slices can't be cut into 2d bands.
+        if(sourceInfo.blockExtent.z != 1) {
+            return decompressSurfaceTo(sourceSurface, destSurface);
+        }
+
+        const cputex::Extent extent = sourceSurface.extent();
+        const cputex::SizeType blockRowsPerSlice = (static_cast<cputex::SizeType>(extent.y) + sourceInfo.blockExtent.y - 1) / sourceInfo.blockExtent.y;
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachBand(policy, blockRowsPerSlice * extent.z, sourceSurface.rowByteSize(), [&](cputex::SizeType firstBlockRow, cputex::SizeType blockRowCount) {
+            if(!decompressBlockRows(sourceSurface, destSurface, firstBlockRow, blockRowCount)) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
     }
 
     bool decompressTextureTo(cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
@@ -462,4 +759,32 @@ namespace cputex {
 
         return true;
     }
-}
\ No newline at end of file
+
+    bool decompressTextureTo(const cputex::execution::ParallelPolicy &policy, cputex::TextureView sourceTexture, cputex::TextureSpan destTexture) noexcept {
+        const gpufmt::FormatInfo &info = gpufmt::formatInfo(sourceTexture.format());
+
+        if(!info.decompressible) {
+            return false;
+        }
+
+        if(destTexture.format() != info.decompressedFormat &&
+           destTexture.format() != info.decompressedFormatAlt)
+        {
+            return false;
+        }
+
+        if(!sourceTexture.equivalentDimensions(destTexture)) {
+            return false;
+        }
+
+        std::atomic_bool succeeded = true;
+
+        cputex::execution::parallelForEachSurface(policy, sourceTexture.arraySize(), sourceTexture.faces(), sourceTexture.mips(), [&](CountType arraySlice, CountType face, CountType mip) {
+            if(!decompressSurfaceTo(policy, (SurfaceView)sourceTexture.getMipSurface(arraySlice, face, mip), (SurfaceSpan)destTexture.accessMipSurface(arraySlice, face, mip))) {
+                succeeded.store(false, std::memory_order_relaxed);
+            }
+        });
+
+        return succeeded.load(std::memory_order_relaxed);
+    }
+}
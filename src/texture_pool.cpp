@@ -0,0 +1,101 @@
+#include <cputex/texture_pool.h>
+
+#include <new>
+
+namespace cputex {
+    TexturePool::TexturePool(cputex::SizeType byteBudget, std::pmr::memory_resource *upstream) noexcept
+        : mUpstream(upstream)
+        , mByteBudget(byteBudget)
+    {}
+
+    TexturePool::~TexturePool() {
+        trim(0);
+    }
+
+    void TexturePool::trim(cputex::SizeType targetByteSize) noexcept {
+        std::lock_guard lock(mMutex);
+        trimLocked(targetByteSize);
+    }
+
+    void TexturePool::setByteBudget(cputex::SizeType byteBudget) noexcept {
+        std::lock_guard lock(mMutex);
+        mByteBudget = byteBudget;
+        trimLocked(mByteBudget);
+    }
+
+    cputex::SizeType TexturePool::byteBudget() const noexcept {
+        std::lock_guard lock(mMutex);
+        return mByteBudget;
+    }
+
+    TexturePoolStats TexturePool::stats() const noexcept {
+        std::lock_guard lock(mMutex);
+        return mStats;
+    }
+
+    void *TexturePool::do_allocate(size_t bytes, size_t alignment) {
+        {
+            std::lock_guard lock(mMutex);
+
+            auto freeBlocksItr = mFreeBlocks.find(BlockKey{ bytes, alignment });
+
+            if(freeBlocksItr != mFreeBlocks.end() && !freeBlocksItr->second.empty()) {
+                void *block = freeBlocksItr->second.back();
+                freeBlocksItr->second.pop_back();
+
+                ++mStats.hits;
+                --mStats.cachedBlockCount;
+                mStats.cachedByteSize -= static_cast<cputex::SizeType>(bytes);
+                return block;
+            }
+
+            ++mStats.misses;
+        }
+
+        return mUpstream->allocate(bytes, alignment);
+    }
+
+    void TexturePool::do_deallocate(void *block, size_t bytes, size_t alignment) {
+        {
+            std::lock_guard lock(mMutex);
+
+            if(mStats.cachedByteSize + static_cast<cputex::SizeType>(bytes) <= mByteBudget) {
+                // Deallocation can't fail, so a block that can't be kept for lack of memory goes back upstream.
+                try {
+                    mFreeBlocks[BlockKey{ bytes, alignment }].push_back(block);
+
+                    ++mStats.cachedBlockCount;
+                    mStats.cachedByteSize += static_cast<cputex::SizeType>(bytes);
+                    return;
+                } catch(const std::bad_alloc &) {}
+            }
+
+            ++mStats.releases;
+        }
+
+        mUpstream->deallocate(block, bytes, alignment);
+    }
+
+    bool TexturePool::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+        return this == &other;
+    }
+
+    void TexturePool::trimLocked(cputex::SizeType targetByteSize) noexcept {
+        // Largest blocks first, so the fewest blocks are given up to get under the target.
+        for(auto freeBlocksItr = mFreeBlocks.rbegin(); freeBlocksItr != mFreeBlocks.rend() && mStats.cachedByteSize > targetByteSize; ++freeBlocksItr) {
+            const auto [bytes, alignment] = freeBlocksItr->first;
+            std::vector<void *> &blocks = freeBlocksItr->second;
+
+            while(!blocks.empty() && mStats.cachedByteSize > targetByteSize) {
+                mUpstream->deallocate(blocks.back(), bytes, alignment);
+                blocks.pop_back();
+
+                ++mStats.releases;
+                --mStats.cachedBlockCount;
+                mStats.cachedByteSize -= static_cast<cputex::SizeType>(bytes);
+            }
+        }
+
+        std::erase_if(mFreeBlocks, [](const auto &freeBlocks) { return freeBlocks.second.empty(); });
+    }
+}
@@ -12,10 +12,35 @@ namespace cputex {
     {
     }
 
+    UniqueTexture::UniqueTexture(cputex::Uninitialized, const TextureParams &params)
+        : mTextureStorage(cputex::uninitialized, params, false)
+    {
+    }
+
+    UniqueTexture::UniqueTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter)
+    {
+        cputex::AdoptError error;
+        mTextureStorage = internal::TextureStorage(cputex::adoptMemory, params, data, std::move(deleter), false, error);
+    }
+
+    UniqueTexture::UniqueTexture(cputex::AdoptMemory, const TextureParams &params, cputex::span<cputex::byte> data, cputex::MemoryDeleter deleter, cputex::AdoptError &error)
+        : mTextureStorage(cputex::adoptMemory, params, data, std::move(deleter), false, error)
+    {
+    }
+
     UniqueTexture::~UniqueTexture() noexcept {
         mTextureStorage.destroy();
     }
 
+    UniqueTexture &UniqueTexture::operator=(UniqueTexture &&other) noexcept {
+        if(this != &other) {
+            mTextureStorage.destroy();
+            mTextureStorage = std::move(other.mTextureStorage);
+        }
+
+        return *this;
+    }
+
     bool UniqueTexture::operator==(std::nullptr_t) const noexcept {
         return mTextureStorage == nullptr;
     }
@@ -68,6 +93,10 @@ namespace cputex {
         return mTextureStorage.surfaceByteAligment();
     }
 
+    std::pmr::memory_resource *UniqueTexture::memoryResource() const noexcept {
+        return mTextureStorage.memoryResource();
+    }
+
     SizeType UniqueTexture::sizeInBytes() const noexcept {
         return mTextureStorage.sizeInBytes();
     }
@@ -76,6 +105,14 @@ namespace cputex {
         return mTextureStorage.sizeInBytes(mip);
     }
 
+    SizeType UniqueTexture::rowPitch(CountType mip) const noexcept {
+        return mTextureStorage.rowPitch(mip);
+    }
+
+    SizeType UniqueTexture::slicePitch(CountType mip) const noexcept {
+        return mTextureStorage.slicePitch(mip);
+    }
+
     CountType UniqueTexture::surfaceCount() const noexcept {
         return mTextureStorage.surfaceCount();
     }
@@ -110,7 +147,7 @@ namespace cputex {
         }
 
         UniqueTexture clonedTexture;
-        clonedTexture.mTextureStorage = internal::TextureStorage(mTextureStorage.getHeader()->params, false);
+        clonedTexture.mTextureStorage = internal::TextureStorage(cputex::uninitialized, mTextureStorage.getHeader()->params, false);
 
         if(!clonedTexture) {
             return UniqueTexture();
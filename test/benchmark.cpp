@@ -0,0 +1,322 @@
+#include <cputex/converter.h>
+#include <cputex/shared_texture.h>
+#include <cputex/unique_texture.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Measures contention on a SharedTexture's header: threads copying and dropping handles to the same texture, as when
+// handles are captured into job closures, and threads reading its params alongside them. Readers should run about as
+// fast next to the copiers as alone, since the reference counts sit on a cache line of their own. The same runs are
+// timed against ControlTexture, a stand-in for the old layout rather than the old SharedTexture itself: a header with
+// only the fields the readers touch, the reference counts right beside them, and seq_cst count updates. It isolates
+// what the padding and relaxed counts buy, leaving out the rest of the handle code.
+//
+// Also times Converter on each format pair it has a typed kernel for, against gpufmt's sampler and writer run a texel at
+// a time, the generic path Converter falls back to for pairs without a faster one. RGBA8 <-> BGRA8 goes through the byte
+// swizzle, which takes precedence over its typed kernel.
+
+namespace {
+    constexpr int kIterationCount = 1'000'000;
+
+    int gFailureCount = 0;
+
+    void check(bool condition, const char *description) {
+        if(!condition) {
+            std::printf("check failed: %s\n", description);
+            ++gFailureCount;
+        }
+    }
+
+    // Models the header before the reference counts were padded onto their own cache line and relaxed: the counts
+    // sit next to the params readers touch, and every count update is seq_cst.
+    class ControlTexture {
+    private:
+        struct Header {
+            std::atomic_int strongCount = 1;
+            std::atomic_int weakCount = 1;
+            cputex::CountType mips = 0;
+            std::array<cputex::Extent, cputex::maxMipCount> extents{};
+            std::array<cputex::SizeType, cputex::maxMipCount> rowPitches{};
+        };
+
+        Header *mHeader = nullptr;
+
+    public:
+        explicit ControlTexture(const cputex::SharedTexture &texture)
+            : mHeader(new Header)
+        {
+            mHeader->mips = texture.mips();
+
+            for(cputex::CountType mip = 0; mip < texture.mips(); ++mip) {
+                mHeader->extents[mip] = texture.extent(mip);
+                mHeader->rowPitches[mip] = texture.rowPitch(mip);
+            }
+        }
+
+        ControlTexture(const ControlTexture &other) noexcept
+            : mHeader(other.mHeader)
+        {
+            ++mHeader->strongCount;
+        }
+
+        ControlTexture &operator=(const ControlTexture &) = delete;
+
+        ~ControlTexture() {
+            if((--mHeader->strongCount) == 0) {
+                delete mHeader;
+            }
+        }
+
+        const cputex::Extent &extent(cputex::CountType mip = 0) const noexcept {
+            return mHeader->extents[mip];
+        }
+
+        cputex::CountType mips() const noexcept {
+            return mHeader->mips;
+        }
+
+        cputex::SizeType rowPitch(cputex::CountType mip = 0) const noexcept {
+            return mHeader->rowPitches[mip];
+        }
+
+        int useCount() const noexcept {
+            return mHeader->strongCount;
+        }
+    };
+
+    struct Result {
+        double copyNanoseconds = 0.0;
+        double readNanoseconds = 0.0;
+        bool readSumsMatch = true;
+    };
+
+    template<class Texture>
+    cputex::SizeType readSum(const Texture &texture) {
+        cputex::SizeType sum = 0;
+
+        for(int iteration = 0; iteration < kIterationCount; ++iteration) {
+            sum += texture.extent(iteration % texture.mips()).x + texture.rowPitch(0);
+        }
+
+        return sum;
+    }
+
+    template<class Texture>
+    Result run(const Texture &texture, int copierCount, int readerCount) {
+        std::atomic_int ready = 0;
+        std::atomic_bool start = false;
+        std::vector<double> copyNanoseconds(copierCount);
+        std::vector<double> readNanoseconds(readerCount);
+        std::vector<cputex::SizeType> readSums(readerCount);
+        const cputex::SizeType expectedReadSum = readSum(texture);
+        std::vector<std::thread> threads;
+
+        const auto waitForStart = [&]() {
+            ++ready;
+
+            while(!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        };
+
+        for(int i = 0; i < copierCount; ++i) {
+            threads.emplace_back([&, i]() {
+                waitForStart();
+                const auto begin = std::chrono::steady_clock::now();
+
+                for(int iteration = 0; iteration < kIterationCount; ++iteration) {
+                    Texture copy = texture;
+                    (void)copy;
+                }
+
+                copyNanoseconds[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / kIterationCount;
+            });
+        }
+
+        for(int i = 0; i < readerCount; ++i) {
+            threads.emplace_back([&, i]() {
+                waitForStart();
+                const auto begin = std::chrono::steady_clock::now();
+                readSums[i] = readSum(texture);
+                readNanoseconds[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / kIterationCount;
+            });
+        }
+
+        while(ready.load() < copierCount + readerCount) {
+            std::this_thread::yield();
+        }
+
+        start.store(true, std::memory_order_release);
+
+        for(std::thread &thread : threads) {
+            thread.join();
+        }
+
+        Result result;
+
+        if(copierCount > 0) {
+            result.copyNanoseconds = *std::max_element(copyNanoseconds.begin(), copyNanoseconds.end());
+        }
+
+        if(readerCount > 0) {
+            result.readNanoseconds = *std::max_element(readNanoseconds.begin(), readNanoseconds.end());
+            result.readSumsMatch = std::all_of(readSums.begin(), readSums.end(), [&](cputex::SizeType sum) { return sum == expectedReadSum; });
+        }
+
+        return result;
+    }
+
+    // Nanoseconds per texel for the fastest of a few runs of func over texelCount texels.
+    template<class Func>
+    double timePerTexel(cputex::SizeType texelCount, Func &&func) {
+        constexpr int kRunCount = 5;
+        double fastest = 0.0;
+
+        for(int run = 0; run < kRunCount; ++run) {
+            const auto begin = std::chrono::steady_clock::now();
+            func();
+            const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+            fastest = (run == 0) ? nanoseconds : std::min(fastest, nanoseconds);
+        }
+
+        return fastest / static_cast<double>(texelCount);
+    }
+
+    void runConversions() {
+        struct FormatPair {
+            gpufmt::Format first;
+            const char *firstName;
+            gpufmt::Format second;
+            const char *secondName;
+        };
+
+        const std::array<FormatPair, 7> pairs = { {
+            { gpufmt::Format::R8G8B8A8_UNORM, "R8G8B8A8_UNORM", gpufmt::Format::B8G8R8A8_UNORM, "B8G8R8A8_UNORM" },
+            { gpufmt::Format::R8G8B8A8_UNORM, "R8G8B8A8_UNORM", gpufmt::Format::R32G32B32A32_SFLOAT, "R32G32B32A32_SFLOAT" },
+            { gpufmt::Format::R16_SFLOAT, "R16_SFLOAT", gpufmt::Format::R32_SFLOAT, "R32_SFLOAT" },
+            { gpufmt::Format::R16G16_SFLOAT, "R16G16_SFLOAT", gpufmt::Format::R32G32_SFLOAT, "R32G32_SFLOAT" },
+            { gpufmt::Format::R16G16B16_SFLOAT, "R16G16B16_SFLOAT", gpufmt::Format::R32G32B32_SFLOAT, "R32G32B32_SFLOAT" },
+            { gpufmt::Format::R16G16B16A16_SFLOAT, "R16G16B16A16_SFLOAT", gpufmt::Format::R32G32B32A32_SFLOAT, "R32G32B32A32_SFLOAT" },
+            { gpufmt::Format::R8_UNORM, "R8_UNORM", gpufmt::Format::R32_SFLOAT, "R32_SFLOAT" },
+        } };
+
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 512, 512, 1 };
+        params.mips = 1;
+        params.arraySize = 1;
+
+        const cputex::SizeType texelCount = cputex::SizeType(params.extent.x) * params.extent.y;
+
+        std::printf("%-24s %-24s %18s %18s %10s\n", "source", "dest", "ns Converter", "ns texel by texel", "speedup");
+
+        for(const FormatPair &pair : pairs) {
+            for(const bool reverse : { false, true }) {
+                const gpufmt::Format sourceFormat = reverse ? pair.second : pair.first;
+                const gpufmt::Format destFormat = reverse ? pair.first : pair.second;
+
+                params.format = sourceFormat;
+                cputex::UniqueTexture source(params);
+
+                // Float and half sources are left zeroed, 8 bit ones get a pattern.
+                if(sourceFormat == gpufmt::Format::R8G8B8A8_UNORM || sourceFormat == gpufmt::Format::B8G8R8A8_UNORM || sourceFormat == gpufmt::Format::R8_UNORM) {
+                    const cputex::span<cputex::byte> data = source.accessMipSurfaceData(0, 0, 0);
+
+                    for(size_t index = 0; index < data.size(); ++index) {
+                        data[index] = static_cast<cputex::byte>(index * 13);
+                    }
+                }
+
+                params.format = destFormat;
+                cputex::UniqueTexture dest(params);
+
+                const cputex::Converter converter(sourceFormat, destFormat);
+                cputex::ConvertError convertError = cputex::ConvertError::None;
+                const double converterNanoseconds = timePerTexel(texelCount, [&]() {
+                    convertError = converter.convertTo(cputex::TextureView{ source }, cputex::TextureSpan{ dest });
+                });
+                check(convertError == cputex::ConvertError::None, "Converter converts the pair");
+
+                const gpufmt::BlockSampler sampler(sourceFormat);
+                const gpufmt::Writer writer(destFormat);
+                const size_t destTexelByteSize = gpufmt::formatInfo(destFormat).blockByteSize;
+                std::vector<gpufmt::SampleVariant> samples(sampler.blockTexelCount());
+
+                // Both surfaces are tightly packed, so their texels can be walked as one long row.
+                gpufmt::Surface<const cputex::byte> sourceRow;
+                sourceRow.blockData = source.getMipSurfaceData(0, 0, 0);
+                sourceRow.extentInBlocks = cputex::Extent{ static_cast<cputex::ExtentComponent>(texelCount), 1, 1 };
+                const cputex::span<cputex::byte> destData = dest.accessMipSurfaceData(0, 0, 0);
+
+                const double perTexelNanoseconds = timePerTexel(texelCount, [&]() {
+                    for(cputex::ExtentComponent texel = 0; texel < sourceRow.extentInBlocks.x; ++texel) {
+                        (void)sampler.variantSampleTo(sourceRow, cputex::Extent{ texel, 0, 0 }, samples);
+                        (void)writer.writeTo(samples[0], destData.subspan(static_cast<size_t>(texel) * destTexelByteSize, destTexelByteSize));
+                    }
+                });
+
+                std::printf("%-24s %-24s %18.2f %18.2f %9.1fx\n", reverse ? pair.secondName : pair.firstName, reverse ? pair.firstName : pair.secondName,
+                            converterNanoseconds, perTexelNanoseconds, perTexelNanoseconds / converterNanoseconds);
+            }
+        }
+    }
+
+    template<class Texture>
+    void runAll(const char *name, const Texture &texture, int threadCount) {
+        std::printf("%s\n", name);
+        std::printf("%-10s %-10s %16s %16s\n", "copiers", "readers", "ns per copy", "ns per read");
+
+        for(int copierCount = 1; copierCount <= threadCount; copierCount *= 2) {
+            const Result result = run(texture, copierCount, 0);
+            std::printf("%-10d %-10d %16.1f %16s\n", copierCount, 0, result.copyNanoseconds, "-");
+        }
+
+        const int readerCount = threadCount / 2;
+        const Result readersAlone = run(texture, 0, readerCount);
+        const Result readersWithCopiers = run(texture, threadCount - readerCount, readerCount);
+        check(readersAlone.readSumsMatch && readersWithCopiers.readSumsMatch, "every reader sees the texture's params");
+
+        std::printf("%-10d %-10d %16s %16.1f\n", 0, readerCount, "-", readersAlone.readNanoseconds);
+        std::printf("%-10d %-10d %16.1f %16.1f\n", threadCount - readerCount, readerCount, readersWithCopiers.copyNanoseconds, readersWithCopiers.readNanoseconds);
+    }
+}
+
+int main() {
+    cputex::TextureParams params;
+    params.dimension = cputex::TextureDimension::Texture2D;
+    params.extent = cputex::Extent{ 256, 256, 1 };
+    params.format = gpufmt::Format::R8G8B8A8_UNORM;
+    params.mips = 9;
+    params.arraySize = 1;
+
+    const int threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 2);
+    cputex::WeakTexture weakTexture;
+
+    {
+        const cputex::SharedTexture texture(params);
+        weakTexture = texture;
+
+        const ControlTexture control(texture);
+
+        runAll("SharedTexture", texture, threadCount);
+        std::printf("\n");
+        runAll("Control: unpadded, seq_cst counts", control, threadCount);
+        std::printf("\n");
+
+        check(control.useCount() == 1, "every control copy was released");
+    }
+
+    // Every copy the copiers made has to have dropped its reference for the storage to go away.
+    check(weakTexture.expired(), "every SharedTexture copy was released");
+
+    runConversions();
+
+    return (gFailureCount == 0) ? 0 : 1;
+}
@@ -1,32 +1,2054 @@
+#include <cputex/archive.h>
+#include <cputex/async_loader.h>
+#include <cputex/converter.h>
+#include <cputex/dds.h>
+#include <cputex/execution.h>
+#include <cputex/internal/half.h>
+#include <cputex/internal/srgb.h>
+#include <cputex/internal/swizzle.h>
+#include <cputex/ktx2.h>
 #include <cputex/unique_texture.h>
 #include <cputex/shared_texture.h>
 #include <cputex/sampler.h>
+#include <cputex/texture_layout.h>
+#include <cputex/texture_operations.h>
+#include <cputex/texture_pool.h>
+#include <cputex/texture_view.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 #include <numeric>
 
-int main(int argc, const char **argv) {
-    cputex::TextureParams params;
-    params.dimension = cputex::TextureDimension::Texture2D;
-    params.extent = cputex::Extent{ 4, 4, 0 };
-    params.format = gpufmt::Format::R4G4_UNORM_PACK8;
-    params.mips = 15;
-    params.arraySize = 1;
+namespace {
+    int gFailureCount = 0;
 
-    std::vector<uint32_t> feces;
-    feces.resize(32);
-    std::iota(feces.begin(), feces.end(), 0);
+    void check(bool condition, const char *expression, const char *file, int line) {
+        if(!condition) {
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+            ++gFailureCount;
+        }
+    }
 
-    auto initData = cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte*>(feces.data()), feces.size() * sizeof(uint32_t));
-    cputex::UniqueTexture unique(params, initData);
-    cputex::SharedTexture shared(params, initData);
+#define CPUTEX_CHECK(expression) check((expression), #expression, __FILE__, __LINE__)
 
-    cputex::SharedTexture newShared = std::move(shared);
+    // Counts what goes through it, to tell when textures or a pool go to it.
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        cputex::SizeType allocationCount = 0;
+        cputex::SizeType liveByteSize = 0;
 
-    cputex::Sampler sampler{ unique };
-    auto sample1 = sampler.sample({ 0.0f, 0.0f, 0.0f });
-    auto sample2 = sampler.sample({ 0.5f, 0.5f, 0.0f });
-    auto sample3 = sampler.sample({ 1.0f, 1.0f, 0.0f });
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            ++allocationCount;
+            liveByteSize += static_cast<cputex::SizeType>(bytes);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *block, size_t bytes, size_t alignment) override {
+            liveByteSize -= static_cast<cputex::SizeType>(bytes);
+            std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    std::filesystem::path tempPath(const char *fileName) {
+        return std::filesystem::temp_directory_path() / fileName;
+    }
+
+    std::vector<cputex::byte> readFile(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<char> contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        return std::vector<cputex::byte>(reinterpret_cast<const cputex::byte *>(contents.data()), reinterpret_cast<const cputex::byte *>(contents.data() + contents.size()));
+    }
+
+    void writeFile(const std::filesystem::path &path, cputex::span<const cputex::byte> contents) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    }
+
+    // Writes a pattern over every byte, padding included, that differs from surface to surface.
+    void fillTexture(cputex::TextureSpan texture) {
+        const cputex::span<cputex::byte> data = texture.accessData();
+
+        for(size_t index = 0; index < data.size(); ++index) {
+            data[index] = static_cast<cputex::byte>((index * 13) ^ (index >> 7));
+        }
+    }
+
+    enum class FillKind {
+        Bytes,
+        Halves,
+        Floats,
+    };
+
+    // Fills a texture with arbitrary bytes, finite halves, or floats that are multiples of 1/1024 in (-2, 2). Halves
+    // hold those floats exactly, so converting them between the two doesn't depend on rounding.
+    void fillConvertible(cputex::TextureSpan texture, FillKind kind) {
+        const cputex::span<cputex::byte> data = texture.accessData();
+
+        if(kind == FillKind::Bytes) {
+            fillTexture(texture);
+        }
+        else if(kind == FillKind::Halves) {
+            for(size_t index = 0; index < data.size() / sizeof(uint16_t); ++index) {
+                auto half = static_cast<uint16_t>(index * 40503u);
+
+                // An exponent of all ones is infinity or NaN.
+                if((half & 0x7C00u) == 0x7C00u) {
+                    half &= 0xBFFFu;
+                }
+
+                std::memcpy(data.data() + index * sizeof(uint16_t), &half, sizeof(uint16_t));
+            }
+        }
+        else {
+            for(size_t index = 0; index < data.size() / sizeof(float); ++index) {
+                const float value = static_cast<float>(static_cast<int>((index * 7) % 4095) - 2047) / 1024.0f;
+                std::memcpy(data.data() + index * sizeof(float), &value, sizeof(float));
+            }
+        }
+    }
+
+    // Converts the first surface of source a texel at a time through gpufmt's sampler and writer, the generic path
+    // Converter takes for pairs without a faster one.
+    cputex::UniqueTexture convertTexelByTexel(cputex::TextureView source, gpufmt::Format destFormat) {
+        cputex::TextureParams params;
+        params.dimension = source.dimension();
+        params.extent = source.extent();
+        params.format = destFormat;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        cputex::UniqueTexture dest(params);
+
+        const gpufmt::BlockSampler sampler(source.format());
+        const gpufmt::Writer writer(destFormat);
+        const size_t destTexelByteSize = gpufmt::formatInfo(destFormat).blockByteSize;
+        std::vector<gpufmt::SampleVariant> samples(sampler.blockTexelCount());
+
+        // The surface is tightly packed, so its texels can be sampled as one long row.
+        gpufmt::Surface<const cputex::byte> sourceRow;
+        sourceRow.blockData = source.getMipSurfaceData(0, 0, 0);
+        sourceRow.extentInBlocks = cputex::Extent{ source.extent().x * source.extent().y, 1, 1 };
+
+        const cputex::span<cputex::byte> destData = cputex::TextureSpan{ dest }.accessMipSurfaceData(0, 0, 0);
+
+        for(cputex::ExtentComponent texel = 0; texel < sourceRow.extentInBlocks.x; ++texel) {
+            CPUTEX_CHECK(sampler.variantSampleTo(sourceRow, cputex::Extent{ texel, 0, 0 }, samples) == gpufmt::BlockSampleError::None);
+            CPUTEX_CHECK(writer.writeTo(samples[0], destData.subspan(static_cast<size_t>(texel) * destTexelByteSize, destTexelByteSize)) == gpufmt::WriteError::None);
+        }
+
+        return dest;
+    }
+
+    // Compares every surface of two textures with the same layout byte for byte.
+    bool sameSurfaces(cputex::TextureView expected, cputex::TextureView actual) {
+        if(!expected.equivalentLayout(actual)) {
+            return false;
+        }
+
+        for(cputex::CountType arraySlice = 0; arraySlice < expected.arraySize(); ++arraySlice) {
+            for(cputex::CountType face = 0; face < expected.faces(); ++face) {
+                for(cputex::CountType mip = 0; mip < expected.mips(); ++mip) {
+                    const cputex::span<const cputex::byte> expectedData = expected.getMipSurfaceData(arraySlice, face, mip);
+                    const cputex::span<const cputex::byte> actualData = actual.getMipSurfaceData(arraySlice, face, mip);
+
+                    if(!std::equal(expectedData.begin(), expectedData.end(), actualData.begin(), actualData.end())) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // The texels of the first surface of an unpadded R8 texture, without the padding at the end of the surface.
+    std::vector<uint8_t> surfaceBytes(cputex::TextureView texture) {
+        const auto data = reinterpret_cast<const uint8_t *>(texture.getMipSurfaceData(0, 0, 0).data());
+        return std::vector<uint8_t>(data, data + texture.extent().x * texture.extent().y * texture.extent().z);
+    }
+
+    // Compares the texels of two textures of an uncompressed format, ignoring any padding.
+    bool sameTexels(cputex::TextureView expected, cputex::TextureView actual) {
+        if(expected.format() != actual.format() || expected.dimension() != actual.dimension() || expected.extent() != actual.extent() ||
+           expected.arraySize() != actual.arraySize() || expected.faces() != actual.faces() || expected.mips() != actual.mips()) {
+            return false;
+        }
+
+        for(cputex::CountType arraySlice = 0; arraySlice < expected.arraySize(); ++arraySlice) {
+            for(cputex::CountType face = 0; face < expected.faces(); ++face) {
+                for(cputex::CountType mip = 0; mip < expected.mips(); ++mip) {
+                    const auto expectedSurface = (cputex::SurfaceView)expected.getMipSurface(arraySlice, face, mip);
+                    const auto actualSurface = (cputex::SurfaceView)actual.getMipSurface(arraySlice, face, mip);
+
+                    for(cputex::CountType volumeSlice = 0; volumeSlice < expectedSurface.extent().z; ++volumeSlice) {
+                        for(cputex::SizeType row = 0; row < expectedSurface.extent().y; ++row) {
+                            const cputex::span<const cputex::byte> expectedRow = expectedSurface.getRowData(row, volumeSlice);
+                            const cputex::span<const cputex::byte> actualRow = actualSurface.getRowData(row, volumeSlice);
+
+                            if(std::memcmp(expectedRow.data(), actualRow.data(), expectedRow.size()) != 0) {
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // A DDS file for a 16x16 R8G8B8A8 texture with 2 mips, written out by hand in the legacy layout without a DX10
+    // header.
+    std::vector<cputex::byte> makeDdsFile() {
+        uint32_t words[32] = {};
+        words[0] = 0x20534444;                                  // "DDS "
+        words[1] = 124;                                         // header size
+        words[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;          // caps, height, width, pixel format, mip count
+        words[3] = 16;                                          // height
+        words[4] = 16;                                          // width
+        words[5] = 16 * 4;                                      // pitch
+        words[7] = 2;                                           // mip count
+        words[19] = 32;                                         // pixel format size
+        words[20] = 0x40 | 0x1;                                 // rgb, alpha pixels
+        words[22] = 32;                                         // bits per pixel
+        words[23] = 0x000000FF;
+        words[24] = 0x0000FF00;
+        words[25] = 0x00FF0000;
+        words[26] = 0xFF000000;
+        words[27] = 0x1000 | 0x400000 | 0x8;                    // texture, mipmap, complex
+
+        std::vector<cputex::byte> file(sizeof(words) + (16 * 16 + 8 * 8) * 4);
+        std::memcpy(file.data(), words, sizeof(words));
+
+        for(size_t index = sizeof(words); index < file.size(); ++index) {
+            file[index] = static_cast<cputex::byte>(index * 7);
+        }
+
+        return file;
+    }
+
+    void testSmoke() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 4, 4, 0 };
+        params.format = gpufmt::Format::R4G4_UNORM_PACK8;
+        params.mips = 15;
+        params.arraySize = 1;
+
+        std::vector<uint32_t> feces;
+        feces.resize(32);
+        std::iota(feces.begin(), feces.end(), 0);
+
+        auto initData = cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte*>(feces.data()), feces.size() * sizeof(uint32_t));
+        cputex::UniqueTexture unique(params, initData);
+        cputex::SharedTexture shared(params, initData);
+
+        cputex::SharedTexture newShared = std::move(shared);
+
+        cputex::Sampler sampler{ unique };
+        auto sample1 = sampler.sample({ 0.0f, 0.0f, 0.0f });
+        auto sample2 = sampler.sample({ 0.5f, 0.5f, 0.0f });
+        auto sample3 = sampler.sample({ 1.0f, 1.0f, 0.0f });
+    }
+
+    void testTypedConverters() {
+        struct FormatPair {
+            gpufmt::Format first;
+            FillKind firstFill;
+            gpufmt::Format second;
+            FillKind secondFill;
+        };
+
+        // Every pair Converter has a typed kernel for, converted both ways.
+        const FormatPair pairs[] = {
+            { gpufmt::Format::R8G8B8A8_UNORM, FillKind::Bytes, gpufmt::Format::B8G8R8A8_UNORM, FillKind::Bytes },
+            { gpufmt::Format::R8G8B8A8_UNORM, FillKind::Bytes, gpufmt::Format::R32G32B32A32_SFLOAT, FillKind::Floats },
+            { gpufmt::Format::R16_SFLOAT, FillKind::Halves, gpufmt::Format::R32_SFLOAT, FillKind::Floats },
+            { gpufmt::Format::R16G16_SFLOAT, FillKind::Halves, gpufmt::Format::R32G32_SFLOAT, FillKind::Floats },
+            { gpufmt::Format::R16G16B16_SFLOAT, FillKind::Halves, gpufmt::Format::R32G32B32_SFLOAT, FillKind::Floats },
+            { gpufmt::Format::R16G16B16A16_SFLOAT, FillKind::Halves, gpufmt::Format::R32G32B32A32_SFLOAT, FillKind::Floats },
+            { gpufmt::Format::R8_UNORM, FillKind::Bytes, gpufmt::Format::R32_SFLOAT, FillKind::Floats },
+        };
+
+        for(const FormatPair &pair : pairs) {
+            for(const bool reverse : { false, true }) {
+                const gpufmt::Format sourceFormat = reverse ? pair.second : pair.first;
+                const gpufmt::Format destFormat = reverse ? pair.first : pair.second;
+
+                cputex::TextureParams params;
+                params.dimension = cputex::TextureDimension::Texture2D;
+                params.extent = cputex::Extent{ 67, 5, 1 };
+                params.format = sourceFormat;
+                params.mips = 1;
+                params.arraySize = 1;
+
+                cputex::UniqueTexture source(params);
+                fillConvertible(cputex::TextureSpan{ source }, reverse ? pair.secondFill : pair.firstFill);
+
+                cputex::ConvertError error;
+                const cputex::UniqueTexture converted = cputex::Converter(sourceFormat, destFormat).convert(cputex::TextureView{ source }, error);
+                CPUTEX_CHECK(error == cputex::ConvertError::None);
+
+                const cputex::UniqueTexture expected = convertTexelByTexel(cputex::TextureView{ source }, destFormat);
+                const cputex::span<const cputex::byte> convertedData = cputex::TextureView{ converted }.getMipSurfaceData(0, 0, 0);
+                const cputex::span<const cputex::byte> expectedData = cputex::TextureView{ expected }.getMipSurfaceData(0, 0, 0);
+                CPUTEX_CHECK(std::equal(convertedData.begin(), convertedData.end(), expectedData.begin(), expectedData.end()));
+            }
+        }
+    }
+
+    void testByteSwizzleKernels() {
+        const std::pair<gpufmt::Format, gpufmt::Format> formatPairs[] = {
+            { gpufmt::Format::R8G8B8A8_UNORM, gpufmt::Format::B8G8R8A8_UNORM },
+            { gpufmt::Format::R8G8B8_UNORM, gpufmt::Format::R8G8B8A8_UNORM },
+            { gpufmt::Format::R8G8B8A8_UNORM, gpufmt::Format::B8G8R8_UNORM },
+            { gpufmt::Format::B8G8R8_UNORM, gpufmt::Format::R8G8B8_UNORM },
+            { gpufmt::Format::R8G8_UNORM, gpufmt::Format::B8G8R8A8_UNORM },
+            { gpufmt::Format::R8G8B8A8_SNORM, gpufmt::Format::R8_SNORM },
+        };
+
+        const cputex::internal::ByteSwizzleFunc kernel = cputex::internal::selectByteSwizzleKernel();
+
+        for(const auto &[sourceFormat, destFormat] : formatPairs) {
+            const std::optional<cputex::internal::ByteSwizzle> swizzle = cputex::internal::findByteSwizzle(sourceFormat, destFormat);
+            CPUTEX_CHECK(swizzle.has_value());
+
+            if(!swizzle) {
+                continue;
+            }
+
+            const cputex::SizeType sourceTexelByteSize = swizzle->sourceTexelByteSize;
+            const cputex::SizeType destTexelByteSize = swizzle->destTexelByteSize;
+
+            // Every width up to a few 32 byte vectors, so each kernel hands the scalar path every possible tail. The
+            // buffers are sized exactly, so the address sanitizer catches a kernel touching a byte past the end.
+            for(cputex::SizeType texelCount = 0; texelCount <= 70; ++texelCount) {
+                std::vector<cputex::byte> source(static_cast<size_t>(texelCount * sourceTexelByteSize));
+
+                for(size_t index = 0; index < source.size(); ++index) {
+                    source[index] = static_cast<cputex::byte>(index * 37 + 11);
+                }
+
+                std::vector<cputex::byte> expected(static_cast<size_t>(texelCount * destTexelByteSize));
+                std::vector<cputex::byte> actual(expected.size());
+                cputex::internal::byteSwizzleScalar(*swizzle, source.data(), expected.data(), texelCount);
+                kernel(*swizzle, source.data(), actual.data(), texelCount);
+                CPUTEX_CHECK(actual == expected);
+            }
+
+            // Rows of a pitched surface, swizzled one at a time, never spill into the padding after them.
+            constexpr cputex::SizeType kWidth = 37;
+            constexpr cputex::SizeType kHeight = 5;
+            constexpr cputex::SizeType kPadding = 19;
+            const cputex::SizeType sourceRowPitch = kWidth * sourceTexelByteSize + kPadding;
+            const cputex::SizeType destRowPitch = kWidth * destTexelByteSize + kPadding;
+
+            std::vector<cputex::byte> source(static_cast<size_t>(sourceRowPitch * kHeight));
+
+            for(size_t index = 0; index < source.size(); ++index) {
+                source[index] = static_cast<cputex::byte>(index * 29 + 3);
+            }
+
+            std::vector<cputex::byte> dest(static_cast<size_t>(destRowPitch * kHeight), cputex::byte{ 0xCD });
+            std::vector<cputex::byte> expectedRow(static_cast<size_t>(kWidth * destTexelByteSize));
+
+            for(cputex::SizeType row = 0; row < kHeight; ++row) {
+                kernel(*swizzle, source.data() + row * sourceRowPitch, dest.data() + row * destRowPitch, kWidth);
+                cputex::internal::byteSwizzleScalar(*swizzle, source.data() + row * sourceRowPitch, expectedRow.data(), kWidth);
+
+                const auto destRow = dest.begin() + row * destRowPitch;
+                CPUTEX_CHECK(std::equal(expectedRow.begin(), expectedRow.end(), destRow));
+                CPUTEX_CHECK(std::all_of(destRow + kWidth * destTexelByteSize, destRow + destRowPitch, [](cputex::byte value) { return value == cputex::byte{ 0xCD }; }));
+            }
+        }
+    }
+
+    void testSrgbCurve() {
+        // Decoding is a lookup, so every one of the 256 values can be compared with the exact curve.
+        std::vector<uint8_t> encoded(256 * 4);
+
+        for(size_t value = 0; value < 256; ++value) {
+            std::fill_n(encoded.begin() + static_cast<std::ptrdiff_t>(value * 4), 4, static_cast<uint8_t>(value));
+        }
+
+        std::vector<glm::vec4> decoded(256);
+        cputex::internal::decodeSrgb8(encoded.data(), decoded);
+
+        for(size_t value = 0; value < 256; ++value) {
+            const double normalized = static_cast<double>(value) / 255.0;
+            const double linear = (normalized <= 0.04045) ? normalized / 12.92 : std::pow((normalized + 0.055) / 1.055, 2.4);
+
+            CPUTEX_CHECK(std::abs(decoded[value].x - linear) <= linear * 1e-7);
+            CPUTEX_CHECK(decoded[value].y == decoded[value].x && decoded[value].z == decoded[value].x);
+            CPUTEX_CHECK(std::abs(decoded[value].w - normalized) <= 1e-7);
+        }
+
+        // Encoding approximates the curve to within kTolerance before rounding to 8 bits, so each byte has to lie
+        // between the bytes the exact value kTolerance either side rounds to. Everything in [0, 1] is covered in steps
+        // of 2^-20, followed by values that clamp.
+        constexpr double kTolerance = 3.7e-6;
+        constexpr int kStepCount = 1 << 20;
+
+        std::vector<glm::vec4> samples;
+
+        for(int step = 0; step <= kStepCount; ++step) {
+            const float value = static_cast<float>(step) / static_cast<float>(kStepCount);
+            samples.emplace_back(value, value, value, value);
+        }
+
+        for(const float value : { -1.0f, -0.0f, 2.0f, std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::infinity(),
+                                  -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN() }) {
+            samples.emplace_back(value, value, value, value);
+        }
+
+        std::vector<uint8_t> bytes(samples.size() * 4);
+        cputex::internal::encodeSrgb8(samples, bytes.data());
+
+        // Rounds in float like the encoder does, so the bounds don't differ from it by how value * 255 rounds.
+        const auto quantize = [](double value) {
+            const auto clamped = static_cast<float>(std::clamp(value, 0.0, 1.0));
+            return static_cast<int>(clamped * 255.0f + 0.5f);
+        };
+
+        cputex::SizeType outOfRangeCount = 0;
+
+        for(size_t index = 0; index < samples.size(); ++index) {
+            // NaN encodes as 0.
+            const double value = std::isnan(samples[index].x) ? 0.0 : std::clamp(static_cast<double>(samples[index].x), 0.0, 1.0);
+            const double exact = (value <= 0.0031308) ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+            const int lowest = quantize(exact - kTolerance);
+            const int highest = quantize(exact + kTolerance);
+
+            for(size_t channel = 0; channel < 3; ++channel) {
+                const int byte = bytes[index * 4 + channel];
+
+                if(byte < lowest || byte > highest) {
+                    ++outOfRangeCount;
+                }
+            }
+
+            // Alpha is linear and rounds exactly.
+            if(bytes[index * 4 + 3] != quantize(value)) {
+                ++outOfRangeCount;
+            }
+        }
+
+        CPUTEX_CHECK(outOfRangeCount == 0);
+    }
+
+    void testHalfConversions() {
+        // Every half converts to float exactly, and back to the same bits.
+        std::vector<uint16_t> halves(65536);
+        std::iota(halves.begin(), halves.end(), uint16_t(0));
+        const auto halfCount = static_cast<cputex::SizeType>(halves.size());
+
+        std::vector<float> floats(halves.size());
+        cputex::internal::halfToFloatScalar(halves.data(), floats.data(), halfCount);
+
+        std::vector<uint16_t> roundTripped(halves.size());
+        cputex::internal::floatToHalfScalar(floats.data(), roundTripped.data(), halfCount);
+
+        cputex::SizeType mismatchCount = 0;
+
+        for(size_t index = 0; index < halves.size(); ++index) {
+            const uint16_t half = halves[index];
+            const int exponent = (half >> 10) & 0x1F;
+            const int mantissa = half & 0x3FF;
+            const bool negative = (half & 0x8000) != 0;
+
+            // NaNs come back quiet, with their payload.
+            if(exponent == 0x1F && mantissa != 0) {
+                if(!std::isnan(floats[index]) || roundTripped[index] != (half | 0x0200)) {
+                    ++mismatchCount;
+                }
+
+                continue;
+            }
+
+            double expected = (exponent == 0x1F) ? std::numeric_limits<double>::infinity() :
+                              (exponent == 0) ? std::ldexp(mantissa, -24) : std::ldexp(mantissa + 1024, exponent - 25);
+            expected = negative ? -expected : expected;
+
+            if(floats[index] != expected || std::signbit(floats[index]) != negative || roundTripped[index] != half) {
+                ++mismatchCount;
+            }
+        }
+
+        CPUTEX_CHECK(mismatchCount == 0);
+
+        // Going the other way, a float halfway between two halves rounds to the even one, and a float either side of
+        // halfway to the nearer one.
+        std::vector<float> sources;
+        std::vector<uint16_t> expectedHalves;
+
+        const auto expect = [&](float source, uint16_t half) {
+            sources.push_back(source);
+            expectedHalves.push_back(half);
+        };
+
+        const auto fromBits = [](uint32_t bits) {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        };
+
+        constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+        for(uint16_t half = 0; half < 0x7BFF; ++half) {
+            const float midpoint = (floats[half] + floats[half + 1]) / 2.0f;
+            const auto even = static_cast<uint16_t>((half % 2 == 0) ? half : half + 1);
+
+            for(const uint16_t sign : { uint16_t(0), uint16_t(0x8000) }) {
+                const float signedMidpoint = (sign != 0) ? -midpoint : midpoint;
+
+                expect(signedMidpoint, even | sign);
+                expect(std::nextafter(signedMidpoint, 0.0f), half | sign);
+                expect(std::nextafter(signedMidpoint, (sign != 0) ? -kInfinity : kInfinity), static_cast<uint16_t>(half + 1) | sign);
+            }
+        }
+
+        // Halfway between the largest half, 65504, and the next exponent overflows.
+        expect(65520.0f, 0x7C00);
+        expect(std::nextafter(65520.0f, 0.0f), 0x7BFF);
+        expect(-65520.0f, 0xFC00);
+        expect(1e10f, 0x7C00);
+        expect(kInfinity, 0x7C00);
+        expect(-kInfinity, 0xFC00);
+
+        // Float subnormals are far below the smallest half subnormal.
+        expect(fromBits(0x00000001), 0x0000);
+        expect(fromBits(0x807FFFFF), 0x8000);
+
+        // NaNs stay NaN, come out quiet, and keep the upper bits of their payload.
+        expect(fromBits(0x7F800001), 0x7E00);
+        expect(fromBits(0x7FC00000), 0x7E00);
+        expect(fromBits(0x7F802000), 0x7E01);
+        expect(fromBits(0xFFFFE000), 0xFFFF);
+
+        const auto sourceCount = static_cast<cputex::SizeType>(sources.size());
+
+        std::vector<uint16_t> scalarHalves(sources.size());
+        cputex::internal::floatToHalfScalar(sources.data(), scalarHalves.data(), sourceCount);
+        CPUTEX_CHECK(scalarHalves == expectedHalves);
+
+        // The bulk conversions use F16C or the arm fp16 instructions when the host has them, and have to agree with
+        // the scalar ones bit for bit.
+        std::vector<uint16_t> bulkHalves(sources.size());
+        cputex::internal::floatToHalf(sources.data(), bulkHalves.data(), sourceCount);
+        CPUTEX_CHECK(bulkHalves == expectedHalves);
+
+        std::vector<float> bulkFloats(halves.size());
+        cputex::internal::halfToFloat(halves.data(), bulkFloats.data(), halfCount);
+        CPUTEX_CHECK(std::memcmp(bulkFloats.data(), floats.data(), floats.size() * sizeof(float)) == 0);
+    }
+
+    void testParallelOperations() {
+        cputex::execution::ThreadPool pool(3);
+        const cputex::execution::ParallelPolicy par = cputex::execution::par.on(pool);
+
+        // Odd extents, so every mip has a middle row and column.
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 61, 37, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 6;
+        params.arraySize = 3;
+
+        cputex::UniqueTexture source(params);
+        fillTexture(cputex::TextureSpan{ source });
+
+        cputex::UniqueTexture sequential(params);
+        cputex::UniqueTexture parallel(params);
+
+        cputex::clear(cputex::execution::seq, cputex::TextureSpan{ sequential }, { 0.25, 0.5, 0.75, 1.0 });
+        cputex::clear(par, cputex::TextureSpan{ parallel }, { 0.25, 0.5, 0.75, 1.0 });
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+        fillTexture(cputex::TextureSpan{ sequential });
+        fillTexture(cputex::TextureSpan{ parallel });
+
+        CPUTEX_CHECK(cputex::flipHorizontal(cputex::execution::seq, cputex::TextureSpan{ sequential }));
+        CPUTEX_CHECK(cputex::flipHorizontal(par, cputex::TextureSpan{ parallel }));
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+        CPUTEX_CHECK(cputex::flipVertical(cputex::execution::seq, cputex::TextureSpan{ sequential }));
+        CPUTEX_CHECK(cputex::flipVertical(par, cputex::TextureSpan{ parallel }));
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+        CPUTEX_CHECK(cputex::flipHorizontalTo(cputex::execution::seq, cputex::TextureView{ source }, cputex::TextureSpan{ sequential }));
+        CPUTEX_CHECK(cputex::flipHorizontalTo(par, cputex::TextureView{ source }, cputex::TextureSpan{ parallel }));
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+        CPUTEX_CHECK(cputex::flipVerticalTo(cputex::execution::seq, cputex::TextureView{ source }, cputex::TextureSpan{ sequential }));
+        CPUTEX_CHECK(cputex::flipVerticalTo(par, cputex::TextureView{ source }, cputex::TextureSpan{ parallel }));
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+        cputex::TextureParams floatParams = params;
+        floatParams.format = gpufmt::Format::R32G32B32A32_SFLOAT;
+
+        cputex::UniqueTexture sequentialFloats(floatParams);
+        cputex::UniqueTexture parallelFloats(floatParams);
+
+        const cputex::Converter converter(params.format, floatParams.format);
+        CPUTEX_CHECK(converter.convertTo(cputex::execution::seq, cputex::TextureView{ source }, cputex::TextureSpan{ sequentialFloats }) == cputex::ConvertError::None);
+        CPUTEX_CHECK(converter.convertTo(par, cputex::TextureView{ source }, cputex::TextureSpan{ parallelFloats }) == cputex::ConvertError::None);
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequentialFloats }, cputex::TextureView{ parallelFloats }));
+
+        cputex::TextureParams compressedParams = params;
+        compressedParams.format = gpufmt::Format::BC1_RGBA_UNORM_BLOCK;
+
+        cputex::UniqueTexture compressed(compressedParams);
+        fillTexture(cputex::TextureSpan{ compressed });
+
+        CPUTEX_CHECK(cputex::decompressTextureTo(cputex::execution::seq, cputex::TextureView{ compressed }, cputex::TextureSpan{ sequential }));
+        CPUTEX_CHECK(cputex::decompressTextureTo(par, cputex::TextureView{ compressed }, cputex::TextureSpan{ parallel }));
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+    }
+
+    void testThreadPool() {
+        {
+            cputex::execution::ThreadPool pool(3);
+            CPUTEX_CHECK(pool.concurrency() == 4);
+
+            // Tasks can run parallelFor on the pool they're running on, and every task runs exactly once.
+            std::vector<std::atomic_int> runCounts(64 * 64);
+
+            cputex::execution::parallelFor(pool, 64, [&](cputex::SizeType outer) {
+                cputex::execution::parallelFor(pool, 64, [&](cputex::SizeType inner) {
+                    ++runCounts[static_cast<size_t>(outer * 64 + inner)];
+                });
+            });
+
+            CPUTEX_CHECK(std::all_of(runCounts.begin(), runCounts.end(), [](const std::atomic_int &runCount) { return runCount.load() == 1; }));
+        }
+
+        // A pool without workers runs everything on the calling thread.
+        {
+            cputex::execution::ThreadPool pool(0);
+            CPUTEX_CHECK(pool.concurrency() == 1);
+
+            const std::thread::id caller = std::this_thread::get_id();
+            bool onCaller = true;
+
+            cputex::execution::parallelFor(pool, 16, [&](cputex::SizeType) {
+                onCaller = onCaller && std::this_thread::get_id() == caller;
+            });
+
+            CPUTEX_CHECK(onCaller);
+        }
+
+        // Pools shut down whether they never ran anything or just finished.
+        for(int iteration = 0; iteration < 50; ++iteration) {
+            cputex::execution::ThreadPool idle(3);
+            cputex::execution::ThreadPool busy(3);
+            std::atomic_int taskCount = 0;
+
+            cputex::execution::parallelFor(busy, 100, [&](cputex::SizeType) {
+                ++taskCount;
+            });
+
+            CPUTEX_CHECK(taskCount.load() == 100);
+        }
+    }
+
+    void testFlipOddExtents() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 3, 3, 1 };
+        params.format = gpufmt::Format::R8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        const std::vector<uint8_t> texels = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        const cputex::UniqueTexture source(params, cputex::span<const cputex::byte>(reinterpret_cast<const cputex::byte *>(texels.data()), texels.size()));
+
+        // The middle row and column stay where they are, but still have to be copied to the destination.
+        cputex::UniqueTexture flipped(params);
+        CPUTEX_CHECK(cputex::flipHorizontalTo(cputex::TextureView{ source }, cputex::TextureSpan{ flipped }));
+        CPUTEX_CHECK((surfaceBytes(cputex::TextureView{ flipped }) == std::vector<uint8_t>{ 7, 8, 9, 4, 5, 6, 1, 2, 3 }));
+
+        cputex::UniqueTexture mirrored(params);
+        CPUTEX_CHECK(cputex::flipVerticalTo(cputex::TextureView{ source }, cputex::TextureSpan{ mirrored }));
+        CPUTEX_CHECK((surfaceBytes(cputex::TextureView{ mirrored }) == std::vector<uint8_t>{ 3, 2, 1, 6, 5, 4, 9, 8, 7 }));
+    }
+
+    void testFlipVolumeSlices() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture3D;
+        params.extent = cputex::Extent{ 2, 2, 3 };
+        params.format = gpufmt::Format::R8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        const std::vector<uint8_t> texels = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        const cputex::span<const cputex::byte> data(reinterpret_cast<const cputex::byte *>(texels.data()), texels.size());
+        const std::vector<uint8_t> expected = { 2, 1, 4, 3, 6, 5, 8, 7, 10, 9, 12, 11 };
+
+        // Every slice is mirrored, not just the first.
+        const cputex::UniqueTexture source(params, data);
+        cputex::UniqueTexture mirrored(params);
+        CPUTEX_CHECK(cputex::flipVerticalTo(cputex::TextureView{ source }, cputex::TextureSpan{ mirrored }));
+        CPUTEX_CHECK(surfaceBytes(cputex::TextureView{ mirrored }) == expected);
+
+        cputex::UniqueTexture inPlace(params, data);
+        CPUTEX_CHECK(cputex::flipVertical(cputex::TextureSpan{ inPlace }));
+        CPUTEX_CHECK(surfaceBytes(cputex::TextureView{ inPlace }) == expected);
+    }
+
+    void testDecompressToAltFormat() {
+        int altFormatCount = 0;
+
+        for(const gpufmt::Format format : { gpufmt::Format::BC1_RGB_UNORM_BLOCK, gpufmt::Format::BC1_RGBA_UNORM_BLOCK, gpufmt::Format::BC2_UNORM_BLOCK,
+                                            gpufmt::Format::BC3_UNORM_BLOCK, gpufmt::Format::BC4_UNORM_BLOCK, gpufmt::Format::BC4_SNORM_BLOCK,
+                                            gpufmt::Format::BC5_UNORM_BLOCK, gpufmt::Format::BC5_SNORM_BLOCK, gpufmt::Format::BC6H_UFLOAT_BLOCK,
+                                            gpufmt::Format::BC6H_SFLOAT_BLOCK, gpufmt::Format::BC7_UNORM_BLOCK }) {
+            const gpufmt::FormatInfo &info = gpufmt::formatInfo(format);
+
+            if(info.decompressedFormatAlt == gpufmt::Format::UNDEFINED) {
+                continue;
+            }
+
+            ++altFormatCount;
+
+            cputex::TextureParams params;
+            params.dimension = cputex::TextureDimension::Texture2D;
+            params.extent = cputex::Extent{ 8, 8, 1 };
+            params.format = format;
+            params.mips = 1;
+            params.arraySize = 1;
+
+            cputex::UniqueTexture compressed(params);
+            fillTexture(cputex::TextureSpan{ compressed });
+
+            params.format = info.decompressedFormatAlt;
+            cputex::UniqueTexture decompressed(params);
+
+            CPUTEX_CHECK(cputex::decompressTextureTo(cputex::TextureView{ compressed }, cputex::TextureSpan{ decompressed }));
+        }
+
+        CPUTEX_CHECK(altFormatCount > 0);
+    }
+
+    void testPartialBlockSize() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 6, 6, 1 };
+        params.format = gpufmt::Format::BC1_RGBA_UNORM_BLOCK;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        // 6x6 texels is 2x2 blocks of 8 bytes, counting the partial blocks on the right and bottom.
+        cputex::UniqueTexture texture(params);
+
+        const auto view = (cputex::SurfaceView)cputex::TextureView{ texture }.getMipSurface(0, 0, 0);
+        CPUTEX_CHECK(view.sizeInBytes() == 32);
+        CPUTEX_CHECK(view.volumeSliceByteSize() == 32);
+        CPUTEX_CHECK(view.getDataAs<uint64_t>().size() == 4);
+
+        const auto span = (cputex::SurfaceSpan)cputex::TextureSpan{ texture }.accessMipSurface(0, 0, 0);
+        CPUTEX_CHECK(span.sizeInBytes() == 32);
+        CPUTEX_CHECK(span.volumeSliceByteSize() == 32);
+        CPUTEX_CHECK(span.getDataAs<uint64_t>().size() == 4);
+    }
+
+    void testParallelBands() {
+        cputex::execution::ThreadPool pool(3);
+        const cputex::execution::ParallelPolicy par = cputex::execution::par.on(pool);
+
+        // 4 MB of rows is split into several bands that between them cover every row once.
+        std::vector<int> rowBandCounts(4096, 0);
+        std::atomic_int bandCount = 0;
+
+        cputex::execution::parallelForEachBand(par, 4096, 1024, [&](cputex::SizeType firstRow, cputex::SizeType rowCount) {
+            ++bandCount;
+
+            for(cputex::SizeType row = firstRow; row < firstRow + rowCount; ++row) {
+                ++rowBandCounts[static_cast<size_t>(row)];
+            }
+        });
+
+        CPUTEX_CHECK(bandCount.load() > 1);
+        CPUTEX_CHECK(std::all_of(rowBandCounts.begin(), rowBandCounts.end(), [](int rowBandCount) { return rowBandCount == 1; }));
+
+        // Surfaces that split into bands: a 2d one with odd extents, and a volume whose bands start and end partway
+        // through a slice.
+        for(const cputex::Extent extent : { cputex::Extent{ 513, 511, 1 }, cputex::Extent{ 130, 97, 13 } }) {
+            cputex::TextureParams params;
+            params.dimension = (extent.z > 1) ? cputex::TextureDimension::Texture3D : cputex::TextureDimension::Texture2D;
+            params.extent = extent;
+            params.format = gpufmt::Format::R8G8B8A8_UNORM;
+            params.mips = 1;
+            params.arraySize = 1;
+
+            CPUTEX_CHECK(cputex::SizeType(extent.x) * extent.y * extent.z * 4 >= 2 * cputex::execution::kMinBandByteSize);
+
+            cputex::UniqueTexture source(params);
+            fillTexture(cputex::TextureSpan{ source });
+
+            cputex::UniqueTexture sequential(params);
+            cputex::UniqueTexture parallel(params);
+
+            const auto sourceSurface = (cputex::SurfaceView)cputex::TextureView{ source }.getMipSurface(0, 0, 0);
+            const auto sequentialSurface = (cputex::SurfaceSpan)cputex::TextureSpan{ sequential }.accessMipSurface(0, 0, 0);
+            const auto parallelSurface = (cputex::SurfaceSpan)cputex::TextureSpan{ parallel }.accessMipSurface(0, 0, 0);
+
+            cputex::clear(cputex::execution::seq, cputex::TextureSpan{ sequential }.accessMipSurface(0, 0, 0), { 0.25, 0.5, 0.75, 1.0 });
+            cputex::clear(par, cputex::TextureSpan{ parallel }.accessMipSurface(0, 0, 0), { 0.25, 0.5, 0.75, 1.0 });
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            CPUTEX_CHECK(cputex::flipHorizontalTo(cputex::execution::seq, sourceSurface, sequentialSurface));
+            CPUTEX_CHECK(cputex::flipHorizontalTo(par, sourceSurface, parallelSurface));
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            CPUTEX_CHECK(cputex::flipVertical(cputex::execution::seq, sequentialSurface));
+            CPUTEX_CHECK(cputex::flipVertical(par, parallelSurface));
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            CPUTEX_CHECK(cputex::flipVerticalTo(cputex::execution::seq, sourceSurface, sequentialSurface));
+            CPUTEX_CHECK(cputex::flipVerticalTo(par, sourceSurface, parallelSurface));
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            CPUTEX_CHECK(cputex::flipHorizontal(cputex::execution::seq, sequentialSurface));
+            CPUTEX_CHECK(cputex::flipHorizontal(par, parallelSurface));
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            const cputex::Extent copyExtent{ extent.x - 3, extent.y - 2, extent.z };
+            CPUTEX_CHECK(cputex::copySurfaceRegionTo(cputex::execution::seq, sourceSurface, cputex::Extent{ 3, 0, 0 }, sequentialSurface, cputex::Extent{ 0, 2, 0 }, copyExtent));
+            CPUTEX_CHECK(cputex::copySurfaceRegionTo(par, sourceSurface, cputex::Extent{ 3, 0, 0 }, parallelSurface, cputex::Extent{ 0, 2, 0 }, copyExtent));
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequential }, cputex::TextureView{ parallel }));
+
+            params.format = gpufmt::Format::R32G32B32A32_SFLOAT;
+            cputex::UniqueTexture sequentialFloats(params);
+            cputex::UniqueTexture parallelFloats(params);
+
+            const cputex::Converter converter(gpufmt::Format::R8G8B8A8_UNORM, params.format);
+            CPUTEX_CHECK(converter.convertTo(cputex::execution::seq, sourceSurface, (cputex::SurfaceSpan)cputex::TextureSpan{ sequentialFloats }.accessMipSurface(0, 0, 0)) == cputex::ConvertError::None);
+            CPUTEX_CHECK(converter.convertTo(par, sourceSurface, (cputex::SurfaceSpan)cputex::TextureSpan{ parallelFloats }.accessMipSurface(0, 0, 0)) == cputex::ConvertError::None);
+            CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ sequentialFloats }, cputex::TextureView{ parallelFloats }));
+        }
+    }
+
+    void testMemoryResource() {
+        CountingResource resource;
+
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 3;
+        params.arraySize = 2;
+        params.memoryResource = &resource;
+
+        {
+            cputex::UniqueTexture unique(params);
+            CPUTEX_CHECK(unique.memoryResource() == &resource);
+            CPUTEX_CHECK(resource.allocationCount > 0);
+            CPUTEX_CHECK(resource.liveByteSize >= unique.sizeInBytes());
+
+            // Assigning over a texture gives its memory back.
+            cputex::UniqueTexture other(params);
+            const cputex::SizeType liveByteSize = resource.liveByteSize;
+            other = std::move(unique);
+            CPUTEX_CHECK(resource.liveByteSize < liveByteSize);
+            CPUTEX_CHECK(other.memoryResource() == &resource);
+
+            const cputex::SharedTexture shared(params);
+            const cputex::SharedTexture copy = shared;
+            CPUTEX_CHECK(copy.memoryResource() == &resource);
+        }
+
+        CPUTEX_CHECK(resource.liveByteSize == 0);
+
+        // Without one, a texture takes the default resource at the time it's made.
+        CountingResource defaultResource;
+        std::pmr::memory_resource *previousDefault = std::pmr::set_default_resource(&defaultResource);
+        params.memoryResource = nullptr;
+
+        {
+            const cputex::UniqueTexture texture(params);
+            std::pmr::set_default_resource(previousDefault);
+
+            CPUTEX_CHECK(texture.memoryResource() == &defaultResource);
+            CPUTEX_CHECK(defaultResource.allocationCount > 0);
+        }
+
+        CPUTEX_CHECK(defaultResource.liveByteSize == 0);
+    }
+
+    void testAdoptMemory() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        // 16x16 R8G8B8A8 texels take 1024 bytes.
+        alignas(64) cputex::byte buffer[1024 + 64] = {};
+        int deleteCount = 0;
+
+        const auto deleter = [&](cputex::span<cputex::byte> data) {
+            CPUTEX_CHECK(data.data() == buffer);
+            ++deleteCount;
+        };
+
+        // The texture works on the caller's bytes in place, and hands them to the deleter once when it's done with them.
+        {
+            cputex::UniqueTexture texture(cputex::adoptMemory, params, cputex::span<cputex::byte>(buffer, 1024), deleter);
+            CPUTEX_CHECK(!texture.empty());
+            CPUTEX_CHECK(texture.getMipSurfaceData(0, 0, 0).data() == buffer);
+
+            texture.accessMipSurfaceData(0, 0, 0)[5] = cputex::byte{ 9 };
+            CPUTEX_CHECK(buffer[5] == cputex::byte{ 9 });
+
+            const cputex::UniqueTexture moved = std::move(texture);
+            CPUTEX_CHECK(deleteCount == 0);
+        }
+
+        CPUTEX_CHECK(deleteCount == 1);
+
+        // Shared textures hand them over with the last reference.
+        deleteCount = 0;
+
+        {
+            const cputex::SharedTexture texture(cputex::adoptMemory, params, cputex::span<cputex::byte>(buffer, 1024), deleter);
+            CPUTEX_CHECK(!texture.empty());
+
+            { const cputex::SharedTexture copy = texture; }
+            CPUTEX_CHECK(deleteCount == 0);
+        }
+
+        CPUTEX_CHECK(deleteCount == 1);
+
+        // Data a texture can't use stays with the caller: the texture is empty and the deleter never runs.
+        deleteCount = 0;
+
+        {
+            cputex::AdoptError error;
+
+            const cputex::UniqueTexture tooSmall(cputex::adoptMemory, params, cputex::span<cputex::byte>(buffer, 1023), deleter, error);
+            CPUTEX_CHECK(tooSmall.empty());
+            CPUTEX_CHECK(error == cputex::AdoptError::DataTooSmall);
+
+            const cputex::SharedTexture misaligned(cputex::adoptMemory, params, cputex::span<cputex::byte>(buffer + 1, 1024), deleter, error);
+            CPUTEX_CHECK(misaligned.empty());
+            CPUTEX_CHECK(error == cputex::AdoptError::DataMisaligned);
+
+            cputex::TextureParams invalidParams = params;
+            invalidParams.mips = 0;
+            const cputex::UniqueTexture invalid(cputex::adoptMemory, invalidParams, cputex::span<cputex::byte>(buffer, 1024), deleter, error);
+            CPUTEX_CHECK(invalid.empty());
+            CPUTEX_CHECK(error == cputex::AdoptError::InvalidParams);
+
+            // Padded rows have to start aligned too. A row pitch alignment raises the surface alignment to match.
+            cputex::TextureParams pitchedParams = params;
+            pitchedParams.rowPitchAlignment = 64;
+            const cputex::UniqueTexture pitched(cputex::adoptMemory, pitchedParams, cputex::span<cputex::byte>(buffer + 16, 1024), deleter, error);
+            CPUTEX_CHECK(pitched.empty());
+            CPUTEX_CHECK(error == cputex::AdoptError::DataMisaligned);
+
+            const cputex::UniqueTexture adopted(cputex::adoptMemory, params, cputex::span<cputex::byte>(buffer, 1024), {}, error);
+            CPUTEX_CHECK(!adopted.empty());
+            CPUTEX_CHECK(error == cputex::AdoptError::None);
+        }
+
+        CPUTEX_CHECK(deleteCount == 0);
+    }
+
+    void testUninitialized() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 37, 11, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 3;
+        params.arraySize = 2;
+
+        // Apart from what's in the surfaces, it's the same texture as one that starts out zeroed.
+        cputex::UniqueTexture expected(params);
+        cputex::UniqueTexture texture(cputex::uninitialized, params);
+        CPUTEX_CHECK(!texture.empty());
+        CPUTEX_CHECK(texture.sizeInBytes() == expected.sizeInBytes());
+        CPUTEX_CHECK(cputex::TextureView{ texture }.equivalentLayout(cputex::TextureView{ expected }));
+
+        fillTexture(cputex::TextureSpan{ expected });
+        fillTexture(cputex::TextureSpan{ texture });
+        CPUTEX_CHECK(sameSurfaces(cputex::TextureView{ expected }, cputex::TextureView{ texture }));
+
+        const cputex::SharedTexture shared(cputex::uninitialized, params);
+        CPUTEX_CHECK(!shared.empty());
+        CPUTEX_CHECK(shared.sizeInBytes() == expected.sizeInBytes());
+    }
+
+    void testLayoutLimits() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ cputex::maxExtentComponent, cputex::maxExtentComponent, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = cputex::maxMipCount;
+        params.arraySize = 1;
+
+        // 16384 halves down to 1 in exactly maxMipCount mips.
+        const cputex::TextureLayout layout = cputex::computeLayout(params);
+        CPUTEX_CHECK(layout.isValid());
+        CPUTEX_CHECK(layout.params.mips == cputex::maxMipCount);
+        CPUTEX_CHECK(layout.mipExtents[0] == params.extent);
+        CPUTEX_CHECK((layout.mipExtents[cputex::maxMipCount - 1] == cputex::Extent{ 1, 1, 1 }));
+        CPUTEX_CHECK(layout.mipByteSizes[0] == cputex::SizeType(cputex::maxExtentComponent) * cputex::maxExtentComponent * 4);
+        CPUTEX_CHECK(layout.faceByteSize == layout.mipOffsets[cputex::maxMipCount - 1] + layout.mipByteSizes[cputex::maxMipCount - 1]);
+        CPUTEX_CHECK(layout.sizeInBytes == layout.faceByteSize);
+
+        // Asking for more mips than there are is clamped rather than written past the mip arrays.
+        params.mips = cputex::maxMipCount + 5;
+        CPUTEX_CHECK(cputex::computeLayout(params).params.mips == cputex::maxMipCount);
+
+        params.dimension = cputex::TextureDimension::Texture3D;
+        params.extent = cputex::Extent{ 4, 4, cputex::maxExtentComponent };
+        const cputex::TextureLayout volumeLayout = cputex::computeLayout(params);
+        CPUTEX_CHECK(volumeLayout.isValid());
+        CPUTEX_CHECK(volumeLayout.params.mips == cputex::maxMipCount);
+        CPUTEX_CHECK((volumeLayout.mipExtents[cputex::maxMipCount - 1] == cputex::Extent{ 1, 1, 1 }));
+
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.mips = cputex::maxMipCount;
+
+        params.extent = cputex::Extent{ cputex::maxExtentComponent + 1, 1, 1 };
+        CPUTEX_CHECK(!cputex::computeLayout(params).isValid());
+
+        params.extent = cputex::Extent{ 1, cputex::maxExtentComponent + 1, 1 };
+        CPUTEX_CHECK(!cputex::computeLayout(params).isValid());
+
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.mips = 0;
+        CPUTEX_CHECK(!cputex::computeLayout(params).isValid());
+
+        params.mips = 1;
+        params.arraySize = 0;
+        CPUTEX_CHECK(!cputex::computeLayout(params).isValid());
+
+        params.arraySize = 1;
+        params.format = gpufmt::Format::UNDEFINED;
+        CPUTEX_CHECK(!cputex::computeLayout(params).isValid());
+    }
+
+    void testPitchedLayout() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 37, 11, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 3;
+        params.arraySize = 2;
+        params.rowPitchAlignment = 64;
+
+        // 148, 72 and 36 byte rows, each padded out to a multiple of 64.
+        const cputex::TextureLayout layout = cputex::computeLayout(params);
+        CPUTEX_CHECK(layout.isValid());
+        CPUTEX_CHECK(layout.mipRowPitches[0] == 192);
+        CPUTEX_CHECK(layout.mipRowPitches[1] == 128);
+        CPUTEX_CHECK(layout.mipRowPitches[2] == 64);
+        CPUTEX_CHECK(layout.mipByteSizes[0] == 192 * 11);
+        CPUTEX_CHECK(layout.params.surfaceByteAlignment % 64 == 0);
+
+        cputex::UniqueTexture texture(params);
+        CPUTEX_CHECK(texture.sizeInBytes() == layout.sizeInBytes);
+
+        for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
+            for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                const cputex::span<const cputex::byte> surfaceData = texture.getMipSurfaceData(arraySlice, 0, mip);
+                CPUTEX_CHECK(reinterpret_cast<std::uintptr_t>(surfaceData.data()) % 64 == 0);
+                CPUTEX_CHECK(static_cast<cputex::SizeType>(surfaceData.size()) == layout.mipByteSizes[mip]);
+                CPUTEX_CHECK(texture.rowPitch(mip) == layout.mipRowPitches[mip]);
+            }
+        }
+
+        // Slices are padded to sliceAlignment on top of their padded rows: 3 rows of 32 bytes to 128.
+        params.dimension = cputex::TextureDimension::Texture3D;
+        params.extent = cputex::Extent{ 5, 3, 4 };
+        params.mips = 1;
+        params.arraySize = 1;
+        params.rowPitchAlignment = 16;
+        params.sliceAlignment = 128;
+
+        const cputex::TextureLayout volumeLayout = cputex::computeLayout(params);
+        CPUTEX_CHECK(volumeLayout.mipRowPitches[0] == 32);
+        CPUTEX_CHECK(volumeLayout.mipSlicePitches[0] == 128);
+        CPUTEX_CHECK(volumeLayout.mipByteSizes[0] == 128 * 4);
+    }
+
+    // True if a buffer cleared to opaque red through a pitched R8G8B8A8 span has red texels and untouched (0xCD)
+    // padding.
+    bool clearedToRed(const std::vector<cputex::byte> &buffer, cputex::Extent extent, cputex::SizeType rowPitch, cputex::SizeType slicePitch) {
+        for(cputex::SizeType offset = 0; offset < static_cast<cputex::SizeType>(buffer.size()); ++offset) {
+            const cputex::SizeType volumeSlice = offset / slicePitch;
+            const cputex::SizeType row = (offset % slicePitch) / rowPitch;
+            const cputex::SizeType column = (offset % slicePitch) % rowPitch;
+            const bool texel = volumeSlice < extent.z && row < extent.y && column < extent.x * 4;
+
+            const cputex::byte expected = !texel ? cputex::byte{ 0xCD } :
+                                          (column % 4 == 1 || column % 4 == 2) ? cputex::byte{ 0x00 } : cputex::byte{ 0xFF };
+
+            if(buffer[static_cast<size_t>(offset)] != expected) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void testClearPitchedSpan() {
+        // A 10x7 frame with 64 byte rows, the way a decoder might hand it out. The padding after each row may belong to
+        // someone else, so clearing leaves it alone.
+        std::vector<cputex::byte> frameBuffer(64 * 7, cputex::byte{ 0xCD });
+        const cputex::SurfaceSpan frame(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture2D, cputex::Extent{ 10, 7, 1 }, 64, 0,
+                                        cputex::span<cputex::byte>(frameBuffer.data(), frameBuffer.size()));
+        CPUTEX_CHECK(!frame.empty());
+
+        cputex::clear(frame, { 1.0, 0.0, 0.0, 1.0 });
+        CPUTEX_CHECK(clearedToRed(frameBuffer, cputex::Extent{ 10, 7, 1 }, 64, 64 * 7));
+
+        // A volume with padding after each row and after each slice.
+        std::vector<cputex::byte> volumeBuffer(128 * 4, cputex::byte{ 0xCD });
+        const cputex::SurfaceSpan volume(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, cputex::Extent{ 5, 3, 4 }, 32, 128,
+                                         cputex::span<cputex::byte>(volumeBuffer.data(), volumeBuffer.size()));
+        CPUTEX_CHECK(!volume.empty());
+
+        cputex::clear(volume, { 1.0, 0.0, 0.0, 1.0 });
+        CPUTEX_CHECK(clearedToRed(volumeBuffer, cputex::Extent{ 5, 3, 4 }, 32, 128));
+    }
+
+    void testPitchedSubregion() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 37, 11, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+        params.rowPitchAlignment = 64;
+
+        cputex::UniqueTexture texture(params);
+        const auto surface = (cputex::SurfaceView)texture.getMipSurface();
+
+        // The window keeps the surface's 192 byte row pitch and starts 2 rows and 4 texels in.
+        const cputex::SurfaceView region = surface.subregion(cputex::Extent{ 4, 2, 0 }, cputex::Extent{ 8, 3, 1 });
+        CPUTEX_CHECK(!region.empty());
+        CPUTEX_CHECK((region.extent() == cputex::Extent{ 8, 3, 1 }));
+        CPUTEX_CHECK(region.dimension() == cputex::TextureDimension::Texture2D);
+        CPUTEX_CHECK(region.rowPitch() == 192);
+        CPUTEX_CHECK(region.rowByteSize() == 32);
+        CPUTEX_CHECK(region.getRowData(0).data() == surface.getRowData(2).data() + 16);
+        CPUTEX_CHECK(region.getRowData(2).data() == surface.getRowData(4).data() + 16);
+        CPUTEX_CHECK(region.getRowData(2).size() == 32);
+
+        // A window reaching the last texel of the last row fits, one going past either edge doesn't.
+        const cputex::SurfaceView corner = surface.subregion(cputex::Extent{ 36, 10, 0 }, cputex::Extent{ 1, 1, 1 });
+        CPUTEX_CHECK(!corner.empty());
+        CPUTEX_CHECK(corner.getRowData(0).data() == surface.getRowData(10).data() + 36 * 4);
+
+        CPUTEX_CHECK(surface.subregion(cputex::Extent{ 30, 0, 0 }, cputex::Extent{ 8, 1, 1 }).empty());
+        CPUTEX_CHECK(surface.subregion(cputex::Extent{ 0, 9, 0 }, cputex::Extent{ 1, 3, 1 }).empty());
+        CPUTEX_CHECK(surface.subregion(cputex::Extent{ -1, 0, 0 }, cputex::Extent{ 1, 1, 1 }).empty());
+
+        // A row pitch shorter than a row, a slice pitch too short for a slice's rows, or too little data for the pitches
+        // leaves the view empty. These 5x3x4 texel slices have 20 byte rows.
+        std::vector<cputex::byte> buffer(128 * 4);
+        const cputex::span<cputex::byte> bytes(buffer.data(), buffer.size());
+        const cputex::Extent volumeExtent{ 5, 3, 4 };
+
+        CPUTEX_CHECK(!cputex::SurfaceView(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 128, bytes).empty());
+        CPUTEX_CHECK(!cputex::SurfaceView(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 20, 0, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceView(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 16, 128, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceView(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 64, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceView(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 128, bytes.first(400)).empty());
+
+        CPUTEX_CHECK(!cputex::SurfaceSpan(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 128, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceSpan(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 16, 0, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceSpan(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 64, bytes).empty());
+        CPUTEX_CHECK(cputex::SurfaceSpan(gpufmt::Format::R8G8B8A8_UNORM, cputex::TextureDimension::Texture3D, volumeExtent, 32, 128, bytes.first(400)).empty());
+    }
+
+    void testTexturePool() {
+        CountingResource upstream;
+
+        {
+            cputex::TexturePool pool(1024 * 1024, &upstream);
+
+            cputex::TextureParams params;
+            params.dimension = cputex::TextureDimension::Texture2D;
+            params.extent = cputex::Extent{ 64, 64, 1 };
+            params.format = gpufmt::Format::R8G8B8A8_UNORM;
+            params.mips = 1;
+            params.arraySize = 1;
+            params.memoryResource = &pool;
+
+            { cputex::UniqueTexture texture(params); }
+
+            const cputex::SizeType allocationCount = upstream.allocationCount;
+            CPUTEX_CHECK(allocationCount > 0);
+            CPUTEX_CHECK(pool.stats().misses == allocationCount);
+            CPUTEX_CHECK(pool.stats().cachedBlockCount == allocationCount);
+
+            // A texture with the same params gets the same blocks back without going upstream.
+            {
+                cputex::UniqueTexture texture(params);
+                CPUTEX_CHECK(upstream.allocationCount == allocationCount);
+                CPUTEX_CHECK(pool.stats().hits == allocationCount);
+                CPUTEX_CHECK(pool.stats().cachedBlockCount == 0);
+            }
+
+            // Lowering the budget below what's cached releases blocks until it fits.
+            const cputex::SizeType cachedByteSize = pool.stats().cachedByteSize;
+            pool.setByteBudget(cachedByteSize - 1);
+            CPUTEX_CHECK(pool.stats().cachedByteSize <= cachedByteSize - 1);
+            CPUTEX_CHECK(pool.stats().releases > 0);
+
+            // Blocks that don't fit in the budget go straight back upstream.
+            pool.setByteBudget(0);
+            CPUTEX_CHECK(pool.stats().cachedByteSize == 0);
+
+            { cputex::UniqueTexture texture(params); }
+
+            CPUTEX_CHECK(pool.stats().cachedBlockCount == 0);
+            CPUTEX_CHECK(upstream.liveByteSize == 0);
+
+            pool.setByteBudget(1024 * 1024);
+            { cputex::UniqueTexture texture(params); }
+            CPUTEX_CHECK(upstream.liveByteSize > 0);
+        }
+
+        // The pool hands everything it kept back when it's destroyed.
+        CPUTEX_CHECK(upstream.liveByteSize == 0);
+    }
+
+    void testDdsRoundTrip() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 37, 11, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 4;
+        params.arraySize = 3;
+
+        // Padded rows are written one at a time, packed textures in one piece, and both read back the same.
+        for(const cputex::CountType rowPitchAlignment : { 1, 64 }) {
+            params.rowPitchAlignment = rowPitchAlignment;
+
+            cputex::UniqueTexture texture(params);
+            fillTexture(cputex::TextureSpan{ texture });
+
+            std::vector<cputex::byte> file;
+            const cputex::DdsError writeError = cputex::writeDds(texture, [&](cputex::span<const cputex::byte> data) {
+                file.insert(file.end(), data.begin(), data.end());
+                return true;
+            });
+            CPUTEX_CHECK(writeError == cputex::DdsError::None);
+
+            cputex::DdsError readError;
+            const cputex::UniqueTexture copy = cputex::readDds(file, readError);
+            CPUTEX_CHECK(readError == cputex::DdsError::None);
+            CPUTEX_CHECK(sameTexels(texture, copy));
+
+            const std::filesystem::path path = tempPath("cputex_test.dds");
+            CPUTEX_CHECK(cputex::writeDds(texture, path) == cputex::DdsError::None);
+
+            const cputex::UniqueTexture mapped = cputex::readDds(path, cputex::DdsLoadMode::MemoryMap, readError);
+            CPUTEX_CHECK(readError == cputex::DdsError::None);
+            CPUTEX_CHECK(sameTexels(texture, mapped));
+
+            const cputex::SharedTexture shared = cputex::readSharedDds(path, cputex::DdsLoadMode::Copy, readError);
+            CPUTEX_CHECK(readError == cputex::DdsError::None);
+            CPUTEX_CHECK(sameTexels(texture, shared));
+        }
+
+        params.dimension = cputex::TextureDimension::TextureCube;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.faces = 6;
+        params.rowPitchAlignment = 1;
+
+        cputex::UniqueTexture cube(params);
+        fillTexture(cputex::TextureSpan{ cube });
+
+        const std::filesystem::path path = tempPath("cputex_test_cube.dds");
+        CPUTEX_CHECK(cputex::writeDds(cube, path) == cputex::DdsError::None);
+
+        cputex::DdsError readError;
+        CPUTEX_CHECK(sameTexels(cube, cputex::readDds(path, cputex::DdsLoadMode::Copy, readError)));
+        CPUTEX_CHECK(readError == cputex::DdsError::None);
+
+        std::filesystem::remove(path);
+        std::filesystem::remove(tempPath("cputex_test.dds"));
+    }
+
+    void testDdsInvalidInput() {
+        const std::vector<cputex::byte> file = makeDdsFile();
+        cputex::DdsError error;
+
+        const cputex::UniqueTexture texture = cputex::readDds(file, error);
+        CPUTEX_CHECK(error == cputex::DdsError::None);
+        CPUTEX_CHECK(texture.format() == gpufmt::Format::R8G8B8A8_UNORM);
+        CPUTEX_CHECK(texture.mips() == 2);
+        CPUTEX_CHECK(std::equal(file.end() - 8 * 8 * 4, file.end(), texture.getMipSurfaceData(0, 0, 1).begin()));
+
+        // Missing the last byte of surface data.
+        std::vector<cputex::byte> corrupt(file.begin(), file.end() - 1);
+        CPUTEX_CHECK(cputex::readDds(corrupt, error).empty());
+        CPUTEX_CHECK(error == cputex::DdsError::FileTooSmall);
+
+        // Cut off inside the headers.
+        corrupt.assign(file.begin(), file.begin() + 64);
+        CPUTEX_CHECK(cputex::readDds(corrupt, error).empty());
+        CPUTEX_CHECK(error == cputex::DdsError::FileTooSmall);
+
+        corrupt = file;
+        corrupt[0] = cputex::byte{ 'X' };
+        CPUTEX_CHECK(cputex::readDds(corrupt, error).empty());
+        CPUTEX_CHECK(error == cputex::DdsError::InvalidHeader);
+
+        // A width past maxExtentComponent, which would otherwise size the texture from the header alone.
+        corrupt = file;
+        const uint32_t width = 0x7FFFFFFF;
+        std::memcpy(corrupt.data() + 16, &width, sizeof(width));
+        CPUTEX_CHECK(cputex::readDds(corrupt, error).empty());
+        CPUTEX_CHECK(error == cputex::DdsError::InvalidHeader);
+
+        CPUTEX_CHECK(cputex::readDds(tempPath("cputex_test_missing.dds"), cputex::DdsLoadMode::MemoryMap, error).empty());
+        CPUTEX_CHECK(error == cputex::DdsError::FileOpenFailed);
+    }
+
+    void testKtx2RoundTrip() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 37, 11, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 4;
+        params.arraySize = 3;
+        params.rowPitchAlignment = 64;
+
+        cputex::UniqueTexture texture(params);
+        fillTexture(cputex::TextureSpan{ texture });
+
+        for(const cputex::Ktx2Supercompression supercompression : { cputex::Ktx2Supercompression::None, cputex::Ktx2Supercompression::Zstandard }) {
+            cputex::Ktx2WriteOptions options;
+            options.supercompression = supercompression;
+
+            std::vector<cputex::byte> file;
+            const cputex::Ktx2Error writeError = cputex::writeKtx2(cputex::execution::par, texture, [&](cputex::span<const cputex::byte> data) {
+                file.insert(file.end(), data.begin(), data.end());
+                return true;
+            }, options);
+
+            // zstd is only there when built with CPUTEX_ZSTD.
+            if(supercompression == cputex::Ktx2Supercompression::Zstandard && writeError == cputex::Ktx2Error::UnsupportedSupercompression) {
+                continue;
+            }
+
+            CPUTEX_CHECK(writeError == cputex::Ktx2Error::None);
+
+            // The data format descriptor describes the 4 channels with a sample each, alpha last at bit 24.
+            uint32_t dfdByteOffset = 0;
+            uint32_t dfdByteLength = 0;
+            std::memcpy(&dfdByteOffset, file.data() + 48, sizeof(uint32_t));
+            std::memcpy(&dfdByteLength, file.data() + 52, sizeof(uint32_t));
+            CPUTEX_CHECK(dfdByteLength == 28 + 4 * 16);
+
+            uint32_t alphaSample = 0;
+            std::memcpy(&alphaSample, file.data() + dfdByteOffset + 28 + 3 * 16, sizeof(uint32_t));
+            CPUTEX_CHECK(alphaSample == (24u | (7u << 16) | (15u << 24)));
+
+            cputex::Ktx2Error readError;
+            CPUTEX_CHECK(sameTexels(texture, cputex::readKtx2(file, readError)));
+            CPUTEX_CHECK(readError == cputex::Ktx2Error::None);
+
+            CPUTEX_CHECK(sameTexels(texture, cputex::readKtx2(cputex::execution::par, file, readError)));
+            CPUTEX_CHECK(readError == cputex::Ktx2Error::None);
+
+            // Each mip read on its own matches that mip of the texture.
+            for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                const cputex::UniqueTexture mipTexture = cputex::readKtx2Mip(file, mip, readError);
+                CPUTEX_CHECK(readError == cputex::Ktx2Error::None);
+                CPUTEX_CHECK(mipTexture.mips() == 1);
+                CPUTEX_CHECK(mipTexture.extent() == texture.extent(mip));
+
+                for(cputex::CountType arraySlice = 0; arraySlice < params.arraySize; ++arraySlice) {
+                    const auto expected = (cputex::SurfaceView)texture.getMipSurface(arraySlice, 0, mip);
+                    const auto actual = (cputex::SurfaceView)mipTexture.getMipSurface(arraySlice, 0, 0);
+
+                    for(cputex::SizeType row = 0; row < expected.extent().y; ++row) {
+                        CPUTEX_CHECK(std::memcmp(expected.getRowData(row).data(), actual.getRowData(row).data(), static_cast<size_t>(expected.rowByteSize())) == 0);
+                    }
+                }
+            }
+
+            CPUTEX_CHECK(cputex::readKtx2Mip(file, params.mips, readError).empty());
+            CPUTEX_CHECK(readError == cputex::Ktx2Error::InvalidMip);
+
+            const std::filesystem::path path = tempPath("cputex_test.ktx2");
+            CPUTEX_CHECK(cputex::writeKtx2(texture, path, options) == cputex::Ktx2Error::None);
+            CPUTEX_CHECK(sameTexels(texture, cputex::readKtx2(path, readError)));
+            CPUTEX_CHECK(readError == cputex::Ktx2Error::None);
+
+            const cputex::UniqueTexture mip2 = cputex::readKtx2Mip(path, 2, readError);
+            CPUTEX_CHECK(readError == cputex::Ktx2Error::None);
+            CPUTEX_CHECK(mip2.extent() == texture.extent(2));
+
+            std::filesystem::remove(path);
+        }
+    }
+
+    void testKtx2InvalidInput() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 2;
+        params.arraySize = 1;
+
+        cputex::UniqueTexture texture(params);
+        fillTexture(cputex::TextureSpan{ texture });
+
+        for(const cputex::Ktx2Supercompression supercompression : { cputex::Ktx2Supercompression::None, cputex::Ktx2Supercompression::Zstandard }) {
+            cputex::Ktx2WriteOptions options;
+            options.supercompression = supercompression;
+
+            std::vector<cputex::byte> file;
+            const cputex::Ktx2Error writeError = cputex::writeKtx2(texture, [&](cputex::span<const cputex::byte> data) {
+                file.insert(file.end(), data.begin(), data.end());
+                return true;
+            }, options);
+
+            if(writeError != cputex::Ktx2Error::None) {
+                CPUTEX_CHECK(supercompression == cputex::Ktx2Supercompression::Zstandard && writeError == cputex::Ktx2Error::UnsupportedSupercompression);
+                continue;
+            }
+
+            cputex::Ktx2Error error;
+
+            std::vector<cputex::byte> corrupt(file.begin(), file.end() - 1);
+            CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+            CPUTEX_CHECK(error == cputex::Ktx2Error::FileTooSmall);
+
+            // Cut off inside the level index.
+            corrupt.assign(file.begin(), file.begin() + cputex::kKtx2HeaderByteSize + 8);
+            CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+            CPUTEX_CHECK(error == cputex::Ktx2Error::FileTooSmall);
+
+            corrupt = file;
+            corrupt[1] = cputex::byte{ 'X' };
+            CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+            CPUTEX_CHECK(error == cputex::Ktx2Error::InvalidHeader);
+
+            // pixelWidth past maxExtentComponent.
+            corrupt = file;
+            const uint32_t width = 0x7FFFFFFF;
+            std::memcpy(corrupt.data() + 20, &width, sizeof(width));
+            CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+            CPUTEX_CHECK(error == cputex::Ktx2Error::InvalidHeader);
+
+            // A cube map with a depth. The level index is scaled to match, a depth of 16 on each of the 6 faces, so only
+            // the face count and depth together make it invalid.
+            corrupt = file;
+            const uint32_t depth = 16;
+            const uint32_t faceCount = 6;
+            std::memcpy(corrupt.data() + 28, &depth, sizeof(depth));
+            std::memcpy(corrupt.data() + 36, &faceCount, sizeof(faceCount));
+            for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+                cputex::byte *level = corrupt.data() + cputex::kKtx2HeaderByteSize + mip * 24;
+                uint64_t byteLength;
+                std::memcpy(&byteLength, level + 16, sizeof(byteLength));
+                byteLength *= depth * faceCount;
+                std::memcpy(level + 16, &byteLength, sizeof(byteLength));
+                if(supercompression == cputex::Ktx2Supercompression::None) {
+                    std::memcpy(level + 8, &byteLength, sizeof(byteLength));
+                }
+            }
+            (void)cputex::parseKtx2Header(corrupt, error);
+            CPUTEX_CHECK(error == cputex::Ktx2Error::InvalidHeader);
+            CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+            CPUTEX_CHECK(error == cputex::Ktx2Error::InvalidHeader);
+
+            if(supercompression == cputex::Ktx2Supercompression::Zstandard) {
+                // A level that isn't a zstd frame any more.
+                const cputex::Ktx2Header header = cputex::parseKtx2Header(file, error);
+                CPUTEX_CHECK(error == cputex::Ktx2Error::None);
+
+                corrupt = file;
+                std::memset(corrupt.data() + header.levels[0].byteOffset, 0, 4);
+                CPUTEX_CHECK(cputex::readKtx2(corrupt, error).empty());
+                CPUTEX_CHECK(error == cputex::Ktx2Error::DecompressionFailed);
+            }
+        }
+    }
+
+    void testTextureFileRoundTrip() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 33, 17, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 4;
+        params.arraySize = 2;
+        params.rowPitchAlignment = 64;
+
+        cputex::UniqueTexture texture(params);
+        fillTexture(cputex::TextureSpan{ texture });
+
+        const std::filesystem::path path = tempPath("cputex_test.cptx");
+        CPUTEX_CHECK(cputex::writeTextureFile(texture, path) == cputex::ArchiveError::None);
+
+        // Mapped textures keep the padded layout they were written with.
+        cputex::ArchiveError error;
+        const cputex::UniqueTexture mapped = cputex::readTextureFile(path, error);
+        CPUTEX_CHECK(error == cputex::ArchiveError::None);
+        CPUTEX_CHECK(sameTexels(texture, mapped));
+        CPUTEX_CHECK(mapped.rowPitch(0) == texture.rowPitch(0));
+        CPUTEX_CHECK(reinterpret_cast<std::uintptr_t>(mapped.getMipSurfaceData().data()) % cputex::kTextureFilePageSize == 0);
+
+        CPUTEX_CHECK(sameTexels(texture, cputex::readSharedTextureFile(path, error)));
+        CPUTEX_CHECK(error == cputex::ArchiveError::None);
+
+        const std::vector<cputex::byte> file = readFile(path);
+        CPUTEX_CHECK(sameTexels(texture, cputex::readTextureFile(file, error)));
+        CPUTEX_CHECK(error == cputex::ArchiveError::None);
+
+        const std::filesystem::path corruptPath = tempPath("cputex_test_corrupt.cptx");
+
+        writeFile(corruptPath, cputex::span<const cputex::byte>(file.data(), file.size() - 1));
+        CPUTEX_CHECK(cputex::readTextureFile(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::FileTooSmall);
+
+        writeFile(corruptPath, cputex::span<const cputex::byte>(file.data(), 16));
+        CPUTEX_CHECK(cputex::readTextureFile(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::FileTooSmall);
+
+        std::vector<cputex::byte> corrupt = file;
+        corrupt[0] = cputex::byte{ 'X' };
+        writeFile(corruptPath, corrupt);
+        CPUTEX_CHECK(cputex::readTextureFile(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::InvalidHeader);
+
+        // An extent past maxExtentComponent, and more mips than any texture has.
+        corrupt = file;
+        const int32_t width = 60000;
+        std::memcpy(corrupt.data() + 16, &width, sizeof(width));
+        writeFile(corruptPath, corrupt);
+        CPUTEX_CHECK(cputex::readTextureFile(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::InvalidHeader);
+
+        corrupt = file;
+        const int32_t mips = cputex::maxMipCount + 1;
+        std::memcpy(corrupt.data() + 36, &mips, sizeof(mips));
+        writeFile(corruptPath, corrupt);
+        CPUTEX_CHECK(cputex::readTextureFile(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::InvalidHeader);
+
+        std::filesystem::remove(corruptPath);
+        std::filesystem::remove(path);
+    }
+
+    void testTextureArchive() {
+        std::vector<cputex::UniqueTexture> textures;
+        const std::vector<std::string> names = { "ui/button", "terrain/grass", "ui/arrow", "sky" };
+
+        for(size_t index = 0; index < names.size(); ++index) {
+            cputex::TextureParams params;
+            params.dimension = cputex::TextureDimension::Texture2D;
+            params.extent = cputex::Extent{ 5 + static_cast<int>(index) * 7, 9, 1 };
+            params.format = (index % 2 == 0) ? gpufmt::Format::R8G8B8A8_UNORM : gpufmt::Format::R8_UNORM;
+            params.mips = 3;
+            params.arraySize = 1;
+
+            textures.emplace_back(params);
+            fillTexture(cputex::TextureSpan{ textures.back() });
+        }
+
+        std::vector<cputex::TextureArchiveEntry> entries;
+
+        for(size_t index = 0; index < names.size(); ++index) {
+            entries.push_back({ names[index], textures[index] });
+        }
+
+        const std::filesystem::path path = tempPath("cputex_test.cpta");
+        CPUTEX_CHECK(cputex::writeTextureArchive(entries, path) == cputex::ArchiveError::None);
+
+        cputex::ArchiveError error;
+
+        {
+            const cputex::TextureArchive archive = cputex::TextureArchive::open(path, error);
+            CPUTEX_CHECK(error == cputex::ArchiveError::None);
+            CPUTEX_CHECK(archive.size() == static_cast<cputex::SizeType>(names.size()));
+
+            for(cputex::SizeType index = 1; index < archive.size(); ++index) {
+                CPUTEX_CHECK(archive.name(index - 1) < archive.name(index));
+            }
+
+            for(size_t index = 0; index < names.size(); ++index) {
+                CPUTEX_CHECK(archive.contains(names[index]));
+                CPUTEX_CHECK(sameTexels(textures[index], archive.find(names[index], error)));
+                CPUTEX_CHECK(error == cputex::ArchiveError::None);
+            }
+
+            CPUTEX_CHECK(!archive.contains("ui/missing"));
+            CPUTEX_CHECK(archive.find("ui/missing", error).empty());
+            CPUTEX_CHECK(error == cputex::ArchiveError::NotFound);
+
+            // Textures found for the same entry don't see each other's writes.
+            const cputex::SharedTexture first = archive.find("sky");
+            cputex::SharedTexture second = archive.find("sky");
+            second.lock().accessMipSurfaceData(0, 0, 0)[0] = cputex::byte{ 0xEE };
+            CPUTEX_CHECK(first.getMipSurfaceData()[0] != cputex::byte{ 0xEE });
+            CPUTEX_CHECK(sameTexels(textures[3], first));
+        }
+
+        const std::vector<cputex::byte> file = readFile(path);
+        const std::filesystem::path corruptPath = tempPath("cputex_test_corrupt.cpta");
+
+        writeFile(corruptPath, cputex::span<const cputex::byte>(file.data(), 16));
+        CPUTEX_CHECK(cputex::TextureArchive::open(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::FileTooSmall);
+
+        std::vector<cputex::byte> corrupt = file;
+        corrupt[0] = cputex::byte{ 'X' };
+        writeFile(corruptPath, corrupt);
+        CPUTEX_CHECK(cputex::TextureArchive::open(corruptPath, error).empty());
+        CPUTEX_CHECK(error == cputex::ArchiveError::InvalidHeader);
+
+        entries.push_back({ names[0], textures[1] });
+        CPUTEX_CHECK(cputex::writeTextureArchive(entries, corruptPath) == cputex::ArchiveError::DuplicateName);
+
+        std::filesystem::remove(corruptPath);
+        std::filesystem::remove(path);
+    }
+
+    void testAsyncLoader() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 8, 8, 1 };
+        params.format = gpufmt::Format::R8G8B8A8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        cputex::UniqueTexture texture(params);
+        fillTexture(cputex::TextureSpan{ texture });
+
+        // Requests for a file in memory skip the I/O threads and go straight to the decode queue.
+        std::vector<cputex::byte> file;
+        CPUTEX_CHECK(cputex::writeDds(texture, [&](cputex::span<const cputex::byte> data) {
+            file.insert(file.end(), data.begin(), data.end());
+            return true;
+        }) == cputex::DdsError::None);
+
+        cputex::LoadRequest request;
+        request.data = file;
+
+        cputex::AsyncLoaderOptions options;
+        options.ioThreadCount = 1;
+        options.decodeThreadCount = 1;
+
+        auto loader = std::make_unique<cputex::AsyncLoader>(options);
+
+        // The first request holds the only decode thread in its callback until the others are queued behind it.
+        const auto blockDecodeThread = [&](std::shared_future<void> release) {
+            std::promise<void> started;
+            std::future<void> startedFuture = started.get_future();
+
+            loader->load(request, [&started, release](cputex::LoadResult) {
+                started.set_value();
+                release.wait();
+            });
+
+            startedFuture.wait();
+        };
+
+        {
+            std::promise<void> release;
+            blockDecodeThread(release.get_future().share());
+
+            std::mutex orderMutex;
+            std::vector<int> order;
+            const std::vector<int> priorities = { 0, 0, 5, 0, 9 };
+
+            for(int index = 0; index < static_cast<int>(priorities.size()); ++index) {
+                request.priority = priorities[index];
+                loader->load(request, [&, index](cputex::LoadResult result) {
+                    CPUTEX_CHECK(result.error == cputex::LoadError::None);
+                    CPUTEX_CHECK(sameTexels(texture, result.texture));
+
+                    std::lock_guard lock(orderMutex);
+                    order.push_back(index);
+                });
+            }
+
+            request.priority = 0;
+            release.set_value();
+            loader->waitIdle();
+
+            // Highest priority first, and requests of the same priority in the order they were made.
+            CPUTEX_CHECK((order == std::vector<int>{ 4, 2, 0, 1, 3 }));
+        }
+
+        {
+            std::promise<void> release;
+            blockDecodeThread(release.get_future().share());
+
+            std::vector<std::future<cputex::LoadResult>> results;
+
+            for(int index = 0; index < 3; ++index) {
+                results.push_back(loader->load(request));
+            }
+
+            // Destroying the loader cancels the queued requests right away, then waits for the one being decoded.
+            std::thread destroyer([&]() { loader.reset(); });
+
+            for(std::future<cputex::LoadResult> &result : results) {
+                const cputex::LoadResult loadResult = result.get();
+                CPUTEX_CHECK(loadResult.error == cputex::LoadError::Cancelled);
+                CPUTEX_CHECK(loadResult.texture.empty());
+            }
+
+            release.set_value();
+            destroyer.join();
+        }
+    }
+
+    void testSharedTextureLocks() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.format = gpufmt::Format::R8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+
+        cputex::SharedTexture texture(params);
+        const cputex::SharedTexture copy = texture;
+
+        texture.lock().accessMipSurfaceData(0, 0, 0)[3] = cputex::byte{ 42 };
+        CPUTEX_CHECK(cputex::TextureView(copy.readLock()).getMipSurface().getData()[3] == cputex::byte{ 42 });
+
+        // Two threads hold read locks on different handles at the same time: each waits for the other while holding
+        // its own.
+        std::atomic_int readersHolding = 0;
+
+        const auto read = [&](const cputex::SharedTexture &handle) {
+            const cputex::SharedTextureReadLock lock = handle.readLock();
+            ++readersHolding;
+
+            while(readersHolding.load() < 2) {
+                std::this_thread::yield();
+            }
+        };
+
+        std::thread reader([&]() { read(texture); });
+        read(copy);
+        reader.join();
+        CPUTEX_CHECK(readersHolding.load() == 2);
+
+        // A writer waits for readers.
+        std::atomic_bool written = false;
+        std::thread writer;
+
+        {
+            const cputex::SharedTextureReadLock readLock = copy.readLock();
+
+            writer = std::thread([&]() {
+                cputex::SharedTextureLock lock = texture.lock();
+                lock.accessMipSurfaceData(0, 0, 0)[3] = cputex::byte{ 7 };
+                written = true;
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            CPUTEX_CHECK(!written.load());
+            CPUTEX_CHECK(cputex::TextureView(readLock).getMipSurface().getData()[3] == cputex::byte{ 42 });
+        }
+
+        writer.join();
+        CPUTEX_CHECK(written.load());
+        CPUTEX_CHECK(copy.getMipSurfaceData()[3] == cputex::byte{ 7 });
+    }
+
+    void testSnapshots() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 16, 16, 1 };
+        params.format = gpufmt::Format::R8_UNORM;
+        params.mips = 3;
+        params.arraySize = 2;
+
+        cputex::UniqueTexture expected(params);
+        fillTexture(cputex::TextureSpan{ expected });
+
+        auto texture = std::make_unique<cputex::SharedTexture>(params, cputex::TextureView(expected).getData());
+        cputex::SharedTexture snapshot = texture->snapshot();
+        CPUTEX_CHECK(sameTexels(expected, snapshot));
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(1, 0, 2).data() == texture->getMipSurfaceData(1, 0, 2).data());
+
+        // Writing one surface copies just that surface. The snapshot keeps the old texels and still shares the rest.
+        texture->lock().accessMipSurfaceData(1, 0, 0)[0] = cputex::byte{ 0xAA };
+        CPUTEX_CHECK(texture->getMipSurfaceData(1, 0, 0)[0] == cputex::byte{ 0xAA });
+        CPUTEX_CHECK(sameTexels(expected, snapshot));
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(1, 0, 2).data() == texture->getMipSurfaceData(1, 0, 2).data());
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(1, 0, 0).data() != texture->getMipSurfaceData(1, 0, 0).data());
+
+        // The other way around too.
+        snapshot.lock().accessMipSurfaceData(0, 0, 1)[0] = cputex::byte{ 0xBB };
+        CPUTEX_CHECK(texture->getMipSurfaceData(0, 0, 1)[0] == expected.getMipSurfaceData(0, 0, 1)[0]);
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(0, 0, 1)[0] == cputex::byte{ 0xBB });
+
+        // Writing all of the data at once copies it all, and the contiguous data keeps the surfaces written so far.
+        {
+            cputex::SharedTextureLock lock = texture->lock();
+            const cputex::span<cputex::byte> data = cputex::TextureSpan(lock).accessData();
+            CPUTEX_CHECK(data[static_cast<size_t>(cputex::computeLayout(params).surfaceOffset(1, 0, 0))] == cputex::byte{ 0xAA });
+            std::fill(data.begin(), data.end(), cputex::byte{ 0x11 });
+        }
+
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(1, 0, 0)[0] == expected.getMipSurfaceData(1, 0, 0)[0]);
+        CPUTEX_CHECK(snapshot.getMipSurfaceData(0, 0, 0)[5] == expected.getMipSurfaceData(0, 0, 0)[5]);
+
+        // A snapshot outlives the texture it was taken from.
+        cputex::SharedTexture second = snapshot.snapshot();
+        texture.reset();
+        snapshot = cputex::SharedTexture();
+        CPUTEX_CHECK(second.getMipSurfaceData(0, 0, 1)[0] == cputex::byte{ 0xBB });
+        CPUTEX_CHECK(second.getMipSurfaceData(1, 0, 2)[3] == expected.getMipSurfaceData(1, 0, 2)[3]);
+    }
+
+    void testWeakTextures() {
+        CountingResource resource;
+
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 256, 256, 1 };
+        params.format = gpufmt::Format::R8_UNORM;
+        params.mips = 1;
+        params.arraySize = 1;
+        params.memoryResource = &resource;
+
+        cputex::WeakTexture weak;
+        CPUTEX_CHECK(weak.expired());
+        CPUTEX_CHECK(weak.lock().empty());
+
+        {
+            cputex::SharedTexture texture(params);
+            weak = texture;
+            CPUTEX_CHECK(!weak.expired());
+
+            const cputex::SharedTexture locked = weak.lock();
+            CPUTEX_CHECK(locked.getMipSurfaceData().data() == texture.getMipSurfaceData().data());
+        }
+
+        // The surface data goes with the last SharedTexture, and only the header waits for the WeakTexture.
+        CPUTEX_CHECK(weak.expired());
+        CPUTEX_CHECK(weak.lock().empty());
+        CPUTEX_CHECK(resource.liveByteSize > 0 && resource.liveByteSize < 256 * 256);
+
+        weak.reset();
+        CPUTEX_CHECK(resource.liveByteSize == 0);
+
+        // Self-assignment keeps the reference.
+        cputex::SharedTexture texture(params);
+        weak = texture;
+        const cputex::WeakTexture &self = weak;
+        weak = self;
+        CPUTEX_CHECK(!weak.lock().empty());
+
+        texture = cputex::SharedTexture();
+        weak.reset();
+        CPUTEX_CHECK(resource.liveByteSize == 0);
+
+        // A UniqueTexture keeps its data inline with the header. Made shared, the data still goes with the last
+        // SharedTexture rather than the last WeakTexture.
+        {
+            cputex::UniqueTexture unique(params);
+            unique.accessMipSurfaceData()[5] = cputex::byte{ 7 };
+
+            cputex::SharedTexture shared(std::move(unique));
+            CPUTEX_CHECK(unique.empty());
+            CPUTEX_CHECK(shared.getMipSurfaceData()[5] == cputex::byte{ 7 });
+
+            weak = shared;
+        }
+
+        CPUTEX_CHECK(weak.expired());
+        CPUTEX_CHECK(resource.liveByteSize > 0 && resource.liveByteSize < 256 * 256);
+
+        weak.reset();
+        CPUTEX_CHECK(resource.liveByteSize == 0);
+
+        // Locking races the last reference going away: every lock either gets the whole texture or nothing. The
+        // counting resource isn't thread safe, so these come from the default one.
+        params.memoryResource = nullptr;
+
+        for(int iteration = 0; iteration < 20; ++iteration) {
+            auto racing = std::make_unique<cputex::SharedTexture>(params);
+            const cputex::WeakTexture racingWeak = *racing;
+
+            std::thread locker([&]() {
+                for(int attempt = 0; attempt < 100; ++attempt) {
+                    const cputex::SharedTexture locked = racingWeak.lock();
+
+                    if(!locked.empty()) {
+                        CPUTEX_CHECK(locked.getMipSurfaceData().size() == 256 * 256);
+                    }
+                }
+            });
+
+            racing.reset();
+            locker.join();
+            CPUTEX_CHECK(racingWeak.expired());
+        }
+    }
+
+    // The first channel of a sample, whatever type the format samples to.
+    double firstChannel(const gpufmt::SampleVariant &sample) {
+        return std::visit([](const auto &typedSample) -> double {
+            if constexpr(std::is_arithmetic_v<std::decay_t<decltype(typedSample)>>) {
+                return static_cast<double>(typedSample);
+            } else {
+                return static_cast<double>(typedSample.x);
+            }
+        }, sample);
+    }
+
+    bool near(const gpufmt::SampleVariant &sample, double expected) {
+        return std::abs(firstChannel(sample) - expected) < 1e-4;
+    }
+
+    void testSampler() {
+        cputex::TextureParams params;
+        params.dimension = cputex::TextureDimension::Texture2D;
+        params.extent = cputex::Extent{ 4, 4, 1 };
+        params.format = gpufmt::Format::R32_SFLOAT;
+        params.mips = 3;
+        params.arraySize = 1;
+
+        // Texel (x, y) of mip m holds 100m + 10y + x, except texel (1, 1) of mip 0 holds 100, so bilinear weights show
+        // up in the result rather than cancelling out along a linear ramp.
+        cputex::UniqueTexture texture(params);
+
+        for(cputex::CountType mip = 0; mip < params.mips; ++mip) {
+            const cputex::Extent extent = texture.extent(mip);
+            const cputex::span<cputex::byte> data = texture.accessMipSurfaceData(0, 0, mip);
+
+            for(int y = 0; y < extent.y; ++y) {
+                for(int x = 0; x < extent.x; ++x) {
+                    const float value = (mip == 0 && x == 1 && y == 1) ? 100.0f : static_cast<float>(100 * mip + 10 * y + x);
+                    std::memcpy(data.data() + y * texture.rowPitch(mip) + x * sizeof(float), &value, sizeof(float));
+                }
+            }
+        }
+
+        const cputex::TextureView view(texture);
+
+        // Point sampling 1.3 across: texel 5.2 wraps to 1, mirrors to 2, clamps to 3, or falls on the border.
+        cputex::SamplerDesc desc;
+        desc.borderColor = glm::vec4{ 40.0f, 0.0f, 0.0f, 0.0f };
+
+        desc.addressU = cputex::AddressMode::Wrap;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 1.3f, 0.1f, 0.0f }), 1.0));
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).load({ 3, 2, 0 }), 23.0));
+
+        desc.addressU = cputex::AddressMode::Mirror;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 1.3f, 0.1f, 0.0f }), 2.0));
+
+        desc.addressU = cputex::AddressMode::Clamp;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 1.3f, 0.1f, 0.0f }), 3.0));
+
+        desc.addressU = cputex::AddressMode::Border;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 1.3f, 0.1f, 0.0f }), 40.0));
+
+        // (0.3, 0.2) is texel (0.7, 0.3) from the first center: weights 0.21, 0.49, 0.09 and 0.21 on texels 0, 1, 10
+        // and 100.
+        desc.magFilter = cputex::Filter::Linear;
+        desc.minFilter = cputex::Filter::Linear;
+        desc.addressU = cputex::AddressMode::Clamp;
+        desc.addressV = cputex::AddressMode::Clamp;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 0.3f, 0.2f, 0.0f }), 0.49 + 0.9 + 21.0));
+
+        // u = 0 is halfway between texel -1 and texel 0 of row 0.
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 0.0f, 0.125f, 0.0f }), 0.0));
+
+        desc.addressU = cputex::AddressMode::Wrap;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 0.0f, 0.125f, 0.0f }), 1.5));
+
+        desc.addressU = cputex::AddressMode::Border;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ 0.0f, 0.125f, 0.0f }), 20.0));
+
+        // u = -0.3 is texel -1.7: 0.7 of texel -2, which mirrors to 1, and 0.3 of texel -1, which mirrors to 0.
+        desc.addressU = cputex::AddressMode::Mirror;
+        CPUTEX_CHECK(near(cputex::Sampler(view, desc).sample({ -0.3f, 0.125f, 0.0f }), 0.7));
+
+        // Linear mip filtering blends the two nearest mips by the fraction of the level of detail.
+        desc = cputex::SamplerDesc{};
+        desc.mipFilter = cputex::Filter::Linear;
+        const cputex::Sampler trilinear(view, desc);
+        CPUTEX_CHECK(near(trilinear.sampleLevel({ 0.1f, 0.1f, 0.0f }, 0.0f), 0.0));
+        CPUTEX_CHECK(near(trilinear.sampleLevel({ 0.1f, 0.1f, 0.0f }, 0.25f), 25.0));
+        CPUTEX_CHECK(near(trilinear.sampleLevel({ 0.1f, 0.1f, 0.0f }, 1.0f), 100.0));
+        CPUTEX_CHECK(near(trilinear.sampleLevel({ 0.1f, 0.1f, 0.0f }, 7.0f), 200.0));
+
+        // A footprint 2 texels across picks mip 1.
+        CPUTEX_CHECK(near(trilinear.sampleGrad({ 0.1f, 0.1f, 0.0f }, { 0.5f, 0.0f, 0.0f }, { 0.0f, 0.5f, 0.0f }), 100.0));
+    }
+}
+
+int main() {
+    testSmoke();
+    testTypedConverters();
+    testByteSwizzleKernels();
+    testSrgbCurve();
+    testHalfConversions();
+    testParallelOperations();
+    testThreadPool();
+    testFlipOddExtents();
+    testFlipVolumeSlices();
+    testDecompressToAltFormat();
+    testPartialBlockSize();
+    testParallelBands();
+    testMemoryResource();
+    testAdoptMemory();
+    testUninitialized();
+    testLayoutLimits();
+    testPitchedLayout();
+    testClearPitchedSpan();
+    testPitchedSubregion();
+    testTexturePool();
+    testDdsRoundTrip();
+    testDdsInvalidInput();
+    testKtx2RoundTrip();
+    testKtx2InvalidInput();
+    testTextureFileRoundTrip();
+    testTextureArchive();
+    testAsyncLoader();
+    testSharedTextureLocks();
+    testSnapshots();
+    testWeakTextures();
+    testSampler();
+
+    if(gFailureCount > 0) {
+        std::fprintf(stderr, "%d checks failed\n", gFailureCount);
+        return 1;
+    }
 
     return 0;
-}
\ No newline at end of file
+}